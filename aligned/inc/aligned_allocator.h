@@ -0,0 +1,139 @@
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cassert>
+#include <new>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief CACHE_LINE_SIZE - the alignment of the storage by default
+ * @brief AVX512_ALIGNMENT - the alignment for the aligned 512 bit loads
+ */
+constexpr std::size_t CACHE_LINE_SIZE = 64U;
+constexpr std::size_t AVX512_ALIGNMENT = 64U;
+
+// Sequence containers library)
+namespace scl {
+
+/**
+ * @brief The allocator of the storage aligned by Alignment bytes,
+ *        e.g. for the aligned SIMD loads or to keep the storage off the shared cache lines.
+ *        Alignment must be the power of two, not less than the alignment of T.
+ *        The allocator has no state, all the instances are equal.
+ */
+template<class T, std::size_t Alignment = CACHE_LINE_SIZE>
+class aligned_allocator
+{
+    static_assert(Alignment != 0 && (Alignment & (Alignment-1)) == 0, "Aligned allocator error: the alignment must be the power of two");
+    static_assert(Alignment >= alignof(T), "Aligned allocator error: the alignment is less than the alignment of the type");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    static constexpr std::size_t alignment = Alignment;
+
+    template<class U>
+    struct rebind
+    {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() noexcept {}
+    template<class U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n);
+    void deallocate(T* ptr, std::size_t n) noexcept;
+    std::size_t max_size() const noexcept;
+};
+
+template<class T, std::size_t Alignment>
+constexpr std::size_t aligned_allocator<T, Alignment>::alignment;
+
+/**
+ * @brief Allocates the uninitialized storage of n elements at the address multiple of Alignment.
+ * @throw std::bad_alloc if the memory is exhausted.
+ */
+template<class T, std::size_t Alignment>
+T* aligned_allocator<T, Alignment>::allocate(std::size_t n)
+{
+    if(n > max_size()){
+        throw std::bad_alloc();
+    }
+    // posix_memalign needs the alignment multiple of sizeof(void*)
+    const std::size_t align = Alignment < sizeof(void*) ? sizeof(void*) : Alignment;
+    const std::size_t bytes = n != 0 ? n*sizeof(T) : 1;
+    void* ptr = nullptr;
+    if(::posix_memalign(&ptr, align, bytes) != 0){
+        throw std::bad_alloc();
+    }
+    return static_cast<T*>(ptr);
+}
+
+/**
+ * @brief Returns the storage obtained from allocate().
+ */
+template<class T, std::size_t Alignment>
+void aligned_allocator<T, Alignment>::deallocate(T* ptr, std::size_t /*n*/) noexcept
+{
+    std::free(ptr);
+}
+
+/**
+ * @brief The largest number of elements for allocate().
+ */
+template<class T, std::size_t Alignment>
+std::size_t aligned_allocator<T, Alignment>::max_size() const noexcept
+{
+    return std::numeric_limits<std::size_t>::max() / sizeof(T);
+}
+
+template<class T, class U, std::size_t Alignment>
+bool operator==(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) noexcept
+{
+    return true;
+}
+
+template<class T, class U, std::size_t Alignment>
+bool operator!=(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) noexcept
+{
+    return false;
+}
+
+/**
+ * @brief allocator_alignment - the alignment guaranteed for the storage of the Allocator,
+ *        the alignment of the value type for the allocators without the alignment member.
+ */
+template<class Allocator, class = void>
+struct allocator_alignment
+        : std::integral_constant<std::size_t, alignof(typename Allocator::value_type)>
+{};
+
+template<class Allocator>
+struct allocator_alignment<Allocator, typename std::enable_if<(Allocator::alignment > 0)>::type>
+        : std::integral_constant<std::size_t, Allocator::alignment>
+{};
+
+/**
+ * @brief Tells the compiler the pointer is aligned by Alignment bytes,
+ *        so the loops over it are vectorized with the aligned loads and without the peeling.
+ *        The pointer must be really aligned, it is checked by the assert only.
+ */
+template<std::size_t Alignment, class T>
+inline T* assume_aligned(T* ptr)
+{
+    static_assert(Alignment != 0 && (Alignment & (Alignment-1)) == 0, "Aligned allocator error: the alignment must be the power of two");
+    assert((reinterpret_cast<std::uintptr_t>(ptr) % Alignment == 0) && "Aligned allocator error: the pointer is not aligned");
+    return static_cast<T*>(__builtin_assume_aligned(ptr, Alignment));
+}
+
+}
+
+#endif //ALIGNED_ALLOCATOR_H
@@ -3,51 +3,102 @@
 #include <cstdint>
 #include <string>
 #include <new>
+#include <memory>
+#include <initializer_list>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
 
+#include "aligned_allocator.h"
 
 // Sequence containers library)
 namespace scl {
 /**
  * Very basic implementaion std`s array, but using classes
  * @brief This implementation of a conditionally "useful" array.
+ *        The storage is obtained from the Allocator.
  */
-template<typename T, std::size_t N>
+template<typename T, std::size_t N, class Allocator = std::allocator<T>>
 class array
 {
 private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    Allocator m_alloc;
     T* m_arr;
     std::size_t m_size;
+    std::size_t m_cap;
+
+    void allocate(std::size_t n);
+    void deallocate();
 
 public:
 
-    class iterator
+    /**
+     * @brief Contiguous random access iterator, U is T for the iterator
+     *        and const T for the const_iterator. Every operation is a plain
+     *        pointer operation, so the standard algorithms run at pointer speed.
+     */
+    template<class U>
+    class basic_iterator
     {
     public:
-        iterator() noexcept {}
-        explicit iterator(T* ptr)
-            :m_ptr(ptr){}
-
-        inline iterator& operator=(const iterator& other){m_ptr = other.m_ptr;}
-
-        iterator& operator++(){++m_ptr; return *this;}//++i
-        iterator& operator--(){--m_ptr; return *this;}//--i
-        iterator operator++(int junk){iterator it = *this; ++m_ptr; return it;}//i++
-        iterator operator--(int junk){iterator it = *this; ++m_ptr; return it;}//i--
-        inline T& operator*(){return *m_ptr;}
-        inline T* operator->(){return m_ptr;}
-        bool operator==(const iterator& other){return m_ptr == other.m_ptr;}
-        bool operator!=(const iterator& other){return m_ptr != other.m_ptr;}
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename std::remove_cv<U>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = U*;
+        using reference = U&;
+
+        basic_iterator() noexcept:m_ptr(nullptr){}
+        explicit basic_iterator(U* ptr) noexcept:m_ptr(ptr){}
+        template<class V, class = typename std::enable_if<std::is_convertible<V*, U*>::value>::type>
+        basic_iterator(const basic_iterator<V>& other) noexcept:m_ptr(other.base()){}
+
+        inline U* base() const noexcept {return m_ptr;}
+
+        inline reference operator*() const {return *m_ptr;}
+        inline pointer operator->() const {return m_ptr;}
+        inline reference operator[](difference_type n) const {return m_ptr[n];}
+
+        basic_iterator& operator++(){++m_ptr; return *this;}//++i
+        basic_iterator& operator--(){--m_ptr; return *this;}//--i
+        basic_iterator operator++(int){basic_iterator it = *this; ++m_ptr; return it;}//i++
+        basic_iterator operator--(int){basic_iterator it = *this; --m_ptr; return it;}//i--
+        basic_iterator& operator+=(difference_type n){m_ptr += n; return *this;}
+        basic_iterator& operator-=(difference_type n){m_ptr -= n; return *this;}
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n){return it += n;}
+        friend basic_iterator operator+(difference_type n, basic_iterator it){return it += n;}
+        friend basic_iterator operator-(basic_iterator it, difference_type n){return it -= n;}
+        friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr - rhs.m_ptr;}
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr == rhs.m_ptr;}
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr != rhs.m_ptr;}
+        friend bool operator<(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr < rhs.m_ptr;}
+        friend bool operator>(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr > rhs.m_ptr;}
+        friend bool operator<=(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr <= rhs.m_ptr;}
+        friend bool operator>=(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr >= rhs.m_ptr;}
 
     private:
-        T* m_ptr;
+        U* m_ptr;
     };
 
+    using iterator = basic_iterator<T>;
+    using const_iterator = basic_iterator<const T>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    using allocator_type = Allocator;
+
     array();
+    explicit array(const Allocator& alloc);
     ~array();
-    array(std::initializer_list<T> ilist);
-    array(const array<T, N>& other);
-    array& operator=(const array<T, N>& other);
+    array(std::initializer_list<T> ilist, const Allocator& alloc = Allocator());
+    array(const array<T, N, Allocator>& other);
+    array& operator=(const array<T, N, Allocator>& other);
+
+    Allocator get_allocator() const;
 
     T& at(std::size_t pos);
     T& operator [](std::size_t pos);
@@ -57,106 +108,187 @@ public:
     bool empty();
     std::size_t size();
 
+    T* data();
+    const T* data() const;
+    T* aligned_data();
+    const T* aligned_data() const;
+
     iterator begin();
-    iterator cbegin() const;
+    const_iterator begin() const;
+    const_iterator cbegin() const;
     iterator end();
-    iterator cend() const;
+    const_iterator end() const;
+    const_iterator cend() const;
+    reverse_iterator rbegin();
+    const_reverse_iterator crbegin() const;
+    reverse_iterator rend();
+    const_reverse_iterator crend() const;
 };
 
+/**
+ * @brief aligned_array - the storage is aligned by Alignment bytes
+ */
+template<typename T, std::size_t N, std::size_t Alignment = CACHE_LINE_SIZE>
+using aligned_array = array<T, N, aligned_allocator<T, Alignment>>;
+
 /**
  * @brief Default constructor
  */
-template<typename T, std::size_t N>
-array<T, N>::array()
+template<typename T, std::size_t N, class Allocator>
+array<T, N, Allocator>::array()
     :m_size(N)
 {
-    m_arr = new T[m_size];
+    allocate(m_size);
+    for(std::size_t indx=0; indx<m_cap; ++indx)
+    {
+        alloc_traits::construct(m_alloc, m_arr+indx);
+    }
+}
+
+/**
+ * @brief Constructor with the allocator instance
+ */
+template<typename T, std::size_t N, class Allocator>
+array<T, N, Allocator>::array(const Allocator& alloc)
+    :m_alloc(alloc)
+    ,m_size(N)
+{
+    allocate(m_size);
+    for(std::size_t indx=0; indx<m_cap; ++indx)
+    {
+        alloc_traits::construct(m_alloc, m_arr+indx);
+    }
 }
 
 /**
  * @brief Destructor
  */
-template<typename T, std::size_t N>
-array<T, N>::~array()
+template<typename T, std::size_t N, class Allocator>
+array<T, N, Allocator>::~array()
 {
-    delete[] m_arr;
+    deallocate();
 }
 
 /**
  * @brief For object make, constructor uses initializer_list
  */
-template<typename T, std::size_t N>
-array<T, N>::array(std::initializer_list<T> ilist)
-    :m_size(ilist.size())
+template<typename T, std::size_t N, class Allocator>
+array<T, N, Allocator>::array(std::initializer_list<T> ilist, const Allocator& alloc)
+    :m_alloc(alloc)
+    ,m_size(ilist.size())
 {
-    m_arr = new (std::nothrow) T[m_size];
-    if(m_arr != NULL)
+    allocate(m_size);
+    std::size_t indx=0;
+    for(auto &element : ilist)
     {
-        std::size_t indx=0;
-        for(auto &element : ilist)
-        {
-            m_arr[indx] = element;
-            ++indx;
-        }
+        alloc_traits::construct(m_alloc, m_arr+indx, element);
+        ++indx;
     }
-    ++m_size;
 }
 
 /**
  * @brief Copy constructor
  */
-template<typename T, std::size_t N>
-array<T, N>::array(const array<T, N>& other)
-    :m_size(other.m_size)
+template<typename T, std::size_t N, class Allocator>
+array<T, N, Allocator>::array(const array<T, N, Allocator>& other)
+    :m_alloc(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    ,m_size(other.m_size)
 {
-    m_arr = new (std::nothrow) T[m_size];
-    if(m_arr != NULL)
+    allocate(other.m_cap);
+    for(std::size_t indx=0; indx<m_cap; ++indx)
     {
-        for(std::size_t indx=0; indx<m_size; ++indx)
-        {
-            m_arr[indx] = other.m_arr[indx];
-        }
-    }
-    else
-    {
-        assert(m_arr && "Array error: unable to allocate memory in default constructor");
+        alloc_traits::construct(m_alloc, m_arr+indx, other.m_arr[indx]);
     }
 }
 
 /**
  * @brief Assignment operator
+ *        The allocator is replaced if propagate_on_container_copy_assignment is set.
+ *        The copies are made in the new storage first, the old storage is released
+ *        only after that, so this array is unchanged if the allocation or a copy throws.
  */
-template<typename T, std::size_t N>
-array<T, N>& array<T, N>::operator=(const array<T, N>& other)
+template<typename T, std::size_t N, class Allocator>
+array<T, N, Allocator>& array<T, N, Allocator>::operator=(const array<T, N, Allocator>& other)
 {
     if(this != &other)
     {
-        delete[] m_arr;
-
-        m_size = other.m_size;
-        m_arr = new (std::nothrow) T[m_size];
-        if(m_arr != NULL)
-        {
-            for(std::size_t indx=0; indx<m_size; ++indx)
+        Allocator alloc = alloc_traits::propagate_on_container_copy_assignment::value ? other.m_alloc : m_alloc;
+        T* arr = (other.m_cap != 0) ? alloc_traits::allocate(alloc, other.m_cap) : nullptr;
+        std::size_t indx=0;
+        try{
+            for(; indx<other.m_cap; ++indx)
             {
-                m_arr[indx] = other.m_arr[indx];
+                alloc_traits::construct(alloc, arr+indx, other.m_arr[indx]);
+            }
+        }
+        catch(...){
+            while(indx != 0)
+            {
+                --indx;
+                alloc_traits::destroy(alloc, arr+indx);
+            }
+            if(arr != nullptr){
+                alloc_traits::deallocate(alloc, arr, other.m_cap);
             }
+            throw;
         }
-        else
+
+        deallocate();
+        if(alloc_traits::propagate_on_container_copy_assignment::value)
         {
-            assert(m_arr && "Array error: unable to allocate memory in default constructor");
+            m_alloc = other.m_alloc;
         }
+        m_arr = arr;
+        m_cap = other.m_cap;
+        m_size = other.m_size;
     }
     return *this;
 }
 
+/**
+ * @brief Returns the allocator associated with the container.
+ */
+template<typename T, std::size_t N, class Allocator>
+Allocator array<T, N, Allocator>::get_allocator() const
+{
+    return m_alloc;
+}
+
+/**
+ * @brief Allocates the storage for n elements, the elements are not constructed.
+ */
+template<typename T, std::size_t N, class Allocator>
+void array<T, N, Allocator>::allocate(std::size_t n)
+{
+    m_cap = n;
+    m_arr = (n != 0) ? alloc_traits::allocate(m_alloc, n) : nullptr;
+}
+
+/**
+ * @brief Destroys the elements and returns the storage to the allocator.
+ */
+template<typename T, std::size_t N, class Allocator>
+void array<T, N, Allocator>::deallocate()
+{
+    if(m_arr == nullptr){
+        return;
+    }
+    for(std::size_t indx=0; indx<m_cap; ++indx)
+    {
+        alloc_traits::destroy(m_alloc, m_arr+indx);
+    }
+    alloc_traits::deallocate(m_alloc, m_arr, m_cap);
+    m_arr = nullptr;
+    m_cap = 0;
+}
+
 /**
  * @brief Returns a reference to the element at specified location pos, with bounds checking
  * @param pos -	position of the element to return
  * @return Reference to the requested element
  */
-template<typename T, std::size_t N>
-T& array<T, N>::at(std::size_t pos)
+template<typename T, std::size_t N, class Allocator>
+T& array<T, N, Allocator>::at(std::size_t pos)
 {
     assert((pos>=0 || pos<m_size) && "Array error: pos out of range");
     return *(m_arr+pos);
@@ -168,8 +300,8 @@ T& array<T, N>::at(std::size_t pos)
  * @return A reference to the element at specified location index.
  *         With bounds checking.
  */
-template<typename T, std::size_t N>
-T& array<T, N>::operator[](std::size_t pos)
+template<typename T, std::size_t N, class Allocator>
+T& array<T, N, Allocator>::operator[](std::size_t pos)
 {
     assert((pos>=0 || pos<m_size) && "Array error: pos out of range");
     return m_arr[pos];
@@ -181,8 +313,8 @@ T& array<T, N>::operator[](std::size_t pos)
  * @return A const reference to the element at specified location index.
  *         With bounds checking.
  */
-template<typename T, std::size_t N>
-const T& array<T, N>::operator[](std::size_t pos) const
+template<typename T, std::size_t N, class Allocator>
+const T& array<T, N, Allocator>::operator[](std::size_t pos) const
 {
     assert((pos>=0 || pos<m_size) && "Array error: pos out of range");
     return m_arr[pos];
@@ -192,8 +324,8 @@ const T& array<T, N>::operator[](std::size_t pos) const
  * @brief Get a first element from the array.
  * @return The first element from the array
  */
-template<typename T, std::size_t N>
-T& array<T, N>::front()
+template<typename T, std::size_t N, class Allocator>
+T& array<T, N, Allocator>::front()
 {
     return m_arr[0];
 }
@@ -202,18 +334,18 @@ T& array<T, N>::front()
  * @brief Get a back element from the array.
  * @return The back element from the array
  */
-template<typename T, std::size_t N>
-T& array<T, N>::back()
+template<typename T, std::size_t N, class Allocator>
+T& array<T, N, Allocator>::back()
 {
-    return m_arr[m_size];
+    return m_arr[m_size-1];
 }
 
 /**
  * @brief Checks whether the container is empty.
  * @return True if is empty, false otherwise.
  */
-template<typename T, std::size_t N>
-bool array<T, N>::empty()
+template<typename T, std::size_t N, class Allocator>
+bool array<T, N, Allocator>::empty()
 {
     return m_size == 0;
 }
@@ -222,8 +354,8 @@ bool array<T, N>::empty()
  * @brief The number of elements.
  * @return The number of elements in the container.
  */
-template<typename T, std::size_t N>
-std::size_t array<T, N>::size()
+template<typename T, std::size_t N, class Allocator>
+std::size_t array<T, N, Allocator>::size()
 {
     return m_size;
 }
@@ -234,8 +366,8 @@ std::size_t array<T, N>::size()
  * @param rhs The right operand of the expression. Transfer by the const reference
  * @return The bool value to returned
  */
-template<typename T, std::size_t N>
-bool operator==(const array<T, N>& lhs, const array<T, N>& rhs)
+template<typename T, std::size_t N, class Allocator>
+bool operator==(const array<T, N, Allocator>& lhs, const array<T, N, Allocator>& rhs)
 {
     if(lhs.size() != rhs.size()){
         return false;
@@ -253,8 +385,8 @@ bool operator==(const array<T, N>& lhs, const array<T, N>& rhs)
  * @param rhs The right operand of the expression. Transfer by the const reference
  * @return The bool value to returned
  */
-template<typename T, std::size_t N>
-bool operator!=(const array<T, N>& lhs, const array<T, N>& rhs)
+template<typename T, std::size_t N, class Allocator>
+bool operator!=(const array<T, N, Allocator>& lhs, const array<T, N, Allocator>& rhs)
 {
     return !(lhs == rhs);
 }
@@ -265,8 +397,8 @@ bool operator!=(const array<T, N>& lhs, const array<T, N>& rhs)
  * @param rhs The right operand of the expression. Transfer by the const reference
  * @return The bool value to returned
  */
-template<typename T, std::size_t N>
-bool operator<(const array<T, N>& lhs, const array<T, N>& rhs)
+template<typename T, std::size_t N, class Allocator>
+bool operator<(const array<T, N, Allocator>& lhs, const array<T, N, Allocator>& rhs)
 {
     if(lhs.size() > rhs.size()){
         return false;
@@ -284,18 +416,58 @@ bool operator<(const array<T, N>& lhs, const array<T, N>& rhs)
  * @param rhs The right operand of the expression. Transfer by the const reference
  * @return The bool value to returned
  */
-template<typename T, std::size_t N>
-bool operator>(const array<T, N>& lhs, const array<T, N>& rhs)
+template<typename T, std::size_t N, class Allocator>
+bool operator>(const array<T, N, Allocator>& lhs, const array<T, N, Allocator>& rhs)
 {
     return (rhs < lhs);
 }
 
+/**
+ * @brief Direct access to the underlying contiguous storage.
+ * @return Pointer to the first element.
+ */
+template<typename T, std::size_t N, class Allocator>
+T* array<T, N, Allocator>::data()
+{
+    return m_arr;
+}
+
+/**
+ * @brief Direct access to the underlying contiguous storage.
+ * @return Const pointer to the first element.
+ */
+template<typename T, std::size_t N, class Allocator>
+const T* array<T, N, Allocator>::data() const
+{
+    return m_arr;
+}
+
+/**
+ * @brief The storage pointer annotated with the alignment of the Allocator.
+ * @return Pointer to the first element.
+ */
+template<typename T, std::size_t N, class Allocator>
+T* array<T, N, Allocator>::aligned_data()
+{
+    return assume_aligned<allocator_alignment<Allocator>::value>(m_arr);
+}
+
+/**
+ * @brief The const storage pointer annotated with the alignment of the Allocator.
+ * @return Const pointer to the first element.
+ */
+template<typename T, std::size_t N, class Allocator>
+const T* array<T, N, Allocator>::aligned_data() const
+{
+    return assume_aligned<allocator_alignment<Allocator>::value>(m_arr);
+}
+
 /**
 * @brief Begin iterator.
 * @return An iterator to the first element.
 */
-template<typename T, std::size_t N>
-typename array<T, N>::iterator array<T, N>::begin()
+template<typename T, std::size_t N, class Allocator>
+typename array<T, N, Allocator>::iterator array<T, N, Allocator>::begin()
 {
     return iterator(m_arr);
 }
@@ -304,18 +476,28 @@ typename array<T, N>::iterator array<T, N>::begin()
  * @brief Const begin iterator.
  * @return An const iterator to the first element.
  */
-template<typename T, std::size_t N>
-typename array<T, N>::iterator array<T, N>::cbegin() const
+template<typename T, std::size_t N, class Allocator>
+typename array<T, N, Allocator>::const_iterator array<T, N, Allocator>::begin() const
 {
-    return iterator(m_arr);
+    return const_iterator(m_arr);
+}
+
+/**
+ * @brief Const begin iterator.
+ * @return An const iterator to the first element.
+ */
+template<typename T, std::size_t N, class Allocator>
+typename array<T, N, Allocator>::const_iterator array<T, N, Allocator>::cbegin() const
+{
+    return const_iterator(m_arr);
 }
 
 /**
  * @brief End iterator.
  * @return An iterator to one past the last element.
  */
-template<typename T, std::size_t N>
-typename array<T, N>::iterator array<T, N>::end()
+template<typename T, std::size_t N, class Allocator>
+typename array<T, N, Allocator>::iterator array<T, N, Allocator>::end()
 {
     return iterator(m_arr+m_size);
 }
@@ -324,12 +506,61 @@ typename array<T, N>::iterator array<T, N>::end()
  * @brief Const end iterator.
  * @return An const iterator to one past the last element.
  */
-template<typename T, std::size_t N>
-typename array<T, N>::iterator array<T, N>::cend() const
+template<typename T, std::size_t N, class Allocator>
+typename array<T, N, Allocator>::const_iterator array<T, N, Allocator>::end() const
 {
-    return iterator(m_arr+m_size);
+    return const_iterator(m_arr+m_size);
+}
+
+/**
+ * @brief Const end iterator.
+ * @return An const iterator to one past the last element.
+ */
+template<typename T, std::size_t N, class Allocator>
+typename array<T, N, Allocator>::const_iterator array<T, N, Allocator>::cend() const
+{
+    return const_iterator(m_arr+m_size);
 }
 
+/**
+ * @brief Reverse begin iterator.
+ * @return A reverse iterator to the last element.
+ */
+template<typename T, std::size_t N, class Allocator>
+typename array<T, N, Allocator>::reverse_iterator array<T, N, Allocator>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+/**
+ * @brief Const reverse begin iterator.
+ * @return A const reverse iterator to the last element.
+ */
+template<typename T, std::size_t N, class Allocator>
+typename array<T, N, Allocator>::const_reverse_iterator array<T, N, Allocator>::crbegin() const
+{
+    return const_reverse_iterator(cend());
+}
+
+/**
+ * @brief Reverse end iterator.
+ * @return A reverse iterator to one before the first element.
+ */
+template<typename T, std::size_t N, class Allocator>
+typename array<T, N, Allocator>::reverse_iterator array<T, N, Allocator>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+/**
+ * @brief Const reverse end iterator.
+ * @return A const reverse iterator to one before the first element.
+ */
+template<typename T, std::size_t N, class Allocator>
+typename array<T, N, Allocator>::const_reverse_iterator array<T, N, Allocator>::crend() const
+{
+    return const_reverse_iterator(cbegin());
+}
 }
 
 #endif //ARRAY_H
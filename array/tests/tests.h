@@ -5,6 +5,8 @@
 #include <ctime>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <stdexcept>
 #include "array.h"
 
 namespace array_testing {
@@ -49,7 +51,7 @@ TEST(CheckArr, CheckSize)
     //Act
     //Assert
     ASSERT_FALSE(sarr.empty());
-    ASSERT_EQ(sarr.size(), 11);
+    ASSERT_EQ(sarr.size(), size);
 }
 
 TEST(CheckArr, CheckAccesByIndex)
@@ -84,6 +86,78 @@ TEST(CheckArr, CheckAt)
     ASSERT_EQ(sarr[size-1], thrid);
 }
 
+TEST(CheckArr, CheckIterators)
+{
+    //Arrange
+    scl::array<int, size> arr{{7,3,9,1,10,2,8,4,6,5}};
+    const scl::array<int, size>& carr = arr;
+    //Act
+    std::sort(arr.begin(), arr.end());
+    scl::array<int, size>::const_iterator found = std::lower_bound(carr.cbegin(), carr.cend(), 6);
+    //Assert
+    ASSERT_EQ(carr.cend() - carr.cbegin(), size);
+    ASSERT_EQ(arr.end() - arr.begin(), static_cast<std::ptrdiff_t>(arr.size()));
+    ASSERT_EQ(&arr.back(), &*(arr.end() - 1));
+    ASSERT_TRUE(std::is_sorted(carr.begin(), carr.end()));
+    ASSERT_EQ(found - carr.begin(), 5);
+    ASSERT_EQ(*found, 6);
+    ASSERT_EQ(arr.begin()[size-1], 10);
+    ASSERT_EQ(*arr.rbegin(), 10);
+    ASSERT_TRUE(arr.begin() + 2 < arr.cend() - 2);
+    ASSERT_EQ(carr.data(), &arr.front());
+}
+
+
+/**
+ * @brief The element whose copy throws when the countdown of copies reaches zero
+ */
+struct throwing_copy
+{
+    static int countdown;
+    int value = 0;
+    throwing_copy() = default;
+    throwing_copy(const throwing_copy& other):value(other.value)
+    {
+        if(--countdown == 0){
+            throw std::runtime_error("copy");
+        }
+    }
+};
+int throwing_copy::countdown = -1;
+
+TEST(CheckArr, CheckAssignment)
+{
+    //Arrange
+    scl::array<throwing_copy, size> arr;
+    scl::array<throwing_copy, size> other;
+    arr[0].value = 1;
+    other[0].value = 2;
+    throwing_copy* storage = arr.data();
+    //Act
+    throwing_copy::countdown = size/2;
+    ASSERT_THROW(arr = other, std::runtime_error);
+    throwing_copy::countdown = -1;
+    //Assert
+    ASSERT_EQ(arr.data(), storage);
+    ASSERT_EQ(arr[0].value, 1);
+    arr = other;
+    ASSERT_EQ(arr[0].value, 2);
+    ASSERT_EQ(arr.size(), other.size());
+}
+
+TEST(CheckArr, CheckAligned)
+{
+    //Arrange
+    scl::aligned_array<double, size> arr;
+    scl::aligned_array<char, 3, 4096> page;
+    //Act
+    arr[0] = 1.5;
+    //Assert
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(arr.data()) % CACHE_LINE_SIZE, 0U);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(page.data()) % 4096, 0U);
+    ASSERT_EQ(arr.aligned_data(), arr.data());
+    ASSERT_EQ(arr.aligned_data()[0], 1.5);
+}
 }
 
 #endif //ARRAY_TESTS_H
@@ -0,0 +1,883 @@
+#ifndef BIT_VECTOR_H
+#define BIT_VECTOR_H
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "vector.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCL_BIT_VECTOR_X86 1
+#define SCL_BIT_VECTOR_POPCNT __attribute__((target("popcnt")))
+#endif
+
+/**
+ * @brief BIT_VECTOR_WORD_BITS - the bits of one storage word
+ * @brief BIT_VECTOR_RANK_BLOCK_WORDS - the words of one block of the rank index, 512 bits
+ */
+constexpr std::size_t BIT_VECTOR_WORD_BITS = 64U;
+constexpr std::size_t BIT_VECTOR_RANK_BLOCK_WORDS = 8U;
+
+// Sequence containers library)
+namespace scl {
+
+namespace detail {
+/**
+ * @brief The set bits of the words [0, n), the portable kernel.
+ *        Without -mpopcnt the builtin is the libgcc bit twiddling call.
+ */
+inline std::size_t popcount_scalar(const std::uint64_t* words, std::size_t n)
+{
+    std::size_t count = 0;
+    for(std::size_t i=0; i<n; ++i)
+    {
+        count += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    }
+    return count;
+}
+
+#ifdef SCL_BIT_VECTOR_X86
+/**
+ * @brief The set bits of the words [0, n), the kernel of the popcnt instruction.
+ *        Four independent counters hide the latency of popcnt.
+ */
+SCL_BIT_VECTOR_POPCNT inline std::size_t popcount_hw(const std::uint64_t* words, std::size_t n)
+{
+    std::size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    std::size_t i = 0;
+    for(; i+4<=n; i+=4)
+    {
+        c0 += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+        c1 += static_cast<std::size_t>(__builtin_popcountll(words[i+1]));
+        c2 += static_cast<std::size_t>(__builtin_popcountll(words[i+2]));
+        c3 += static_cast<std::size_t>(__builtin_popcountll(words[i+3]));
+    }
+    for(; i<n; ++i)
+    {
+        c0 += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    }
+    return c0 + c1 + c2 + c3;
+}
+#endif
+
+/**
+ * @brief The set bits of the words [0, n), the popcnt kernel is picked at runtime if the CPU supports it.
+ */
+inline std::size_t popcount_words(const std::uint64_t* words, std::size_t n)
+{
+#ifdef SCL_BIT_VECTOR_X86
+    static const bool has_popcnt = __builtin_cpu_supports("popcnt");
+    if(has_popcnt){
+        return popcount_hw(words, n);
+    }
+#endif
+    return popcount_scalar(words, n);
+}
+
+/**
+ * @brief The position of the k-th (from 0) set bit of the word, k < popcount(word).
+ */
+inline std::size_t select_in_word(std::uint64_t word, std::size_t k)
+{
+    for(; k>0; --k)
+    {
+        word &= word - 1;
+    }
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+}
+}
+
+/**
+ * Packed bit vector
+ * @brief The bits are packed by 64 into the words of scl::vector<std::uint64_t>,
+ *  one bit per element instead of one byte. The bits of the last word past size()
+ *  are always zero, so the word-level operations need no masking: and/or/xor/not
+ *  are one operation per 64 bits, count() is the popcount of the words,
+ *  find_first/find_next skip the zero words and take ctz of the first nonzero one.
+ *  rank() and select() scan the words, rank_select is the index for the repeated queries.
+ *  operator[] returns the reference proxy, as std::vector<bool> does.
+ */
+class bit_vector
+{
+public:
+    using word_type = std::uint64_t;
+
+    /**
+     * @brief The proxy of one bit
+     */
+    class reference
+    {
+    public:
+        reference(word_type* word, word_type mask) noexcept:m_word(word), m_mask(mask){}
+        reference(const reference&) = default;
+
+        inline operator bool() const {return (*m_word & m_mask) != 0;}
+        inline bool operator~() const {return (*m_word & m_mask) == 0;}
+        reference& operator=(bool value)
+        {
+            if(value){
+                *m_word |= m_mask;
+            }
+            else{
+                *m_word &= ~m_mask;
+            }
+            return *this;
+        }
+        reference& operator=(const reference& other){return *this = static_cast<bool>(other);}
+        void flip(){*m_word ^= m_mask;}
+
+    private:
+        word_type* m_word;
+        word_type m_mask;
+    };
+
+    template<class BitVector, class Ref>
+    class basic_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Ref;
+
+        basic_iterator() noexcept:m_bits(nullptr), m_index(0){}
+        basic_iterator(BitVector* bits, std::size_t index) noexcept:m_bits(bits), m_index(index){}
+        template<class B2, class R2, class = typename std::enable_if<std::is_convertible<B2*, BitVector*>::value>::type>
+        basic_iterator(const basic_iterator<B2, R2>& other) noexcept:m_bits(other.bits()), m_index(other.index()){}
+
+        inline std::size_t index() const {return m_index;}
+        inline BitVector* bits() const {return m_bits;}
+        inline Ref operator*() const {return (*m_bits)[m_index];}
+        inline Ref operator[](difference_type n) const {return *(*this + n);}
+
+        basic_iterator& operator++(){++m_index; return *this;}//++i
+        basic_iterator& operator--(){--m_index; return *this;}//--i
+        basic_iterator operator++(int){basic_iterator it = *this; ++m_index; return it;}//i++
+        basic_iterator operator--(int){basic_iterator it = *this; --m_index; return it;}//i--
+        basic_iterator& operator+=(difference_type n){m_index += n; return *this;}
+        basic_iterator& operator-=(difference_type n){m_index -= n; return *this;}
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n){return it += n;}
+        friend basic_iterator operator-(basic_iterator it, difference_type n){return it -= n;}
+        friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs)
+        {
+            return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_index == rhs.m_index;}
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_index != rhs.m_index;}
+        friend bool operator<(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_index < rhs.m_index;}
+
+    private:
+        BitVector* m_bits;
+        std::size_t m_index;
+    };
+
+    using iterator = basic_iterator<bit_vector, reference>;
+    using const_iterator = basic_iterator<const bit_vector, bool>;
+
+private:
+    scl::vector<word_type> m_words;
+    std::size_t m_size = 0;
+
+    static std::size_t words_for(std::size_t bits);
+    static word_type mask_of(std::size_t pos);
+    void clear_tail();
+    void fill_words(word_type value);
+    std::size_t find_from(std::size_t pos) const;
+
+public:
+    bit_vector() {}
+    explicit bit_vector(std::size_t size, bool value = false);
+    bit_vector(std::initializer_list<bool> init);
+    bit_vector(const bit_vector& other) = default;
+    bit_vector(bit_vector&& other) noexcept;
+    bit_vector& operator=(const bit_vector& other) = default;
+    bit_vector& operator=(bit_vector&& other) noexcept;
+
+    inline std::size_t size() const;
+    bool empty() const;
+    std::size_t capacity() const;
+    std::size_t word_count() const;
+    word_type* data();
+    const word_type* data() const;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    reference operator[](std::size_t pos);
+    bool operator[](std::size_t pos) const;
+    bool at(std::size_t pos) const;
+    reference front();
+    bool front() const;
+    reference back();
+    bool back() const;
+
+    void set(std::size_t pos, bool value = true);
+    void reset(std::size_t pos);
+    void flip(std::size_t pos);
+    void set();
+    void reset();
+    void flip();
+
+    void push_back(bool value);
+    void pop_back();
+    void resize(std::size_t size, bool value = false);
+    void reserve(std::size_t bits);
+    void clear();
+    void shrink_to_fit();
+
+    bit_vector& operator&=(const bit_vector& other);
+    bit_vector& operator|=(const bit_vector& other);
+    bit_vector& operator^=(const bit_vector& other);
+    bit_vector operator~() const;
+
+    std::size_t count() const;
+    bool all() const;
+    bool any() const;
+    bool none() const;
+    std::size_t find_first() const;
+    std::size_t find_next(std::size_t pos) const;
+    std::size_t rank(std::size_t pos) const;
+    std::size_t select(std::size_t k) const;
+
+    friend bool operator==(const bit_vector& lhs, const bit_vector& rhs);
+    friend bool operator!=(const bit_vector& lhs, const bit_vector& rhs);
+};
+
+/**
+ * @brief Ctor of size bits set to value
+ */
+inline bit_vector::bit_vector(std::size_t size, bool value)
+    :m_words(words_for(size))
+    ,m_size(size)
+{
+    if(value){
+        set();
+    }
+}
+
+/**
+ * @brief Ctor from the list of bits
+ */
+inline bit_vector::bit_vector(std::initializer_list<bool> init)
+{
+    reserve(init.size());
+    for(bool value : init)
+    {
+        push_back(value);
+    }
+}
+
+/**
+ * @brief Move ctor, other is left empty
+ */
+inline bit_vector::bit_vector(bit_vector&& other) noexcept
+    :m_words(std::move(other.m_words))
+    ,m_size(other.m_size)
+{
+    other.m_size = 0;
+}
+
+/**
+ * @brief Move assignment, other is left empty
+ */
+inline bit_vector& bit_vector::operator=(bit_vector&& other) noexcept
+{
+    if(this != &other){
+        m_words = std::move(other.m_words);
+        m_size = other.m_size;
+        other.m_words.clear();
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+/**
+ * @brief The number of the words holding bits bits.
+ */
+inline std::size_t bit_vector::words_for(std::size_t bits)
+{
+    return (bits + BIT_VECTOR_WORD_BITS - 1) / BIT_VECTOR_WORD_BITS;
+}
+
+/**
+ * @brief The mask of the bit pos inside its word.
+ */
+inline bit_vector::word_type bit_vector::mask_of(std::size_t pos)
+{
+    return word_type(1) << (pos % BIT_VECTOR_WORD_BITS);
+}
+
+/**
+ * @brief Zeroes the bits of the last word past size(), the invariant of the word-level operations.
+ */
+inline void bit_vector::clear_tail()
+{
+    const std::size_t used = m_size % BIT_VECTOR_WORD_BITS;
+    if(used != 0){
+        m_words.back() &= (word_type(1) << used) - 1;
+    }
+}
+
+/**
+ * @brief Sets all the words to value and restores the zero tail.
+ */
+inline void bit_vector::fill_words(word_type value)
+{
+    std::fill(m_words.begin(), m_words.end(), value);
+    clear_tail();
+}
+
+/**
+ * @brief The position of the first set bit not less than pos, size() if there is none.
+ */
+inline std::size_t bit_vector::find_from(std::size_t pos) const
+{
+    if(pos >= m_size){
+        return m_size;
+    }
+    std::size_t w = pos / BIT_VECTOR_WORD_BITS;
+    word_type word = m_words[w] & (~word_type(0) << (pos % BIT_VECTOR_WORD_BITS));
+    while(word == 0)
+    {
+        if(++w == m_words.size()){
+            return m_size;
+        }
+        word = m_words[w];
+    }
+    return w*BIT_VECTOR_WORD_BITS + static_cast<std::size_t>(__builtin_ctzll(word));
+}
+
+/**
+ * @brief The number of bits
+ */
+inline std::size_t bit_vector::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief Checks whether the container is empty
+ */
+inline bool bit_vector::empty() const
+{
+    return m_size == 0;
+}
+
+/**
+ * @brief The number of bits the allocated words can hold
+ */
+inline std::size_t bit_vector::capacity() const
+{
+    return m_words.capacity()*BIT_VECTOR_WORD_BITS;
+}
+
+/**
+ * @brief The number of the storage words, (size() + 63) / 64
+ */
+inline std::size_t bit_vector::word_count() const
+{
+    return m_words.size();
+}
+
+/**
+ * @brief The storage words, the bit pos is the bit pos % 64 of the word pos / 64.
+ *        The bits past size() must be kept zero.
+ */
+inline bit_vector::word_type* bit_vector::data()
+{
+    return m_words.data();
+}
+
+/**
+ * @brief The const storage words
+ */
+inline const bit_vector::word_type* bit_vector::data() const
+{
+    return m_words.data();
+}
+
+/**
+ * @brief Returns an iterator to the first bit
+ */
+inline bit_vector::iterator bit_vector::begin()
+{
+    return iterator(this, 0);
+}
+
+/**
+ * @brief Returns an iterator past the last bit
+ */
+inline bit_vector::iterator bit_vector::end()
+{
+    return iterator(this, m_size);
+}
+
+/**
+ * @brief Returns a const iterator to the first bit
+ */
+inline bit_vector::const_iterator bit_vector::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+/**
+ * @brief Returns a const iterator past the last bit
+ */
+inline bit_vector::const_iterator bit_vector::end() const
+{
+    return const_iterator(this, m_size);
+}
+
+/**
+ * @brief The proxy of the bit pos
+ */
+inline bit_vector::reference bit_vector::operator[](std::size_t pos)
+{
+    assert((pos < m_size) && "Bit vector error: index out of range");
+    return reference(&m_words[pos / BIT_VECTOR_WORD_BITS], mask_of(pos));
+}
+
+/**
+ * @brief The value of the bit pos
+ */
+inline bool bit_vector::operator[](std::size_t pos) const
+{
+    assert((pos < m_size) && "Bit vector error: index out of range");
+    return (m_words[pos / BIT_VECTOR_WORD_BITS] & mask_of(pos)) != 0;
+}
+
+/**
+ * @brief The value of the bit pos with the bounds checking.
+ * @throw std::out_of_range if pos >= size().
+ */
+inline bool bit_vector::at(std::size_t pos) const
+{
+    if(pos >= m_size){
+        throw std::out_of_range("Bit vector error: index out of range");
+    }
+    return (*this)[pos];
+}
+
+/**
+ * @brief The proxy of the first bit
+ */
+inline bit_vector::reference bit_vector::front()
+{
+    return (*this)[0];
+}
+
+/**
+ * @brief The value of the first bit
+ */
+inline bool bit_vector::front() const
+{
+    return (*this)[0];
+}
+
+/**
+ * @brief The proxy of the last bit
+ */
+inline bit_vector::reference bit_vector::back()
+{
+    return (*this)[m_size-1];
+}
+
+/**
+ * @brief The value of the last bit
+ */
+inline bool bit_vector::back() const
+{
+    return (*this)[m_size-1];
+}
+
+/**
+ * @brief Sets the bit pos to value
+ */
+inline void bit_vector::set(std::size_t pos, bool value)
+{
+    (*this)[pos] = value;
+}
+
+/**
+ * @brief Clears the bit pos
+ */
+inline void bit_vector::reset(std::size_t pos)
+{
+    (*this)[pos] = false;
+}
+
+/**
+ * @brief Inverts the bit pos
+ */
+inline void bit_vector::flip(std::size_t pos)
+{
+    (*this)[pos].flip();
+}
+
+/**
+ * @brief Sets all the bits
+ */
+inline void bit_vector::set()
+{
+    fill_words(~word_type(0));
+}
+
+/**
+ * @brief Clears all the bits
+ */
+inline void bit_vector::reset()
+{
+    fill_words(0);
+}
+
+/**
+ * @brief Inverts all the bits, one xor per word
+ */
+inline void bit_vector::flip()
+{
+    for(word_type& word : m_words)
+    {
+        word = ~word;
+    }
+    clear_tail();
+}
+
+/**
+ * @brief Appends the bit, a new word is added every 64 bits
+ */
+inline void bit_vector::push_back(bool value)
+{
+    if(m_size % BIT_VECTOR_WORD_BITS == 0){
+        m_words.push_back(0);
+    }
+    if(value){
+        m_words.back() |= mask_of(m_size);
+    }
+    ++m_size;
+}
+
+/**
+ * @brief Removes the last bit
+ */
+inline void bit_vector::pop_back()
+{
+    assert((m_size > 0) && "Bit vector error: pop_back of the empty container");
+    --m_size;
+    if(m_size % BIT_VECTOR_WORD_BITS == 0){
+        m_words.pop_back();
+    }
+    else{
+        m_words.back() &= ~mask_of(m_size);
+    }
+}
+
+/**
+ * @brief Changes the number of bits, the new bits are set to value word by word.
+ * @param size new container size.
+ */
+inline void bit_vector::resize(std::size_t size, bool value)
+{
+    const std::size_t old_size = m_size;
+    m_words.resize(words_for(size));
+    m_size = size;
+    if(value && size > old_size){
+        std::size_t w = old_size / BIT_VECTOR_WORD_BITS;
+        if(old_size % BIT_VECTOR_WORD_BITS != 0){
+            m_words[w++] |= ~word_type(0) << (old_size % BIT_VECTOR_WORD_BITS);
+        }
+        std::fill(m_words.begin() + w, m_words.end(), ~word_type(0));
+    }
+    clear_tail();
+}
+
+/**
+ * @brief Reserves the words for bits bits
+ */
+inline void bit_vector::reserve(std::size_t bits)
+{
+    m_words.reserve(words_for(bits));
+}
+
+/**
+ * @brief Removes all the bits, the words stay allocated
+ */
+inline void bit_vector::clear()
+{
+    m_words.clear();
+    m_size = 0;
+}
+
+/**
+ * @brief Reduces the capacity to the words in use
+ */
+inline void bit_vector::shrink_to_fit()
+{
+    m_words.shrink_to_fit();
+}
+
+/**
+ * @brief Bitwise and with the vector of the same size, one operation per word
+ */
+inline bit_vector& bit_vector::operator&=(const bit_vector& other)
+{
+    assert((m_size == other.m_size) && "Bit vector error: the sizes differ");
+    for(std::size_t w=0; w<m_words.size(); ++w)
+    {
+        m_words[w] &= other.m_words[w];
+    }
+    return *this;
+}
+
+/**
+ * @brief Bitwise or with the vector of the same size, one operation per word
+ */
+inline bit_vector& bit_vector::operator|=(const bit_vector& other)
+{
+    assert((m_size == other.m_size) && "Bit vector error: the sizes differ");
+    for(std::size_t w=0; w<m_words.size(); ++w)
+    {
+        m_words[w] |= other.m_words[w];
+    }
+    return *this;
+}
+
+/**
+ * @brief Bitwise xor with the vector of the same size, one operation per word
+ */
+inline bit_vector& bit_vector::operator^=(const bit_vector& other)
+{
+    assert((m_size == other.m_size) && "Bit vector error: the sizes differ");
+    for(std::size_t w=0; w<m_words.size(); ++w)
+    {
+        m_words[w] ^= other.m_words[w];
+    }
+    return *this;
+}
+
+/**
+ * @brief The copy with all the bits inverted
+ */
+inline bit_vector bit_vector::operator~() const
+{
+    bit_vector result(*this);
+    result.flip();
+    return result;
+}
+
+/**
+ * @brief The number of the set bits, the popcount of the words
+ */
+inline std::size_t bit_vector::count() const
+{
+    return detail::popcount_words(m_words.data(), m_words.size());
+}
+
+/**
+ * @brief Checks whether all the bits are set, true for the empty vector
+ */
+inline bool bit_vector::all() const
+{
+    return count() == m_size;
+}
+
+/**
+ * @brief Checks whether any bit is set
+ */
+inline bool bit_vector::any() const
+{
+    return find_from(0) != m_size;
+}
+
+/**
+ * @brief Checks whether no bit is set
+ */
+inline bool bit_vector::none() const
+{
+    return !any();
+}
+
+/**
+ * @brief The position of the first set bit, size() if there is none
+ */
+inline std::size_t bit_vector::find_first() const
+{
+    return find_from(0);
+}
+
+/**
+ * @brief The position of the first set bit after pos, size() if there is none
+ */
+inline std::size_t bit_vector::find_next(std::size_t pos) const
+{
+    return pos >= m_size ? m_size : find_from(pos + 1);
+}
+
+/**
+ * @brief The number of the set bits in [0, pos), O(pos / 64)
+ */
+inline std::size_t bit_vector::rank(std::size_t pos) const
+{
+    assert((pos <= m_size) && "Bit vector error: rank position out of range");
+    const std::size_t w = pos / BIT_VECTOR_WORD_BITS;
+    std::size_t result = detail::popcount_words(m_words.data(), w);
+    if(pos % BIT_VECTOR_WORD_BITS != 0){
+        result += static_cast<std::size_t>(__builtin_popcountll(m_words[w] & (mask_of(pos) - 1)));
+    }
+    return result;
+}
+
+/**
+ * @brief The position of the k-th (from 0) set bit, size() if k >= count(), O(size() / 64)
+ */
+inline std::size_t bit_vector::select(std::size_t k) const
+{
+    for(std::size_t w=0; w<m_words.size(); ++w)
+    {
+        const std::size_t ones = static_cast<std::size_t>(__builtin_popcountll(m_words[w]));
+        if(k < ones){
+            return w*BIT_VECTOR_WORD_BITS + detail::select_in_word(m_words[w], k);
+        }
+        k -= ones;
+    }
+    return m_size;
+}
+
+/**
+ * @brief Checks whether the vectors have the same bits
+ */
+inline bool operator==(const bit_vector& lhs, const bit_vector& rhs)
+{
+    return lhs.m_size == rhs.m_size && std::equal(lhs.m_words.begin(), lhs.m_words.end(), rhs.m_words.begin());
+}
+
+/**
+ * @brief Checks whether the vectors differ
+ */
+inline bool operator!=(const bit_vector& lhs, const bit_vector& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * @brief Bitwise and of the vectors of the same size
+ */
+inline bit_vector operator&(bit_vector lhs, const bit_vector& rhs)
+{
+    return lhs &= rhs;
+}
+
+/**
+ * @brief Bitwise or of the vectors of the same size
+ */
+inline bit_vector operator|(bit_vector lhs, const bit_vector& rhs)
+{
+    return lhs |= rhs;
+}
+
+/**
+ * @brief Bitwise xor of the vectors of the same size
+ */
+inline bit_vector operator^(bit_vector lhs, const bit_vector& rhs)
+{
+    return lhs ^= rhs;
+}
+
+/**
+ * Rank/select index of the bit vector
+ * @brief The counts of the set bits before every block of 512 bits, 1/8 of the size
+ *  of the bit vector. rank() is one lookup and at most 8 word popcounts, select()
+ *  is the binary search over the blocks and the scan of one block.
+ *  The index is a snapshot: it is invalid after any modification of the bit vector.
+ */
+class rank_select
+{
+private:
+    const bit_vector* m_bits;
+    scl::vector<std::size_t> m_blocks;
+
+public:
+    explicit rank_select(const bit_vector& bits);
+
+    std::size_t count() const;
+    std::size_t rank(std::size_t pos) const;
+    std::size_t select(std::size_t k) const;
+};
+
+/**
+ * @brief Builds the index in one pass over the words
+ */
+inline rank_select::rank_select(const bit_vector& bits)
+    :m_bits(&bits)
+{
+    const std::size_t words = bits.word_count();
+    const std::size_t blocks = (words + BIT_VECTOR_RANK_BLOCK_WORDS - 1) / BIT_VECTOR_RANK_BLOCK_WORDS;
+    m_blocks.reserve(blocks + 1);
+    std::size_t ones = 0;
+    m_blocks.push_back(0);
+    for(std::size_t b=0; b<blocks; ++b)
+    {
+        const std::size_t first = b*BIT_VECTOR_RANK_BLOCK_WORDS;
+        ones += detail::popcount_words(bits.data() + first, std::min(BIT_VECTOR_RANK_BLOCK_WORDS, words - first));
+        m_blocks.push_back(ones);
+    }
+}
+
+/**
+ * @brief The number of the set bits
+ */
+inline std::size_t rank_select::count() const
+{
+    return m_blocks.back();
+}
+
+/**
+ * @brief The number of the set bits in [0, pos)
+ */
+inline std::size_t rank_select::rank(std::size_t pos) const
+{
+    assert((pos <= m_bits->size()) && "Bit vector error: rank position out of range");
+    const std::size_t w = pos / BIT_VECTOR_WORD_BITS;
+    const std::size_t block = w / BIT_VECTOR_RANK_BLOCK_WORDS;
+    const std::size_t first = block*BIT_VECTOR_RANK_BLOCK_WORDS;
+    std::size_t result = m_blocks[block] + detail::popcount_words(m_bits->data() + first, w - first);
+    if(pos % BIT_VECTOR_WORD_BITS != 0){
+        const std::uint64_t below = (std::uint64_t(1) << (pos % BIT_VECTOR_WORD_BITS)) - 1;
+        result += static_cast<std::size_t>(__builtin_popcountll(m_bits->data()[w] & below));
+    }
+    return result;
+}
+
+/**
+ * @brief The position of the k-th (from 0) set bit, size() of the bit vector if k >= count()
+ */
+inline std::size_t rank_select::select(std::size_t k) const
+{
+    if(k >= count()){
+        return m_bits->size();
+    }
+    // The last block with less than k+1 set bits before it
+    const std::size_t block = static_cast<std::size_t>(std::upper_bound(m_blocks.begin(), m_blocks.end(), k) - m_blocks.begin()) - 1;
+    k -= m_blocks[block];
+    const std::uint64_t* words = m_bits->data();
+    for(std::size_t w=block*BIT_VECTOR_RANK_BLOCK_WORDS; ; ++w)
+    {
+        const std::size_t ones = static_cast<std::size_t>(__builtin_popcountll(words[w]));
+        if(k < ones){
+            return w*BIT_VECTOR_WORD_BITS + detail::select_in_word(words[w], k);
+        }
+        k -= ones;
+    }
+}
+
+}
+
+#endif //BIT_VECTOR_H
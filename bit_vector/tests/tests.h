@@ -0,0 +1,261 @@
+#ifndef BIT_VECTOR_TESTS_H
+#define BIT_VECTOR_TESTS_H
+
+#include <iostream>
+#include <ctime>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "vector.h"
+#include "bit_vector.h"
+
+namespace bit_vector_testing {
+const std::size_t num_of_elements = 100000;
+const std::size_t bench_elements = 100000000;
+const std::size_t bench_queries = 1000000;
+
+/**
+ * @brief get_time_sec - get time in seconds
+ * @return the time in seconds
+ */
+inline double get_time_sec()
+{
+    return static_cast<double>(clock())/ CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief get_new_time calculating the total time and setting the current time in seconds
+ * @param sum_time - summary time
+ * @param last_time - last time value
+ */
+void get_new_time(double &sum_time, double &last_time)
+{
+    sum_time += get_time_sec() - last_time;
+    last_time = get_time_sec();
+}
+
+void check_equal(const scl::bit_vector& bits, const std::vector<bool>& expected)
+{
+    ASSERT_EQ(bits.size(), expected.size());
+    ASSERT_TRUE(std::equal(bits.begin(), bits.end(), expected.begin()));
+    ASSERT_EQ(bits.count(), static_cast<std::size_t>(std::count(expected.begin(), expected.end(), true)));
+}
+
+std::vector<bool> random_bits(std::size_t n, int one_of)
+{
+    std::vector<bool> bits;
+    for(std::size_t i=0; i<n; ++i)
+    {
+        bits.push_back(std::rand() % one_of == 0);
+    }
+    return bits;
+}
+
+TEST(CheckBitVector, PushBackAndProxy)
+{
+    //Arrange
+    scl::bit_vector bits;
+    std::vector<bool> expected = random_bits(num_of_elements, 3);
+    //Act
+    for(bool value : expected)
+    {
+        bits.push_back(value);
+    }
+    bits[5] = true;
+    expected[5] = true;
+    bits[64] = bits[5];
+    expected[64] = true;
+    bits.flip(63);
+    expected[63] = !expected[63];
+    for(std::size_t i=0; i<1000; ++i)
+    {
+        bits.pop_back();
+        expected.pop_back();
+    }
+    //Assert
+    check_equal(bits, expected);
+    ASSERT_TRUE(bits[64]);
+    ASSERT_EQ(bits.word_count(), (expected.size() + 63) / 64);
+    ASSERT_EQ(bits.back(), expected.back());
+    ASSERT_THROW(bits.at(bits.size()), std::out_of_range);
+    scl::bit_vector list{true, false, true};
+    ASSERT_EQ(list.size(), 3U);
+    ASSERT_EQ(list.data()[0], 5U);
+    scl::bit_vector moved(std::move(list));
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(moved.count(), 2U);
+}
+
+TEST(CheckBitVector, ResizeAndBulkOperations)
+{
+    //Arrange
+    std::vector<bool> first_expected = random_bits(10007, 2);
+    std::vector<bool> second_expected = random_bits(10007, 5);
+    scl::bit_vector first, second;
+    for(std::size_t i=0; i<first_expected.size(); ++i)
+    {
+        first.push_back(first_expected[i]);
+        second.push_back(second_expected[i]);
+    }
+    //Act
+    scl::bit_vector and_bits = first & second;
+    scl::bit_vector or_bits = first | second;
+    scl::bit_vector xor_bits = first ^ second;
+    scl::bit_vector not_bits = ~first;
+    //Assert
+    std::vector<bool> and_expected, or_expected, xor_expected, not_expected;
+    for(std::size_t i=0; i<first_expected.size(); ++i)
+    {
+        and_expected.push_back(first_expected[i] && second_expected[i]);
+        or_expected.push_back(first_expected[i] || second_expected[i]);
+        xor_expected.push_back(first_expected[i] != second_expected[i]);
+        not_expected.push_back(!first_expected[i]);
+    }
+    check_equal(and_bits, and_expected);
+    check_equal(or_bits, or_expected);
+    check_equal(xor_bits, xor_expected);
+    check_equal(not_bits, not_expected);
+    ASSERT_TRUE((first ^ first).none());
+    ASSERT_TRUE((first | not_bits).all());
+    ASSERT_TRUE(~not_bits == first);
+
+    first.resize(70);
+    first_expected.resize(70);
+    first.resize(300, true);
+    first_expected.resize(300, true);
+    check_equal(first, first_expected);
+    first.resize(130);
+    first_expected.resize(130);
+    first.resize(200);
+    first_expected.resize(200);
+    check_equal(first, first_expected);
+    scl::bit_vector ones(129, true);
+    ASSERT_EQ(ones.count(), 129U);
+    ones.reset();
+    ASSERT_TRUE(ones.none());
+}
+
+TEST(CheckBitVector, FindRankSelect)
+{
+    //Arrange
+    std::vector<bool> expected = random_bits(num_of_elements, 100);
+    expected.resize(num_of_elements + 2000, false);
+    scl::bit_vector bits;
+    std::vector<std::size_t> positions;
+    for(std::size_t i=0; i<expected.size(); ++i)
+    {
+        bits.push_back(expected[i]);
+        if(expected[i]) positions.push_back(i);
+    }
+    //Act
+    std::vector<std::size_t> found;
+    for(std::size_t pos=bits.find_first(); pos!=bits.size(); pos=bits.find_next(pos))
+    {
+        found.push_back(pos);
+    }
+    scl::rank_select index(bits);
+    //Assert
+    ASSERT_EQ(found, positions);
+    ASSERT_EQ(index.count(), positions.size());
+    std::size_t ones = 0;
+    for(std::size_t pos=0; pos<=bits.size(); pos+=7)
+    {
+        while(ones < positions.size() && positions[ones] < pos) ++ones;
+        ASSERT_EQ(bits.rank(pos), ones);
+        ASSERT_EQ(index.rank(pos), ones);
+    }
+    ASSERT_EQ(index.rank(bits.size()), positions.size());
+    for(std::size_t k=0; k<positions.size(); ++k)
+    {
+        ASSERT_EQ(bits.select(k), positions[k]);
+        ASSERT_EQ(index.select(k), positions[k]);
+    }
+    ASSERT_EQ(bits.select(positions.size()), bits.size());
+    ASSERT_EQ(index.select(positions.size()), bits.size());
+    scl::bit_vector empty;
+    ASSERT_EQ(empty.find_first(), 0U);
+    ASSERT_EQ(scl::rank_select(empty).rank(0), 0U);
+}
+
+TEST(CompareBitVector, VectorBool)
+{
+    double bits_push = 0, std_push = 0, bits_count = 0, std_count = 0, bits_find = 0, std_find = 0;
+    double last_time = get_time_sec();
+    scl::bit_vector bits;
+    for(std::size_t i=0; i<bench_elements; ++i)
+    {
+        bits.push_back(i % 7 == 0);
+    }
+    get_new_time(bits_push, last_time);
+    std::vector<bool> std_bits;
+    for(std::size_t i=0; i<bench_elements; ++i)
+    {
+        std_bits.push_back(i % 7 == 0);
+    }
+    get_new_time(std_push, last_time);
+
+    std::size_t bits_ones = bits.count();
+    get_new_time(bits_count, last_time);
+    std::size_t std_ones = static_cast<std::size_t>(std::count(std_bits.begin(), std_bits.end(), true));
+    get_new_time(std_count, last_time);
+
+    std::size_t bits_found = 0, std_found = 0;
+    for(std::size_t pos=bits.find_first(); pos!=bits.size(); pos=bits.find_next(pos))
+    {
+        ++bits_found;
+    }
+    get_new_time(bits_find, last_time);
+    for(std::vector<bool>::const_iterator it=std::find(std_bits.cbegin(), std_bits.cend(), true); it!=std_bits.cend();
+        it=std::find(it+1, std_bits.cend(), true))
+    {
+        ++std_found;
+    }
+    get_new_time(std_find, last_time);
+    std::cout << bench_elements << " bits: push_back bit_vector " << bits_push << " s, std::vector<bool> " << std_push << " s\n"
+              << "count: bit_vector " << bits_count << " s, std::vector<bool> " << std_count << " s\n"
+              << "find_next scan: bit_vector " << bits_find << " s, std::vector<bool> " << std_find << " s\n"
+              << "memory: bit_vector " << bits.capacity() / 8 << " bytes, scl::vector<bool> "
+              << bench_elements*sizeof(bool) << " bytes\n";
+    ASSERT_EQ(bits_ones, std_ones);
+    ASSERT_EQ(bits_found, std_found);
+}
+
+TEST(CompareBitVector, RankSelect)
+{
+    scl::bit_vector bits;
+    for(std::size_t i=0; i<bench_elements / 10; ++i)
+    {
+        bits.push_back(std::rand() % 4 == 0);
+    }
+    std::vector<std::size_t> queries;
+    for(std::size_t i=0; i<bench_queries; ++i)
+    {
+        queries.push_back(static_cast<std::size_t>(std::rand()) % bits.size());
+    }
+    double build_time = 0, rank_time = 0, select_time = 0, last_time = get_time_sec();
+    scl::rank_select index(bits);
+    get_new_time(build_time, last_time);
+    std::size_t rank_sum = 0, select_sum = 0;
+    for(std::size_t pos : queries)
+    {
+        rank_sum += index.rank(pos);
+    }
+    get_new_time(rank_time, last_time);
+    for(std::size_t pos : queries)
+    {
+        select_sum += index.select(pos % index.count());
+    }
+    get_new_time(select_time, last_time);
+    std::cout << "rank_select over " << bits.size() << " bits: build " << build_time << " s, "
+              << bench_queries << " rank " << rank_time << " s, " << bench_queries << " select " << select_time << " s\n";
+    ASSERT_EQ(index.rank(queries[0]), bits.rank(queries[0]));
+    ASSERT_EQ(index.select(queries[1] % index.count()), bits.select(queries[1] % index.count()));
+    ASSERT_GT(rank_sum + select_sum, 0U);
+}
+
+}
+
+#endif //BIT_VECTOR_TESTS_H
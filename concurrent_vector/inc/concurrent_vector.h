@@ -0,0 +1,355 @@
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <new>
+#include <atomic>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief CONCURRENT_VECTOR_FIRST_BITS - log2 of the size of the first segment
+ * @brief CONCURRENT_VECTOR_FIRST_SEGMENT - the size of the first segment, the segment k holds FIRST_SEGMENT << k elements
+ * @brief CONCURRENT_VECTOR_MAX_SEGMENTS - the segments covering the whole size_t range of indexes
+ */
+constexpr std::size_t CONCURRENT_VECTOR_FIRST_BITS = 6U;
+constexpr std::size_t CONCURRENT_VECTOR_FIRST_SEGMENT = std::size_t(1) << CONCURRENT_VECTOR_FIRST_BITS;
+constexpr std::size_t CONCURRENT_VECTOR_MAX_SEGMENTS = 64U - CONCURRENT_VECTOR_FIRST_BITS;
+
+// Sequence containers library)
+namespace scl {
+
+/**
+ * Concurrent append-only vector
+ * @brief The elements are stored in the segments of the geometrically growing size,
+ *  the segment k holds CONCURRENT_VECTOR_FIRST_SEGMENT << k elements. The segments are never
+ *  relocated, so the addresses of the elements are stable and the readers need no locks.
+ *  push_back, emplace_back and grow_by are lock-free: the slots are claimed by fetch_add,
+ *  the missing segment is allocated by the claiming threads and installed by compare_exchange,
+ *  the losing threads free their copies.
+ *  Every slot has the ready flag, it is set with the release store after the construction
+ *  of the element, so the reader checking is_published() with the acquire load sees
+ *  the constructed element. operator[] is wait-free: two loads and no loop.
+ *  size() counts the claimed slots, some of them may be still under construction.
+ *  If the ctor of the element throws, its slot stays unpublished.
+ *  Only the destruction, clear() and the move are not thread safe.
+ */
+template<class T>
+class concurrent_vector
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Concurrent vector error: over-aligned types are not supported");
+
+private:
+    using ready_flag = std::atomic<unsigned char>;
+
+    std::atomic<std::size_t> m_size{0};
+    std::atomic<T*> m_segments[CONCURRENT_VECTOR_MAX_SEGMENTS];
+
+    static std::size_t segment_of(std::size_t index);
+    static std::size_t segment_base(std::size_t segment);
+    static std::size_t segment_size(std::size_t segment);
+    static ready_flag* flags(T* segment, std::size_t segment_index);
+
+    T* segment_for(std::size_t segment);
+    T* slot(std::size_t index);
+    void publish(std::size_t index);
+    void destroy_all();
+
+public:
+    concurrent_vector() noexcept;
+    concurrent_vector(concurrent_vector&& other) noexcept;
+    ~concurrent_vector();
+    concurrent_vector(const concurrent_vector&) = delete;
+    concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+    std::size_t size() const;
+    bool empty() const;
+    bool is_published(std::size_t index) const;
+
+    T& operator[](std::size_t index);
+    const T& operator[](std::size_t index) const;
+    const T& at(std::size_t index) const;
+
+    std::size_t push_back(const T& value);
+    std::size_t push_back(T&& value);
+    template<class... Args>
+    std::size_t emplace_back(Args&&... args);
+    std::size_t grow_by(std::size_t n, const T& value = T());
+
+    void clear();
+};
+
+/**
+ * @brief Default ctor, no segment is allocated
+ */
+template<class T>
+concurrent_vector<T>::concurrent_vector() noexcept
+{
+    for(std::atomic<T*>& segment : m_segments)
+    {
+        segment.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Move ctor, not thread safe, other is left empty.
+ */
+template<class T>
+concurrent_vector<T>::concurrent_vector(concurrent_vector&& other) noexcept
+{
+    m_size.store(other.m_size.exchange(0));
+    for(std::size_t k=0; k<CONCURRENT_VECTOR_MAX_SEGMENTS; ++k)
+    {
+        m_segments[k].store(other.m_segments[k].exchange(nullptr));
+    }
+}
+
+/**
+ * @brief Dtor, destroys the published elements and frees the segments.
+ */
+template<class T>
+concurrent_vector<T>::~concurrent_vector()
+{
+    destroy_all();
+}
+
+/**
+ * @brief The segment holding the element at index, log2(index / FIRST_SEGMENT + 1).
+ */
+template<class T>
+std::size_t concurrent_vector<T>::segment_of(std::size_t index)
+{
+    const unsigned long long blocks = (static_cast<unsigned long long>(index) >> CONCURRENT_VECTOR_FIRST_BITS) + 1;
+    return static_cast<std::size_t>(63 - __builtin_clzll(blocks));
+}
+
+/**
+ * @brief The index of the first element of the segment.
+ */
+template<class T>
+std::size_t concurrent_vector<T>::segment_base(std::size_t segment)
+{
+    return (CONCURRENT_VECTOR_FIRST_SEGMENT << segment) - CONCURRENT_VECTOR_FIRST_SEGMENT;
+}
+
+/**
+ * @brief The number of elements of the segment.
+ */
+template<class T>
+std::size_t concurrent_vector<T>::segment_size(std::size_t segment)
+{
+    return CONCURRENT_VECTOR_FIRST_SEGMENT << segment;
+}
+
+/**
+ * @brief The ready flags of the segment, they follow its elements in the same block.
+ */
+template<class T>
+typename concurrent_vector<T>::ready_flag* concurrent_vector<T>::flags(T* segment, std::size_t segment_index)
+{
+    return reinterpret_cast<ready_flag*>(segment + segment_size(segment_index));
+}
+
+/**
+ * @brief The segment, allocated if missing. All the threads claiming the slots of
+ *        the missing segment allocate it, the first installed copy wins.
+ */
+template<class T>
+T* concurrent_vector<T>::segment_for(std::size_t segment)
+{
+    T* current = m_segments[segment].load(std::memory_order_acquire);
+    if(current != nullptr){
+        return current;
+    }
+    const std::size_t n = segment_size(segment);
+    T* fresh = static_cast<T*>(::operator new(n*sizeof(T) + n*sizeof(ready_flag)));
+    ready_flag* ready = flags(fresh, segment);
+    for(std::size_t i=0; i<n; ++i)
+    {
+        ::new(static_cast<void*>(ready+i)) ready_flag(0);
+    }
+    if(m_segments[segment].compare_exchange_strong(current, fresh, std::memory_order_acq_rel, std::memory_order_acquire)){
+        return fresh;
+    }
+    ::operator delete(fresh);
+    return current;
+}
+
+/**
+ * @brief The storage of the claimed slot, the segment is allocated if missing.
+ */
+template<class T>
+T* concurrent_vector<T>::slot(std::size_t index)
+{
+    const std::size_t segment = segment_of(index);
+    return segment_for(segment) + (index - segment_base(segment));
+}
+
+/**
+ * @brief Marks the constructed element as visible for the readers.
+ */
+template<class T>
+void concurrent_vector<T>::publish(std::size_t index)
+{
+    const std::size_t segment = segment_of(index);
+    T* data = m_segments[segment].load(std::memory_order_relaxed);
+    flags(data, segment)[index - segment_base(segment)].store(1, std::memory_order_release);
+}
+
+/**
+ * @brief Destroys the published elements and frees the segments, not thread safe.
+ */
+template<class T>
+void concurrent_vector<T>::destroy_all()
+{
+    for(std::size_t k=0; k<CONCURRENT_VECTOR_MAX_SEGMENTS; ++k)
+    {
+        T* data = m_segments[k].load(std::memory_order_relaxed);
+        if(data == nullptr){
+            continue;
+        }
+        ready_flag* ready = flags(data, k);
+        for(std::size_t i=0; i<segment_size(k); ++i)
+        {
+            if(ready[i].load(std::memory_order_relaxed)){
+                data[i].~T();
+            }
+        }
+        ::operator delete(data);
+        m_segments[k].store(nullptr, std::memory_order_relaxed);
+    }
+    m_size.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief The number of the claimed slots, the published elements and the ones under construction.
+ */
+template<class T>
+std::size_t concurrent_vector<T>::size() const
+{
+    return m_size.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Checks whether no slot is claimed.
+ */
+template<class T>
+bool concurrent_vector<T>::empty() const
+{
+    return size() == 0;
+}
+
+/**
+ * @brief Checks whether the element at index is constructed and visible to this thread.
+ */
+template<class T>
+bool concurrent_vector<T>::is_published(std::size_t index) const
+{
+    if(index >= size()){
+        return false;
+    }
+    const std::size_t segment = segment_of(index);
+    T* data = m_segments[segment].load(std::memory_order_acquire);
+    return data != nullptr && flags(data, segment)[index - segment_base(segment)].load(std::memory_order_acquire) != 0;
+}
+
+/**
+ * @brief The published element at index, wait-free.
+ *        The index must come from push_back/grow_by of this thread or is_published().
+ */
+template<class T>
+T& concurrent_vector<T>::operator[](std::size_t index)
+{
+    assert((index < size()) && "Concurrent vector error: index out of range");
+    const std::size_t segment = segment_of(index);
+    return m_segments[segment].load(std::memory_order_acquire)[index - segment_base(segment)];
+}
+
+/**
+ * @brief The const published element at index, wait-free.
+ */
+template<class T>
+const T& concurrent_vector<T>::operator[](std::size_t index) const
+{
+    assert((index < size()) && "Concurrent vector error: index out of range");
+    const std::size_t segment = segment_of(index);
+    return m_segments[segment].load(std::memory_order_acquire)[index - segment_base(segment)];
+}
+
+/**
+ * @brief The element at index with the publication checking.
+ * @throw std::out_of_range if the element is not published.
+ */
+template<class T>
+const T& concurrent_vector<T>::at(std::size_t index) const
+{
+    if(!is_published(index)){
+        throw std::out_of_range("Concurrent vector error: the element is not published");
+    }
+    return (*this)[index];
+}
+
+/**
+ * @brief Appends the copy of value.
+ * @return The index of the element.
+ */
+template<class T>
+std::size_t concurrent_vector<T>::push_back(const T& value)
+{
+    return emplace_back(value);
+}
+
+/**
+ * @brief Appends the value by moving.
+ * @return The index of the element.
+ */
+template<class T>
+std::size_t concurrent_vector<T>::push_back(T&& value)
+{
+    return emplace_back(std::move(value));
+}
+
+/**
+ * @brief Appends the element constructed from args, lock-free.
+ * @return The index of the element.
+ */
+template<class T>
+template<class... Args>
+std::size_t concurrent_vector<T>::emplace_back(Args&&... args)
+{
+    const std::size_t index = m_size.fetch_add(1, std::memory_order_acq_rel);
+    ::new(static_cast<void*>(slot(index))) T(std::forward<Args>(args)...);
+    publish(index);
+    return index;
+}
+
+/**
+ * @brief Appends n copies of value with one fetch_add, lock-free.
+ * @return The index of the first element.
+ */
+template<class T>
+std::size_t concurrent_vector<T>::grow_by(std::size_t n, const T& value)
+{
+    const std::size_t first = m_size.fetch_add(n, std::memory_order_acq_rel);
+    for(std::size_t index=first; index<first+n; ++index)
+    {
+        ::new(static_cast<void*>(slot(index))) T(value);
+        publish(index);
+    }
+    return first;
+}
+
+/**
+ * @brief Destroys all the elements and frees the segments, not thread safe.
+ */
+template<class T>
+void concurrent_vector<T>::clear()
+{
+    destroy_all();
+}
+
+}
+
+#endif //CONCURRENT_VECTOR_H
@@ -0,0 +1,185 @@
+#ifndef CONCURRENT_VECTOR_TESTS_H
+#define CONCURRENT_VECTOR_TESTS_H
+
+#include <iostream>
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+#include "vector.h"
+#include "concurrent_vector.h"
+#include "test_timer.h"
+
+namespace concurrent_vector_testing {
+const std::size_t num_of_elements = 100000;
+const std::size_t producers = 4;
+const std::size_t bench_elements = 4000000;
+const std::size_t max_threads = 8;
+
+using scl_testing::get_wall_time_sec;
+
+/**
+ * @brief get_new_time calculating the total time and setting the current time in seconds
+ * @param sum_time - summary time
+ * @param last_time - last time value
+ */
+void get_new_time(double &sum_time, double &last_time)
+{
+    sum_time += get_wall_time_sec() - last_time;
+    last_time = get_wall_time_sec();
+}
+
+TEST(CheckConcurrentVector, PushBackAndStableAddresses)
+{
+    //Arrange
+    scl::concurrent_vector<std::string> cvec;
+    //Act
+    std::size_t first = cvec.push_back("first");
+    const std::string* address = &cvec[first];
+    for(std::size_t i=1; i<num_of_elements; ++i)
+    {
+        ASSERT_EQ(cvec.emplace_back(std::to_string(i)), i);
+    }
+    std::size_t grown = cvec.grow_by(10, "grown");
+    //Assert
+    ASSERT_EQ(first, 0U);
+    ASSERT_EQ(&cvec[0], address);
+    ASSERT_EQ(cvec[0], "first");
+    ASSERT_EQ(grown, num_of_elements);
+    ASSERT_EQ(cvec.size(), num_of_elements + 10);
+    for(std::size_t i=1; i<num_of_elements; ++i)
+    {
+        ASSERT_EQ(cvec[i], std::to_string(i));
+    }
+    ASSERT_EQ(cvec[num_of_elements + 9], "grown");
+    ASSERT_TRUE(cvec.is_published(num_of_elements + 9));
+    ASSERT_FALSE(cvec.is_published(num_of_elements + 10));
+    ASSERT_THROW(cvec.at(num_of_elements + 10), std::out_of_range);
+    scl::concurrent_vector<std::string> moved(std::move(cvec));
+    ASSERT_TRUE(cvec.empty());
+    ASSERT_EQ(&moved[0], address);
+    moved.clear();
+    ASSERT_TRUE(moved.empty());
+}
+
+TEST(CheckConcurrentVector, ConcurrentProducersAndReaders)
+{
+    //Arrange
+    scl::concurrent_vector<std::uint64_t> cvec;
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> bad_reads{0};
+    //Act
+    std::thread reader([&]
+    {
+        while(!done.load())
+        {
+            const std::size_t size = cvec.size();
+            for(std::size_t i=0; i<size; i+=97)
+            {
+                if(cvec.is_published(i) && cvec[i] >= producers*num_of_elements){
+                    ++bad_reads;
+                }
+            }
+        }
+    });
+    std::vector<std::thread> threads;
+    for(std::size_t p=0; p<producers; ++p)
+    {
+        threads.emplace_back([&cvec, p]
+        {
+            for(std::size_t i=0; i<num_of_elements; ++i)
+            {
+                if(i % 100 == 0){
+                    cvec.grow_by(1, p*num_of_elements + i);
+                }
+                else{
+                    cvec.push_back(p*num_of_elements + i);
+                }
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    done = true;
+    reader.join();
+    //Assert
+    ASSERT_EQ(cvec.size(), producers*num_of_elements);
+    std::vector<std::uint64_t> values;
+    for(std::size_t i=0; i<cvec.size(); ++i)
+    {
+        ASSERT_TRUE(cvec.is_published(i));
+        values.push_back(cvec[i]);
+    }
+    std::sort(values.begin(), values.end());
+    for(std::size_t i=0; i<values.size(); ++i)
+    {
+        ASSERT_EQ(values[i], i);
+    }
+    ASSERT_EQ(bad_reads.load(), 0U);
+}
+
+TEST(CompareConcurrentVector, MultiProducerThroughput)
+{
+    for(std::size_t threads=1; threads<=max_threads; threads*=2)
+    {
+        const std::size_t per_thread = bench_elements / threads;
+        double concurrent_time = 0, locked_time = 0, last_time = get_wall_time_sec();
+        {
+            scl::concurrent_vector<std::uint64_t> cvec;
+            std::vector<std::thread> workers;
+            for(std::size_t t=0; t<threads; ++t)
+            {
+                workers.emplace_back([&cvec, per_thread]
+                {
+                    for(std::size_t i=0; i<per_thread; ++i)
+                    {
+                        cvec.push_back(i);
+                    }
+                });
+            }
+            for(std::thread& worker : workers)
+            {
+                worker.join();
+            }
+            get_new_time(concurrent_time, last_time);
+            ASSERT_EQ(cvec.size(), per_thread*threads);
+        }
+        {
+            last_time = get_wall_time_sec();
+            scl::vector<std::uint64_t> vec;
+            std::mutex vec_mutex;
+            std::vector<std::thread> workers;
+            for(std::size_t t=0; t<threads; ++t)
+            {
+                workers.emplace_back([&vec, &vec_mutex, per_thread]
+                {
+                    for(std::size_t i=0; i<per_thread; ++i)
+                    {
+                        std::lock_guard<std::mutex> lock(vec_mutex);
+                        vec.push_back(i);
+                    }
+                });
+            }
+            for(std::thread& worker : workers)
+            {
+                worker.join();
+            }
+            get_new_time(locked_time, last_time);
+            ASSERT_EQ(vec.size(), per_thread*threads);
+        }
+        std::cout << "push_back " << per_thread*threads << ", producers " << threads << ": concurrent_vector "
+                  << concurrent_time << " s, mutex + vector " << locked_time << " s\n";
+    }
+}
+
+}
+
+#endif //CONCURRENT_VECTOR_TESTS_H
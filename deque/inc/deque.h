@@ -1,30 +1,88 @@
 #ifndef DEQUE_H
 #define DEQUE_H
 #include <cstdint>
+#include <cstdlib>
 #include <string>
+#include <memory>
+#include <iterator>
+#include <utility>
+#include <algorithm>
 //#include <new>
 //#include <cstddef>
 #include <cassert>
 
+#ifdef SCL_INSTRUMENT
+#include "instrument.h"
+#else
+#define SCL_INSTRUMENT_EVENT(event) ((void)0)
+#endif
+
 // see https://www.cs.fsu.edu/~lacher/courses/COP5517/lectures/deques/script.html
 /**
- * @brief DEFAULT_BUFFER_SIZE
+ * @brief DEFAULT_BUFFER_SIZE - the bytes of one block of elements
+ * @brief DEQUE_INITIAL_MAP_SIZE - the block pointers of the map of the empty deque, the power of two
  */
 constexpr std::size_t DEFAULT_BUFFER_SIZE = 256U;
+constexpr std::size_t DEQUE_INITIAL_MAP_SIZE = 8U;
+static_assert((DEQUE_INITIAL_MAP_SIZE & (DEQUE_INITIAL_MAP_SIZE - 1)) == 0, "Deque error: the map size must be a power of two");
 
 // Sequence containers library)
 namespace scl {
 
 /**
- * @brief chunk_size
- * @param chunk_size
- * @return
+ * @brief The smallest power of two not less than n
+ */
+constexpr std::size_t s_ceil_pow2(std::size_t n, std::size_t power = 1)
+{
+    return power >= n ? power : s_ceil_pow2(n, power*2);
+}
+
+/**
+ * @brief log2 of the power of two n
  */
-inline std::size_t s_buff_size(std::size_t b_size)
+constexpr std::size_t s_log2(std::size_t n)
 {
-    return (b_size < DEFAULT_BUFFER_SIZE) ? std::size_t(DEFAULT_BUFFER_SIZE/b_size) : std::size_t(1);
+    return n < 2 ? std::size_t(0) : 1 + s_log2(n/2);
 }
 
+/**
+ * @brief The number of the elements of one block, the power of two,
+ *        so the position is split into the block and the offset by the shift and the mask
+ * @param b_size - the size of the element
+ * @return DEFAULT_BUFFER_SIZE / b_size rounded up to the power of two, one element for the large types
+ */
+constexpr std::size_t s_buff_size(std::size_t b_size)
+{
+    return (b_size < DEFAULT_BUFFER_SIZE) ? s_ceil_pow2(DEFAULT_BUFFER_SIZE/b_size) : std::size_t(1);
+}
+
+/**
+ * Shrink policies of the deque
+ * @brief The emptied edge block is kept as the spare block for the next push or released.
+ *        max_spare(in_use) returns the number of the spare blocks kept while in_use blocks
+ *        hold the elements, the spare blocks over it are released.
+ */
+struct shrink_never
+{
+    static std::size_t max_spare(std::size_t /*in_use*/){return ~std::size_t(0);}
+};
+
+/**
+ * @brief The hysteresis: the spare blocks are kept up to the blocks in use, at least MinSpare,
+ *        the memory is released below the half occupancy of the blocks only,
+ *        so the push/pop oscillating around the block boundary allocates nothing.
+ */
+template<std::size_t MinSpare = 1>
+struct shrink_lazy
+{
+    static std::size_t max_spare(std::size_t in_use){return in_use > MinSpare ? in_use : MinSpare;}
+};
+
+struct shrink_eager
+{
+    static std::size_t max_spare(std::size_t /*in_use*/){return 0;}
+};
+
 /**
  * See
  * https://stackoverflow.com/questions/6292332
@@ -33,62 +91,65 @@ inline std::size_t s_buff_size(std::size_t b_size)
 /**
  * @brief
  */
-template<class T> class deque;
+template<class T, class Allocator = std::allocator<T>, class ShrinkPolicy = shrink_lazy<>> class deque;
 
-template<class T>
+/**
+ * @brief The random access iterator of the deque, the index of the element,
+ *        so it stays valid on push_back as the references do.
+ */
+template<class T, class Allocator = std::allocator<T>, class ShrinkPolicy = shrink_lazy<>>
 class deque_iterator{
-    friend class deque<T>;
-    const deque<T>* m_deq_ptr;
+    friend class deque<T, Allocator, ShrinkPolicy>;
+    deque<T, Allocator, ShrinkPolicy>* m_deq_ptr;
     std::size_t m_indx_base;
-    bool get_local(std::size_t val)
-    {
-        if(m_deq_ptr->m_begin <= m_deq_ptr->m_end)
-        {
-            return ((m_deq_ptr->m_begin <= val) && (val <= m_deq_ptr->m_end));
-        }
-        else
-        {
-            return (((m_deq_ptr->m_begin <= val) && (val < m_deq_ptr->m_size)) || val <= m_deq_ptr->m_end);
-        }
-    }
 
 public:
+    using iterator_category = std::random_access_iterator_tag;
     using value_type = T;
-    using iterator = deque_iterator<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = deque_iterator<T, Allocator, ShrinkPolicy>;
 
     deque_iterator();
-    deque_iterator(const deque<T> *d_other, std::size_t index);
+    deque_iterator(deque<T, Allocator, ShrinkPolicy> *d_other, std::size_t index);
     deque_iterator(const iterator& i_other);
     iterator& operator=(const iterator& i_other);
 
     bool operator==(const iterator& i_other) const;
     bool operator!=(const iterator& i_other) const;
+    bool operator<(const iterator& i_other) const;
     T& operator*() const;
-    T& operator[](std::size_t indx);
+    T* operator->() const;
+    T& operator[](difference_type indx) const;
     iterator& operator++();
-    iterator& operator++(int junk);
+    iterator operator++(int junk);
     iterator& operator--();
-    iterator& operator--(int junk);
-
+    iterator operator--(int junk);
+    iterator& operator+=(difference_type n);
+    iterator& operator-=(difference_type n);
+    iterator operator+(difference_type n) const;
+    iterator operator-(difference_type n) const;
+    difference_type operator-(const iterator& i_other) const;
 };
 
-template<class T>
-deque_iterator<T>::deque_iterator()
+template<class T, class Allocator, class ShrinkPolicy>
+deque_iterator<T, Allocator, ShrinkPolicy>::deque_iterator()
     :m_deq_ptr(nullptr)
     ,m_indx_base(0){}
 
-template<class T>
-deque_iterator<T>::deque_iterator(const deque<T>* d_other, std::size_t index)
+template<class T, class Allocator, class ShrinkPolicy>
+deque_iterator<T, Allocator, ShrinkPolicy>::deque_iterator(deque<T, Allocator, ShrinkPolicy>* d_other, std::size_t index)
     :m_deq_ptr(d_other)
     ,m_indx_base(index){}
 
-template<class T>
-deque_iterator<T>::deque_iterator(const typename deque_iterator<T>::iterator& i_other)
+template<class T, class Allocator, class ShrinkPolicy>
+deque_iterator<T, Allocator, ShrinkPolicy>::deque_iterator(const typename deque_iterator<T, Allocator, ShrinkPolicy>::iterator& i_other)
     :m_deq_ptr(i_other.m_deq_ptr)
     ,m_indx_base(i_other.m_indx_base){}
 
-template<class T>
-typename deque_iterator<T>::iterator& deque_iterator<T>::operator=(const typename deque_iterator<T>::iterator& i_other)
+template<class T, class Allocator, class ShrinkPolicy>
+typename deque_iterator<T, Allocator, ShrinkPolicy>::iterator& deque_iterator<T, Allocator, ShrinkPolicy>::operator=(const typename deque_iterator<T, Allocator, ShrinkPolicy>::iterator& i_other)
 {
     if(this != &i_other)
     {
@@ -98,8 +159,8 @@ typename deque_iterator<T>::iterator& deque_iterator<T>::operator=(const typenam
     return *this;
 }
 
-template<class T>
-bool deque_iterator<T>::operator==(const iterator& i_other) const
+template<class T, class Allocator, class ShrinkPolicy>
+bool deque_iterator<T, Allocator, ShrinkPolicy>::operator==(const iterator& i_other) const
 {
     if((m_deq_ptr != i_other.m_deq_ptr)||(m_indx_base != i_other.m_indx_base))
     {
@@ -108,89 +169,177 @@ bool deque_iterator<T>::operator==(const iterator& i_other) const
     return true;
 }
 
-template<class T>
-bool deque_iterator<T>::operator!=(const iterator& i_other) const
+template<class T, class Allocator, class ShrinkPolicy>
+bool deque_iterator<T, Allocator, ShrinkPolicy>::operator!=(const iterator& i_other) const
 {
     return !(*this == i_other);
 }
 
-template<class T>
-T& deque_iterator<T>::operator*() const
+template<class T, class Allocator, class ShrinkPolicy>
+bool deque_iterator<T, Allocator, ShrinkPolicy>::operator<(const iterator& i_other) const
+{
+    return m_indx_base < i_other.m_indx_base;
+}
+
+template<class T, class Allocator, class ShrinkPolicy>
+T& deque_iterator<T, Allocator, ShrinkPolicy>::operator*() const
 {
-    assert((m_deq_ptr == nullptr) && "m_deq_ptr - novalid pointer");
-    assert(get_local(m_indx_base) && m_indx_base != m_deq_ptr->m_end);
-    return *(m_deq_ptr->m_buffer + m_indx_base);
+    assert((m_deq_ptr != nullptr) && "m_deq_ptr - novalid pointer");
+    return (*m_deq_ptr)[m_indx_base];
 }
 
-template<class T>
-T& deque_iterator<T>::operator[](std::size_t indx)
+template<class T, class Allocator, class ShrinkPolicy>
+T* deque_iterator<T, Allocator, ShrinkPolicy>::operator->() const
 {
-    assert((m_deq_ptr == nullptr) && "m_deq_ptr - novalid pointer");
-    assert(get_local(m_indx_base) && m_indx_base != m_deq_ptr->m_end);
-    return m_deq_ptr->operator[](m_indx_base + indx);
+    return &**this;
 }
 
-template<class T>
-typename  deque_iterator<T>::iterator& deque_iterator<T>::operator++()
+template<class T, class Allocator, class ShrinkPolicy>
+T& deque_iterator<T, Allocator, ShrinkPolicy>::operator[](difference_type indx) const
+{
+    assert((m_deq_ptr != nullptr) && "m_deq_ptr - novalid pointer");
+    return (*m_deq_ptr)[m_indx_base + indx];
+}
+
+template<class T, class Allocator, class ShrinkPolicy>
+typename  deque_iterator<T, Allocator, ShrinkPolicy>::iterator& deque_iterator<T, Allocator, ShrinkPolicy>::operator++()
 {
     ++m_indx_base;
     return *this;
 }
 
-template<class T>
-typename  deque_iterator<T>::iterator& deque_iterator<T>::operator++(int junk)
+template<class T, class Allocator, class ShrinkPolicy>
+typename  deque_iterator<T, Allocator, ShrinkPolicy>::iterator deque_iterator<T, Allocator, ShrinkPolicy>::operator++(int)
 {
     iterator itr(*this);
     operator++();
     return itr;
 }
 
-template<class T>
-typename  deque_iterator<T>::iterator& deque_iterator<T>::operator--()
+template<class T, class Allocator, class ShrinkPolicy>
+typename  deque_iterator<T, Allocator, ShrinkPolicy>::iterator& deque_iterator<T, Allocator, ShrinkPolicy>::operator--()
 {
     --m_indx_base;
     return *this;
 }
 
-template<class T>
-typename  deque_iterator<T>::iterator& deque_iterator<T>::operator--(int junk)
+template<class T, class Allocator, class ShrinkPolicy>
+typename  deque_iterator<T, Allocator, ShrinkPolicy>::iterator deque_iterator<T, Allocator, ShrinkPolicy>::operator--(int)
 {
     iterator itr(*this);
     operator--();
     return itr;
 }
 
+template<class T, class Allocator, class ShrinkPolicy>
+typename deque_iterator<T, Allocator, ShrinkPolicy>::iterator& deque_iterator<T, Allocator, ShrinkPolicy>::operator+=(difference_type n)
+{
+    m_indx_base += n;
+    return *this;
+}
+
+template<class T, class Allocator, class ShrinkPolicy>
+typename deque_iterator<T, Allocator, ShrinkPolicy>::iterator& deque_iterator<T, Allocator, ShrinkPolicy>::operator-=(difference_type n)
+{
+    m_indx_base -= n;
+    return *this;
+}
+
+template<class T, class Allocator, class ShrinkPolicy>
+typename deque_iterator<T, Allocator, ShrinkPolicy>::iterator deque_iterator<T, Allocator, ShrinkPolicy>::operator+(difference_type n) const
+{
+    iterator itr(*this);
+    return itr += n;
+}
+
+template<class T, class Allocator, class ShrinkPolicy>
+typename deque_iterator<T, Allocator, ShrinkPolicy>::iterator deque_iterator<T, Allocator, ShrinkPolicy>::operator-(difference_type n) const
+{
+    iterator itr(*this);
+    return itr -= n;
+}
+
+template<class T, class Allocator, class ShrinkPolicy>
+typename deque_iterator<T, Allocator, ShrinkPolicy>::difference_type deque_iterator<T, Allocator, ShrinkPolicy>::operator-(const iterator& i_other) const
+{
+    return static_cast<difference_type>(m_indx_base) - static_cast<difference_type>(i_other.m_indx_base);
+}
+
 /**
- * @brief Basic implementation the double-ended queue using circular array
+ * @brief The double-ended queue of the fixed-size blocks
+ *        The elements are stored in the blocks of buffer_size() elements, the power of two,
+ *        the map is the ring of the pointers to the blocks, its size is the power of two too.
+ *        [m_begin, m_end) are the monotonic counters of the positions: push_back and pop_front
+ *        increment them, push_front and pop_back decrement them, wrapping around zero.
+ *        The element at the position pos is at the offset pos & buffer_mask()
+ *        of the block pos >> buffer_shift(), which is in the map slot block & (m_map_size - 1),
+ *        so no operation divides and size() is m_end - m_begin.
+ *        push_front/push_back add a block when the edge block is full, pop_front/pop_back
+ *        keep the emptied edge block as the spare one, the spare blocks follow the blocks
+ *        in use in the ring, so taking or keeping one moves at most one pointer.
+ *        ShrinkPolicy limits the number of the spare blocks, reserve() and shrink_to_fit()
+ *        set the capacity explicitly.
+ *        When all the map slots are taken only the block pointers are copied to the map
+ *        of the double size, so the elements are never relocated and the references
+ *        and pointers to them stay valid on push_front/push_back, every push is O(1) worst case
+ *        except the reallocation of the map of size()/buffer_size() pointers.
  */
-template<class T>
+template<class T, class Allocator, class ShrinkPolicy>
 class deque{
 
-    void copy(std::size_t new_size);
-    void check_realloc();
-    void add_length();
-    void sub_length();
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using map_allocator = typename alloc_traits::template rebind_alloc<T*>;
+    using map_traits = std::allocator_traits<map_allocator>;
+
+    static constexpr std::size_t buffer_shift(){return s_log2(buffer_size());}
+    static constexpr std::size_t buffer_mask(){return buffer_size() - 1;}
+
+    T* allocate_block();
+    void deallocate_block(std::size_t block);
+    T** allocate_map(std::size_t n);
+    void deallocate_map();
+    T*& slot(std::size_t block) const;
+    T* element(std::size_t pos) const;
+    std::size_t blocks_in_use() const;
+    std::size_t spare_limit() const;
+    void attach_back();
+    void attach_front();
+    void detach_back();
+    void detach_front();
+    void release_spares(std::size_t keep);
+    void destroy_all();
+    void copy_from(const deque<T, Allocator, ShrinkPolicy>& other);
+    deque(const deque<T, Allocator, ShrinkPolicy>& other, const Allocator& alloc);
+    void remap(std::size_t new_map_size);
 
 public:
     //friend class deque_iterator<T>;
     //using value_type = T;
-    using iterator = deque_iterator<T>;
+    using allocator_type = Allocator;
+    using iterator = deque_iterator<T, Allocator, ShrinkPolicy>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
 
-    std::size_t buffer_size(){return s_buff_size(sizeof(T));}
+    static constexpr std::size_t buffer_size(){return s_buff_size(sizeof(T));}
 
     deque();
+    explicit deque(const Allocator& alloc);
     deque(std::size_t size, const T& val);
-    deque(const deque<T>& other);
+    deque(const deque<T, Allocator, ShrinkPolicy>& other);
 
     ~deque();
 
-    deque<T>& operator=(const deque<T>& other);
+    deque<T, Allocator, ShrinkPolicy>& operator=(const deque<T, Allocator, ShrinkPolicy>& other);
+
+    Allocator get_allocator() const;
 
     T& operator[](std::size_t val);
     const T& operator[](std::size_t val) const;
 
     bool empty() const noexcept;
     std::size_t size() const noexcept;
+    std::size_t capacity() const noexcept;
+    void reserve(std::size_t n);
+    void shrink_to_fit();
     void push_front(const T& val);
     void pop_front();
     void push_back(const T& val);
@@ -203,61 +352,276 @@ public:
 
     iterator begin();
     iterator end();
-    iterator rbegin();
-    iterator rend();
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+
+#ifdef SCL_INSTRUMENT
+    container_stats stats() const;
+    static container_stats total_stats();
+#endif
 
 private:
-    T* m_buffer;
-    std::size_t m_size;
+    Allocator m_alloc;
+    T** m_map;
+    std::size_t m_map_size;
     std::size_t m_begin;
     std::size_t m_end;
+    std::size_t m_spare;
+    std::size_t m_reserved_blocks;
+#ifdef SCL_INSTRUMENT
+    instrument<deque<T, Allocator, ShrinkPolicy>> m_stats;
+#endif
 };
 
-template<class T>
-void deque<T>::copy(std::size_t new_size)
+/**
+ * @brief Allocates one block of buffer_size() elements.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+T* deque<T, Allocator, ShrinkPolicy>::allocate_block()
 {
-    std::size_t prev_size = size();
-    T* new_m_buffer = new (std::nothrow) T[new_size];
-    if(new_m_buffer != NULL){
-        for(std::size_t i = 0, p = m_begin; i < size(), p != m_end; p = (p+1) % m_size)
-        {
-            new_m_buffer[i] = m_buffer[p];
-        }
-        delete[] m_buffer;
-        m_buffer = new_m_buffer;
-        m_begin = 0;
-        m_end = (new_size == m_size*2) ? (m_size-1) : prev_size;
+    T* ptr = alloc_traits::allocate(m_alloc, buffer_size());
+    assert(ptr && "Deque error: unable to allocate memory");
+    SCL_INSTRUMENT_EVENT(on_allocate(buffer_size()*sizeof(T)));
+    return ptr;
+}
+
+/**
+ * @brief Releases the block.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::deallocate_block(std::size_t block)
+{
+    alloc_traits::deallocate(m_alloc, slot(block), buffer_size());
+}
+
+/**
+ * @brief Allocates the map of n slots, only the slots of the blocks in use are ever read.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+T** deque<T, Allocator, ShrinkPolicy>::allocate_map(std::size_t n)
+{
+    map_allocator alloc(m_alloc);
+    T** map = map_traits::allocate(alloc, n);
+    assert(map && "Deque error: unable to allocate memory");
+    return map;
+}
+
+/**
+ * @brief Releases the map, the blocks must be released before.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::deallocate_map()
+{
+    if(m_map != nullptr){
+        map_allocator alloc(m_alloc);
+        map_traits::deallocate(alloc, m_map, m_map_size);
+        m_map = nullptr;
+    }
+}
+
+/**
+ * @brief The map slot of the block, the map is the ring.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+T*& deque<T, Allocator, ShrinkPolicy>::slot(std::size_t block) const
+{
+    return m_map[block & (m_map_size - 1)];
+}
+
+/**
+ * @brief The storage of the position pos.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+T* deque<T, Allocator, ShrinkPolicy>::element(std::size_t pos) const
+{
+    return slot(pos >> buffer_shift()) + (pos & buffer_mask());
+}
+
+/**
+ * @brief The number of the allocated blocks, the blocks overlapped by [m_begin, m_end).
+ *        The block numbers wrap around with the positions, hence the mask.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+std::size_t deque<T, Allocator, ShrinkPolicy>::blocks_in_use() const
+{
+    if(m_begin == m_end){
+        return 0;
+    }
+    return ((((m_end - 1) >> buffer_shift()) - (m_begin >> buffer_shift())) & (~std::size_t(0) >> buffer_shift())) + 1;
+}
+
+/**
+ * @brief The number of the spare blocks to keep, by ShrinkPolicy and not less than reserve() needs.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+std::size_t deque<T, Allocator, ShrinkPolicy>::spare_limit() const
+{
+    const std::size_t used = blocks_in_use();
+    const std::size_t reserved = m_reserved_blocks > used ? m_reserved_blocks - used : 0;
+    return std::max(ShrinkPolicy::max_spare(used), reserved);
+}
+
+/**
+ * @brief Attaches the block after the last block in use, m_end is at the block boundary.
+ *        The first spare block is already in the slot.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::attach_back()
+{
+    if(m_spare > 0){
+        --m_spare;
+        return;
+    }
+    if(blocks_in_use() == m_map_size){
+        remap(m_map_size*2);
+    }
+    slot(m_end >> buffer_shift()) = allocate_block();
+}
+
+/**
+ * @brief Attaches the block before the first block in use, m_begin is at the block boundary.
+ *        The last spare block is moved to the slot.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::attach_front()
+{
+    const std::size_t first = m_begin >> buffer_shift();
+    if(m_spare > 0){
+        --m_spare;
+        slot(first - 1) = slot(first + blocks_in_use() + m_spare);
+        return;
+    }
+    if(blocks_in_use() == m_map_size){
+        remap(m_map_size*2);
+    }
+    slot(first - 1) = allocate_block();
+}
+
+/**
+ * @brief The emptied last block becomes the first spare block, it is already in the slot.
+ *        The empty sequence is moved to the start of the block.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::detach_back()
+{
+    if(m_begin == m_end){
+        m_end = m_end >> buffer_shift() << buffer_shift();
+        m_begin = m_end;
     }
-    else{
-        assert(m_buffer && "Deque error: unable to allocate memory");
+    ++m_spare;
+    release_spares(spare_limit());
+}
+
+/**
+ * @brief The emptied first block is moved after the spare blocks.
+ *        The empty sequence is moved to the start of the next block.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::detach_front()
+{
+    const std::size_t block = (m_begin - 1) >> buffer_shift();
+    if(m_begin == m_end){
+        m_begin = (block + 1) << buffer_shift();
+        m_end = m_begin;
     }
+    slot(block + 1 + blocks_in_use() + m_spare) = slot(block);
+    ++m_spare;
+    release_spares(spare_limit());
 }
 
-template<class T>
-void deque<T>::check_realloc()
+/**
+ * @brief Releases the last spare blocks, keep ones stay.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::release_spares(std::size_t keep)
 {
-    if(size() == m_size - 1)
+    if(m_spare <= keep){
+        return;
+    }
+    const std::size_t top = (m_begin >> buffer_shift()) + blocks_in_use();
+    while(m_spare > keep)
     {
-        add_length();
+        --m_spare;
+        deallocate_block(top + m_spare);
     }
-    if((size()*4 == m_size) && m_size > 4)
+}
+
+/**
+ * @brief Destroys the elements, the blocks in use become the spare blocks in their slots.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::destroy_all()
+{
+    for(std::size_t pos = m_begin; pos != m_end; ++pos)
     {
-        sub_length();
+        alloc_traits::destroy(m_alloc, element(pos));
     }
+    m_spare += blocks_in_use();
+    m_begin = m_begin >> buffer_shift() << buffer_shift();
+    m_end = m_begin;
 }
 
-template<class T>
-void deque<T>::add_length()
+/**
+ * @brief Copies the elements of other into this empty deque with no map,
+ *        the layout of other is repeated.
+ *        If a block allocation or a copy throws, the copied elements are destroyed,
+ *        the blocks and the map are released and the deque is left with no map.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::copy_from(const deque<T, Allocator, ShrinkPolicy>& other)
 {
-    copy(m_size*2);
-    m_size *= 2;
+    m_map_size = other.m_map_size;
+    m_map = allocate_map(m_map_size);
+    m_begin = other.m_begin;
+    m_end = other.m_begin;
+    m_spare = 0;
+    m_reserved_blocks = 0;
+    const std::size_t first = other.m_begin >> buffer_shift();
+    std::size_t block = first;
+    try{
+        for(; block != first + other.blocks_in_use(); ++block)
+        {
+            slot(block) = allocate_block();
+        }
+        SCL_INSTRUMENT_EVENT(on_copy(other.size()*sizeof(T)));
+        for(; m_end != other.m_end; ++m_end)
+        {
+            alloc_traits::construct(m_alloc, element(m_end), *other.element(m_end));
+        }
+    }
+    catch(...){
+        for(std::size_t pos = m_begin; pos != m_end; ++pos)
+        {
+            alloc_traits::destroy(m_alloc, element(pos));
+        }
+        while(block != first)
+        {
+            deallocate_block(--block);
+        }
+        deallocate_map();
+        throw;
+    }
 }
 
-template<class T>
-void deque<T>::sub_length()
+/**
+ * @brief Moves the blocks in use and the spare blocks to the map of new_map_size slots,
+ *        the power of two, e.g. the double one when all the slots are taken.
+ *        The block pointers are copied to their slots of the new ring,
+ *        the positions and the elements stay in place.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::remap(std::size_t new_map_size)
 {
-    copy(m_size/2);
-    m_size /= 2;
+    T** new_map = allocate_map(new_map_size);
+    const std::size_t first = m_begin >> buffer_shift();
+    const std::size_t blocks = blocks_in_use() + m_spare;
+    for(std::size_t block = first; block != first + blocks; ++block)
+    {
+        new_map[block & (new_map_size - 1)] = slot(block);
+    }
+    deallocate_map();
+    m_map = new_map;
+    m_map_size = new_map_size;
 }
 
 /**
@@ -266,8 +630,8 @@ void deque<T>::sub_length()
  * @param y The reference on to the second deque object
  * @return Bool value after checking deque size and checking every item individually
  */
-template<class T>
-bool operator==(const deque<T>& x, const deque<T> y)
+template<class T, class Allocator, class ShrinkPolicy>
+bool operator==(const deque<T, Allocator, ShrinkPolicy>& x, const deque<T, Allocator, ShrinkPolicy>& y)
 {
     if(x.size() != y.size()){
         return false;
@@ -287,234 +651,375 @@ bool operator==(const deque<T>& x, const deque<T> y)
  * @param x The reference on to the first deque object
  * @return Bool value using equality aperator
  */
-template<class T>
-bool operator!=(const deque<T>& x, const deque<T> y)
+template<class T, class Allocator, class ShrinkPolicy>
+bool operator!=(const deque<T, Allocator, ShrinkPolicy>& x, const deque<T, Allocator, ShrinkPolicy>& y)
 {
     return !(x == y);
 }
 
 /**
- * @brief Default constructor
+ * @brief Default constructor, only the map is allocated
  */
-template<class T>
-deque<T>::deque()
-    :m_buffer(nullptr)
+template<class T, class Allocator, class ShrinkPolicy>
+deque<T, Allocator, ShrinkPolicy>::deque()
+    :m_map(nullptr)
+    ,m_map_size(DEQUE_INITIAL_MAP_SIZE)
     ,m_begin(0)
     ,m_end(0)
+    ,m_spare(0)
+    ,m_reserved_blocks(0)
 {
+    m_map = allocate_map(m_map_size);
+}
 
-    m_buffer = new (std::nothrow) T[buffer_size()];
-    if(m_buffer != NULL){
-        m_size = buffer_size();
-    }
-    else{
-        assert(m_buffer && "Deque error: unable to allocate memory");
+/**
+ * @brief Constructor with the allocator instance
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+deque<T, Allocator, ShrinkPolicy>::deque(const Allocator& alloc)
+    :m_alloc(alloc)
+    ,m_map(nullptr)
+    ,m_map_size(DEQUE_INITIAL_MAP_SIZE)
+    ,m_begin(0)
+    ,m_end(0)
+    ,m_spare(0)
+    ,m_reserved_blocks(0)
+{
+    m_map = allocate_map(m_map_size);
+}
+
+/**
+ * @brief Constructor of size copies of val
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+deque<T, Allocator, ShrinkPolicy>::deque(std::size_t size, const T& val)
+    :deque()
+{
+    for(std::size_t i=0; i<size; ++i)
+    {
+        push_back(val);
     }
 }
 
 /**
  * @brief Destructor
  */
-template<class T>
-deque<T>::~deque()
+template<class T, class Allocator, class ShrinkPolicy>
+deque<T, Allocator, ShrinkPolicy>::~deque()
 {
-    delete [] m_buffer;
-    m_size = 0;
+    if(m_map == nullptr){
+        return;
+    }
+    SCL_INSTRUMENT_EVENT(on_release(capacity()*sizeof(T)-size()*sizeof(T)));
+    destroy_all();
+    release_spares(0);
+    deallocate_map();
 }
 
 /**
  * @brief Copy constructor
  */
-template<class T>
-deque<T>::deque(const deque<T>& other)
-    :m_size(other.m_size)
-    ,m_begin(other.m_begin)
-    ,m_end(other.m_end)
+template<class T, class Allocator, class ShrinkPolicy>
+deque<T, Allocator, ShrinkPolicy>::deque(const deque<T, Allocator, ShrinkPolicy>& other)
+    :m_alloc(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    ,m_map(nullptr)
 {
-    m_buffer = new (std::nothrow) T[buffer_size()];
-    if(m_buffer != NULL){
-        for(std::size_t i=0; i<m_size; ++i){
-            m_buffer[i] = other.m_buffer[i];
-        }
-    }
-    else{
-        assert(m_buffer && "Deque error: unable to allocate memory");
-    }
+    copy_from(other);
+}
+
+/**
+ * @brief Copy constructor with the allocator of the copy, used by the assignment
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+deque<T, Allocator, ShrinkPolicy>::deque(const deque<T, Allocator, ShrinkPolicy>& other, const Allocator& alloc)
+    :m_alloc(alloc)
+    ,m_map(nullptr)
+{
+    copy_from(other);
 }
 
 /**
  * @brief Assignment operator
+ *        The allocator is replaced if propagate_on_container_copy_assignment is set.
+ *        The copy is built before the old storage is released, so the deque
+ *        is unchanged if the copy throws.
  */
-template<class T>
-deque<T>& deque<T>::operator=(const deque<T>& other)
-{
-    if(this != other){
-        T* new_buffer = new (std::nothrow) T[other.m_size];
-        if(m_buffer != NULL){
-            delete [] m_buffer;
-            m_buffer = new_buffer;
-            m_size = other.m_size;
-            m_begin = other.m_begin;
-            m_end = other.m_end;
-
-            for(std::size_t i=0; i<m_size; ++i){
-                m_buffer[i] = other.m_buffer[i];
-            }
-        }
-        else{
-            assert(m_buffer && "Deque error: unable to allocate memory");
-        }
+template<class T, class Allocator, class ShrinkPolicy>
+deque<T, Allocator, ShrinkPolicy>& deque<T, Allocator, ShrinkPolicy>::operator=(const deque<T, Allocator, ShrinkPolicy>& other)
+{
+    if(this != &other){
+        deque<T, Allocator, ShrinkPolicy> copy(other,
+            alloc_traits::propagate_on_container_copy_assignment::value ? other.m_alloc : m_alloc);
+        std::swap(m_alloc, copy.m_alloc);
+        std::swap(m_map, copy.m_map);
+        std::swap(m_map_size, copy.m_map_size);
+        std::swap(m_begin, copy.m_begin);
+        std::swap(m_end, copy.m_end);
+        std::swap(m_spare, copy.m_spare);
+        std::swap(m_reserved_blocks, copy.m_reserved_blocks);
     }
     return *this;
 }
 
-template<class T>
-T& deque<T>::operator[](std::size_t val)
+/**
+ * @brief Returns the allocator associated with the container.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+Allocator deque<T, Allocator, ShrinkPolicy>::get_allocator() const
 {
-    assert(val>=size() && "Deque index value is out of range");
-    return *(m_buffer + (m_begin + val) % m_size);
+    return m_alloc;
 }
 
-template<class T>
-const T& deque<T>::operator[](std::size_t val) const
+#ifdef SCL_INSTRUMENT
+/**
+ * @brief The storage counters of the instance, see container_stats.
+ *        The allocations are the blocks, the elements are never moved.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+container_stats deque<T, Allocator, ShrinkPolicy>::stats() const
+{
+    return m_stats.stats(m_map != nullptr ? capacity()*sizeof(T)-size()*sizeof(T) : 0);
+}
+
+/**
+ * @brief The storage counters of all the deques of this type.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+container_stats deque<T, Allocator, ShrinkPolicy>::total_stats()
 {
-    assert(val>=size() && "Deque index value is out of range");
-    return *(m_buffer + (m_begin + val) % m_size);
+    return instrument<deque<T, Allocator, ShrinkPolicy>>::total();
 }
+#endif
 
-template<class T>
-bool deque<T>::empty() const noexcept
+template<class T, class Allocator, class ShrinkPolicy>
+T& deque<T, Allocator, ShrinkPolicy>::operator[](std::size_t val)
+{
+    assert(val<size() && "Deque index value is out of range");
+    return *element(m_begin + val);
+}
+
+template<class T, class Allocator, class ShrinkPolicy>
+const T& deque<T, Allocator, ShrinkPolicy>::operator[](std::size_t val) const
+{
+    assert(val<size() && "Deque index value is out of range");
+    return *element(m_begin + val);
+}
+
+template<class T, class Allocator, class ShrinkPolicy>
+bool deque<T, Allocator, ShrinkPolicy>::empty() const noexcept
 {
     return size() == 0 ? true : false;
 }
 
-template<class T>
-std::size_t deque<T>::size() const noexcept
+template<class T, class Allocator, class ShrinkPolicy>
+std::size_t deque<T, Allocator, ShrinkPolicy>::size() const noexcept
 {
-    return (m_end - m_begin + m_size) % m_size;
+    return m_end - m_begin;
+}
+
+/**
+ * @brief The number of the elements the blocks in use and the spare blocks hold.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+std::size_t deque<T, Allocator, ShrinkPolicy>::capacity() const noexcept
+{
+    return (blocks_in_use() + m_spare)*buffer_size();
+}
+
+/**
+ * @brief Allocates the spare blocks, so push_back allocates nothing until size() reaches n.
+ *        The blocks for n elements are kept whatever ShrinkPolicy says until shrink_to_fit().
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::reserve(std::size_t n)
+{
+    const std::size_t needed = ((m_begin & buffer_mask()) + n + buffer_mask()) >> buffer_shift();
+    m_reserved_blocks = std::max(m_reserved_blocks, needed);
+    std::size_t blocks = blocks_in_use() + m_spare;
+    if(needed <= blocks){
+        return;
+    }
+    std::size_t new_map_size = m_map_size;
+    while(new_map_size < needed)
+    {
+        new_map_size *= 2;
+    }
+    if(new_map_size != m_map_size){
+        remap(new_map_size);
+    }
+    const std::size_t top = (m_begin >> buffer_shift()) + blocks_in_use();
+    for(; blocks < needed; ++blocks)
+    {
+        slot(top + m_spare) = allocate_block();
+        ++m_spare;
+    }
 }
 
-template<class T>
-void deque<T>::push_front(const T& val)
+/**
+ * @brief Releases the spare blocks and drops the reservation,
+ *        the map is reduced to the blocks in use.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::shrink_to_fit()
 {
-    check_realloc();
-    m_begin = (m_begin - 1 + m_size) % m_size;
-    m_buffer[m_begin] = val;
+    m_reserved_blocks = 0;
+    release_spares(0);
+    std::size_t new_map_size = DEQUE_INITIAL_MAP_SIZE;
+    while(new_map_size < blocks_in_use())
+    {
+        new_map_size *= 2;
+    }
+    if(new_map_size < m_map_size){
+        remap(new_map_size);
+    }
 }
 
-template<class T>
-void deque<T>::pop_front()
+/**
+ * @brief Inserts the copy of val at the front, the block is attached if the first one is full.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::push_front(const T& val)
 {
-    assert((size() == 0) && "Deque error: pop_front() empty deque");
-    check_realloc();
-    m_begin = (m_begin + 1) % m_size;
+    const bool new_block = (m_begin & buffer_mask()) == 0;
+    if(new_block){
+        attach_front();
+    }
+    try{
+        alloc_traits::construct(m_alloc, element(m_begin - 1), val);
+    }
+    catch(...){
+        if(new_block){
+            const std::size_t first = m_begin >> buffer_shift();
+            slot(first + blocks_in_use() + m_spare) = slot(first - 1);
+            ++m_spare;
+        }
+        throw;
+    }
+    --m_begin;
 }
 
+/**
+ * @brief Removes the first element, the block is detached when it gets empty.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::pop_front()
+{
+    assert((size() != 0) && "Deque error: pop_front() empty deque");
+    alloc_traits::destroy(m_alloc, element(m_begin));
+    ++m_begin;
+    if((m_begin & buffer_mask()) == 0 || m_begin == m_end){
+        detach_front();
+    }
+}
 
-template<class T>
-void deque<T>::push_back(const T& val)
+/**
+ * @brief Inserts the copy of val at the back, the block is attached if the last one is full.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::push_back(const T& val)
 {
-    check_realloc();
-    m_buffer[m_end] = val;
-    m_end = (m_end + 1) % m_size;
+    const bool new_block = (m_end & buffer_mask()) == 0;
+    if(new_block){
+        attach_back();
+    }
+    try{
+        alloc_traits::construct(m_alloc, element(m_end), val);
+    }
+    catch(...){
+        if(new_block){
+            ++m_spare;
+        }
+        throw;
+    }
+    ++m_end;
 }
 
-template<class T>
-void deque<T>::pop_back()
+/**
+ * @brief Removes the last element, the block is detached when it gets empty.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::pop_back()
 {
-    assert((size() == 0) && "Deque error: pop_back() empty deque");
-    check_realloc();
-    m_end = (m_end - 1 + m_size) % m_size;
+    assert((size() != 0) && "Deque error: pop_back() empty deque");
+    --m_end;
+    alloc_traits::destroy(m_alloc, element(m_end));
+    if((m_end & buffer_mask()) == 0 || m_begin == m_end){
+        detach_back();
+    }
 }
 
-template<class T>
-void deque<T>::clear()
+/**
+ * @brief Destroys the elements, the blocks are kept as the spare ones as ShrinkPolicy says.
+ */
+template<class T, class Allocator, class ShrinkPolicy>
+void deque<T, Allocator, ShrinkPolicy>::clear()
 {
-    m_size = 0;
-    m_begin = 0;
-    m_end = 0;
+    destroy_all();
+    release_spares(spare_limit());
 }
 
-template<class T>
-T& deque<T>::front()
+template<class T, class Allocator, class ShrinkPolicy>
+T& deque<T, Allocator, ShrinkPolicy>::front()
 {
-    assert((m_begin == m_end) && "Deque error: front() called on empty deque");
+    assert((m_begin != m_end) && "Deque error: front() called on empty deque");
     if (size() == 0){
         exit (EXIT_FAILURE);
     }
-    return m_buffer[m_begin];
+    return *element(m_begin);
 }
 
-template<class T>
-const T& deque<T>::cfront() const
+template<class T, class Allocator, class ShrinkPolicy>
+const T& deque<T, Allocator, ShrinkPolicy>::cfront() const
 {
-    assert((m_begin == m_end) && "Deque error: cfront() called on empty deque");
+    assert((m_begin != m_end) && "Deque error: cfront() called on empty deque");
     if (size() == 0){
         exit (EXIT_FAILURE);
     }
-    return m_buffer[m_begin];
+    return *element(m_begin);
 }
 
-template<class T>
-T& deque<T>::back()
+template<class T, class Allocator, class ShrinkPolicy>
+T& deque<T, Allocator, ShrinkPolicy>::back()
 {
-    assert((m_begin == m_end) && "Deque error: back() called on empty deque");
+    assert((m_begin != m_end) && "Deque error: back() called on empty deque");
     if (size() == 0){
         exit (EXIT_FAILURE);
     }
-    if (m_end == 0){
-        return m_buffer[m_size - 1];
-    }
-    return m_buffer[m_end - 1];
+    return *element(m_end - 1);
 }
 
-template<class T>
-const T& deque<T>::cback() const
+template<class T, class Allocator, class ShrinkPolicy>
+const T& deque<T, Allocator, ShrinkPolicy>::cback() const
 {
-    assert((m_begin == m_end) && "Deque error: back() called on empty deque");
+    assert((m_begin != m_end) && "Deque error: back() called on empty deque");
     if (size() == 0){
         exit (EXIT_FAILURE);
     }
-    if (m_end == 0){
-        return m_buffer[m_size - 1];
-    }
-    return m_buffer[m_end - 1];
+    return *element(m_end - 1);
 }
 
-template<class T>
-typename deque<T>::iterator deque<T>::begin()
+template<class T, class Allocator, class ShrinkPolicy>
+typename deque<T, Allocator, ShrinkPolicy>::iterator deque<T, Allocator, ShrinkPolicy>::begin()
 {
-    iterator it;
-    it.m_deq_ptr = this;
-    it.m_indx_base = 0;
-    return it;
+    return iterator(this, 0);
 }
 
-template<class T>
-typename deque<T>::iterator deque<T>::end()
+template<class T, class Allocator, class ShrinkPolicy>
+typename deque<T, Allocator, ShrinkPolicy>::iterator deque<T, Allocator, ShrinkPolicy>::end()
 {
-    iterator it;
-    it.m_deq_ptr = this;
-    it.m_indx_base = size();
-    return it;
+    return iterator(this, size());
 }
 
-template<class T>
-typename deque<T>::iterator deque<T>::rbegin()
+template<class T, class Allocator, class ShrinkPolicy>
+typename deque<T, Allocator, ShrinkPolicy>::reverse_iterator deque<T, Allocator, ShrinkPolicy>::rbegin()
 {
-    iterator it;
-    it.m_deq_ptr = this;
-    it.m_indx_base = size()-1;
-    return it;
+    return reverse_iterator(end());
 }
 
-template<class T>
-typename deque<T>::iterator deque<T>::rend()
+template<class T, class Allocator, class ShrinkPolicy>
+typename deque<T, Allocator, ShrinkPolicy>::reverse_iterator deque<T, Allocator, ShrinkPolicy>::rend()
 {
-    iterator it;
-    it.m_deq_ptr = this;
-    it.m_indx_base = 0 - 1;
-    return it;
+    return reverse_iterator(begin());
 }
 
 }
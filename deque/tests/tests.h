@@ -3,13 +3,447 @@
 
 #include <iostream>
 #include <ctime>
+#include <chrono>
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <stdexcept>
 #include "deque.h"
 
 namespace deque_testing {
+const std::size_t num_of_elements = 100000;
+const std::size_t bench_elements = 100000000;
+const std::size_t latency_batch = 4096;
+const std::size_t throughput_elements = 10000000;
+const std::size_t throughput_rounds = 5;
+const std::size_t oscillation_cycles = 20000000;
+const std::size_t fill_drain_elements = 100000;
+const std::size_t fill_drain_rounds = 200;
 
+/**
+ * @brief The element of 12 bytes, the block size of 256 / 12 is not a power of two
+ */
+struct point3
+{
+    int x, y, z;
+};
 
+/**
+ * @brief The element counting the live objects, the copy throws when copies_left runs out
+ */
+struct throwing_copy
+{
+    static int live;
+    static int copies_left;
+    int value;
+
+    explicit throwing_copy(int val):value(val){++live;}
+    throwing_copy(const throwing_copy& other):value(other.value)
+    {
+        if(copies_left-- == 0){
+            throw std::runtime_error("copy failed");
+        }
+        ++live;
+    }
+    ~throwing_copy(){--live;}
+};
+int throwing_copy::live = 0;
+int throwing_copy::copies_left = -1;
+
+/**
+ * @brief get_time_sec - get time in seconds
+ * @return the time in seconds
+ */
+inline double get_time_sec()
+{
+    return static_cast<double>(clock())/ CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief get_new_time calculating the total time and setting the current time in seconds
+ * @param sum_time - summary time
+ * @param last_time - last time value
+ */
+void get_new_time(double &sum_time, double &last_time)
+{
+    sum_time += get_time_sec() - last_time;
+    last_time = get_time_sec();
+}
+
+/**
+ * @brief The worst and the total time of the push_back of count elements,
+ *        the time is taken per batch of latency_batch pushes.
+ */
+template<class Container>
+void push_back_latency(Container& container, std::size_t count, double& max_batch, double& total)
+{
+    max_batch = 0;
+    total = 0;
+    for(std::size_t i=0; i<count; i+=latency_batch)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(std::size_t j=i; j<i+latency_batch && j<count; ++j)
+        {
+            container.push_back(static_cast<int>(j));
+        }
+        const double batch = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        max_batch = std::max(max_batch, batch);
+        total += batch;
+    }
+}
+
+TEST(CheckDeque, PushPopBothEnds)
+{
+    //Arrange
+    scl::deque<std::string> deq;
+    std::deque<std::string> deq_std;
+    //Act
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        const std::string value = std::to_string(i);
+        switch(std::rand() % 5)
+        {
+        case 0: deq.push_front(value); deq_std.push_front(value); break;
+        case 1: deq.push_back(value); deq_std.push_back(value); break;
+        case 2: if(!deq_std.empty()){deq.pop_front(); deq_std.pop_front();} break;
+        case 3: if(!deq_std.empty()){deq.pop_back(); deq_std.pop_back();} break;
+        default: deq.push_back(value); deq_std.push_front(value); deq.pop_back(); deq_std.pop_front(); break;
+        }
+        ASSERT_EQ(deq.size(), deq_std.size());
+    }
+    //Assert
+    ASSERT_TRUE(std::equal(deq.begin(), deq.end(), deq_std.begin()));
+    ASSERT_TRUE(std::equal(deq.rbegin(), deq.rend(), deq_std.rbegin()));
+    ASSERT_EQ(deq.front(), deq_std.front());
+    ASSERT_EQ(deq.back(), deq_std.back());
+    for(std::size_t i=0; i<deq.size(); i+=13)
+    {
+        ASSERT_EQ(deq[i], deq_std[i]);
+    }
+    while(!deq.empty())
+    {
+        deq.pop_front();
+    }
+    deq.push_front("again");
+    ASSERT_EQ(deq.cback(), "again");
+}
+
+TEST(CheckDeque, StableReferences)
+{
+    //Arrange
+    scl::deque<int> deq;
+    deq.push_back(0);
+    std::vector<int*> addresses;
+    addresses.push_back(&deq.front());
+    //Act
+    for(int i=1; i<static_cast<int>(num_of_elements); ++i)
+    {
+        if(i % 2 == 0){
+            deq.push_back(i);
+            addresses.push_back(&deq.back());
+        }
+        else{
+            deq.push_front(-i);
+            addresses.push_back(&deq.front());
+        }
+    }
+    //Assert
+    ASSERT_EQ(deq.size(), num_of_elements);
+    for(std::size_t i=0; i<addresses.size(); ++i)
+    {
+        const int expected = i == 0 ? 0 : (i % 2 == 0 ? static_cast<int>(i) : -static_cast<int>(i));
+        ASSERT_EQ(*addresses[i], expected);
+    }
+    ASSERT_EQ(&deq[num_of_elements / 2], addresses[0]);
+}
+
+TEST(CheckDeque, CopyAndClear)
+{
+    //Arrange
+    scl::deque<std::string> deq(10, "ten");
+    for(std::size_t i=0; i<1000; ++i)
+    {
+        deq.push_front(std::to_string(i));
+    }
+    //Act
+    scl::deque<std::string> copy(deq);
+    scl::deque<std::string> assigned;
+    assigned.push_back("old");
+    assigned = deq;
+    deq.clear();
+    //Assert
+    ASSERT_TRUE(deq.empty());
+    ASSERT_EQ(copy.size(), 1010U);
+    ASSERT_TRUE(copy == assigned);
+    ASSERT_EQ(copy.front(), "999");
+    ASSERT_EQ(copy.back(), "ten");
+    ASSERT_EQ(*(copy.begin() + 999), "0");
+    ASSERT_EQ(copy.end() - copy.begin(), 1010);
+    deq.push_back("new");
+    ASSERT_TRUE(deq != copy);
+}
+
+TEST(CheckDeque, CopyThrows)
+{
+    //Arrange
+    scl::deque<throwing_copy> deq, assigned;
+    for(int i=0; i<1000; ++i)
+    {
+        deq.push_back(throwing_copy(i));
+    }
+    assigned.push_back(throwing_copy(-1));
+    const int live = throwing_copy::live;
+    //Act
+    throwing_copy::copies_left = 500;
+    ASSERT_THROW(scl::deque<throwing_copy> copy(deq), std::runtime_error);
+    throwing_copy::copies_left = 500;
+    ASSERT_THROW(assigned = deq, std::runtime_error);
+    throwing_copy::copies_left = -1;
+    //Assert
+    ASSERT_EQ(throwing_copy::live, live);
+    ASSERT_EQ(assigned.size(), 1U);
+    ASSERT_EQ(assigned.front().value, -1);
+    assigned.push_back(throwing_copy(1));
+    assigned = deq;
+    ASSERT_EQ(assigned.size(), 1000U);
+    ASSERT_EQ(assigned.back().value, 999);
+}
+
+TEST(CheckDeque, ShrinkPolicies)
+{
+    //Arrange
+    typedef scl::deque<int, std::allocator<int>, scl::shrink_eager> eager_deque;
+    typedef scl::deque<int, std::allocator<int>, scl::shrink_never> never_deque;
+    const std::size_t block = eager_deque::buffer_size();
+    eager_deque eager;
+    never_deque never;
+    scl::deque<int> lazy;
+    //Act
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        eager.push_back(static_cast<int>(i));
+        never.push_front(static_cast<int>(i));
+        lazy.push_back(static_cast<int>(i));
+    }
+    const std::size_t peak = never.capacity();
+    for(std::size_t i=0; i<num_of_elements - 10; ++i)
+    {
+        eager.pop_front();
+        never.pop_back();
+        lazy.pop_front();
+    }
+    //Assert
+    ASSERT_LE(eager.capacity(), 2*block);
+    ASSERT_EQ(never.capacity(), peak);
+    ASSERT_LE(lazy.capacity(), 4*block);
+    ASSERT_EQ(lazy.front(), static_cast<int>(num_of_elements - 10));
+    ASSERT_EQ(never.back(), static_cast<int>(num_of_elements - 10));
+    never.push_front(-1);
+    never.push_back(-2);
+    ASSERT_EQ(never.capacity(), peak);
+    ASSERT_EQ(never.front(), -1);
+    ASSERT_EQ(never[11], -2);
+    never.shrink_to_fit();
+    ASSERT_LE(never.capacity(), 2*block);
+    ASSERT_EQ(never.size(), 12U);
+    ASSERT_EQ(never[1], static_cast<int>(num_of_elements - 1));
+
+    eager.clear();
+    ASSERT_EQ(eager.capacity(), 0U);
+    eager.reserve(num_of_elements);
+    const std::size_t reserved = eager.capacity();
+    ASSERT_GE(reserved, num_of_elements);
+    for(std::size_t round=0; round<3; ++round)
+    {
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            eager.push_back(static_cast<int>(i));
+        }
+        ASSERT_EQ(eager.capacity(), reserved);
+        while(!eager.empty())
+        {
+            eager.pop_front();
+        }
+        ASSERT_EQ(eager.capacity(), reserved);
+    }
+    eager.shrink_to_fit();
+    ASSERT_EQ(eager.capacity(), 0U);
+    eager.push_front(7);
+    ASSERT_EQ(eager.capacity(), block);
+}
+
+/**
+ * @brief The time of push_back, the sequential operator[] pass and pop_front
+ *        of throughput_elements, throughput_rounds times.
+ */
+template<class Container, class Make>
+std::int64_t push_index_pop(Container& container, Make make, double& push_time, double& index_time, double& pop_time)
+{
+    std::int64_t sum = 0;
+    double last_time = get_time_sec();
+    for(std::size_t round=0; round<throughput_rounds; ++round)
+    {
+        last_time = get_time_sec();
+        for(std::size_t i=0; i<throughput_elements; ++i)
+        {
+            container.push_back(make(i));
+        }
+        get_new_time(push_time, last_time);
+        for(std::size_t i=0; i<container.size(); ++i)
+        {
+            sum += container[i].x;
+        }
+        get_new_time(index_time, last_time);
+        while(!container.empty())
+        {
+            container.pop_front();
+        }
+        get_new_time(pop_time, last_time);
+    }
+    return sum;
+}
+
+TEST(CompareDeque, Throughput)
+{
+    struct value4 {int x;};
+    auto make4 = [](std::size_t i){return value4{static_cast<int>(i)};};
+    auto make12 = [](std::size_t i){return point3{static_cast<int>(i), 0, 0};};
+    double push4 = 0, index4 = 0, pop4 = 0, push12 = 0, index12 = 0, pop12 = 0;
+    double std_push4 = 0, std_index4 = 0, std_pop4 = 0, std_push12 = 0, std_index12 = 0, std_pop12 = 0;
+    scl::deque<value4> deq4;
+    scl::deque<point3> deq12;
+    std::deque<value4> std_deq4;
+    std::deque<point3> std_deq12;
+    const std::int64_t sum4 = push_index_pop(deq4, make4, push4, index4, pop4);
+    const std::int64_t sum12 = push_index_pop(deq12, make12, push12, index12, pop12);
+    const std::int64_t std_sum4 = push_index_pop(std_deq4, make4, std_push4, std_index4, std_pop4);
+    const std::int64_t std_sum12 = push_index_pop(std_deq12, make12, std_push12, std_index12, std_pop12);
+    std::cout << throughput_rounds << " x " << throughput_elements << " push_back / operator[] / pop_front\n"
+              << "4 B elements: scl::deque " << push4 << " / " << index4 << " / " << pop4
+              << " s, std::deque " << std_push4 << " / " << std_index4 << " / " << std_pop4 << " s\n"
+              << "12 B elements: scl::deque " << push12 << " / " << index12 << " / " << pop12
+              << " s, std::deque " << std_push12 << " / " << std_index12 << " / " << std_pop12 << " s\n";
+    ASSERT_EQ(sum4, std_sum4);
+    ASSERT_EQ(sum12, std_sum12);
+}
+
+TEST(CompareDeque, PushBackLatency)
+{
+    double deque_max = 0, deque_total = 0, std_max = 0, std_total = 0, vector_max = 0, vector_total = 0;
+    {
+        scl::deque<int> deq;
+        push_back_latency(deq, bench_elements, deque_max, deque_total);
+        ASSERT_EQ(deq.size(), bench_elements);
+        ASSERT_EQ(deq[bench_elements - 1], static_cast<int>(bench_elements - 1));
+    }
+    {
+        std::deque<int> deq_std;
+        push_back_latency(deq_std, bench_elements, std_max, std_total);
+        ASSERT_EQ(deq_std.size(), bench_elements);
+    }
+    {
+        std::vector<int> vec;
+        push_back_latency(vec, bench_elements, vector_max, vector_total);
+        ASSERT_EQ(vec.size(), bench_elements);
+    }
+    std::cout << "push_back " << bench_elements << ", worst batch of " << latency_batch << " / total: scl::deque "
+              << deque_max*1e6 << " us / " << deque_total << " s, std::deque " << std_max*1e6 << " us / " << std_total
+              << " s, std::vector " << vector_max*1e6 << " us / " << vector_total << " s\n";
+}
+
+TEST(CompareDeque, Queue)
+{
+    double deque_time = 0, std_time = 0, last_time = get_time_sec();
+    std::int64_t deque_sum = 0, std_sum = 0;
+    scl::deque<int> deq;
+    for(std::size_t i=0; i<bench_elements; ++i)
+    {
+        deq.push_back(static_cast<int>(i));
+        if(i % 3 != 0){
+            deque_sum += deq.front();
+            deq.pop_front();
+        }
+    }
+    get_new_time(deque_time, last_time);
+    std::deque<int> deq_std;
+    for(std::size_t i=0; i<bench_elements; ++i)
+    {
+        deq_std.push_back(static_cast<int>(i));
+        if(i % 3 != 0){
+            std_sum += deq_std.front();
+            deq_std.pop_front();
+        }
+    }
+    get_new_time(std_time, last_time);
+    std::cout << "queue of " << bench_elements << " push_back/pop_front: scl::deque " << deque_time
+              << " s, std::deque " << std_time << " s\n";
+    ASSERT_EQ(deque_sum, std_sum);
+    ASSERT_EQ(deq.size(), deq_std.size());
+}
+
+/**
+ * @brief The push_back/pop_back pairs around the block boundary, then the fill and drain cycles
+ *        of the queue, the occupancy oscillates in both.
+ */
+template<class Container>
+void oscillate(Container& container, double& boundary_time, double& fill_drain_time, std::int64_t& sum)
+{
+    double last_time = get_time_sec();
+    const std::size_t boundary = 4096;
+    for(std::size_t i=0; i<boundary; ++i)
+    {
+        container.push_back(static_cast<int>(i));
+    }
+    for(std::size_t i=0; i<oscillation_cycles; ++i)
+    {
+        container.push_back(static_cast<int>(i));
+        sum += container.back();
+        container.pop_back();
+    }
+    get_new_time(boundary_time, last_time);
+    for(std::size_t round=0; round<fill_drain_rounds; ++round)
+    {
+        for(std::size_t i=0; i<fill_drain_elements; ++i)
+        {
+            container.push_back(static_cast<int>(i));
+        }
+        while(container.size() > boundary)
+        {
+            sum += container.front();
+            container.pop_front();
+        }
+    }
+    get_new_time(fill_drain_time, last_time);
+}
+
+TEST(CompareDeque, OscillatingOccupancy)
+{
+    double lazy_boundary = 0, lazy_fill = 0, never_boundary = 0, never_fill = 0;
+    double eager_boundary = 0, eager_fill = 0, std_boundary = 0, std_fill = 0;
+    std::int64_t lazy_sum = 0, never_sum = 0, eager_sum = 0, std_sum = 0;
+    scl::deque<int> lazy;
+    scl::deque<int, std::allocator<int>, scl::shrink_never> never;
+    scl::deque<int, std::allocator<int>, scl::shrink_eager> eager;
+    std::deque<int> deq_std;
+    oscillate(lazy, lazy_boundary, lazy_fill, lazy_sum);
+    oscillate(never, never_boundary, never_fill, never_sum);
+    oscillate(eager, eager_boundary, eager_fill, eager_sum);
+    oscillate(deq_std, std_boundary, std_fill, std_sum);
+    std::cout << oscillation_cycles << " push_back/pop_back at the block boundary / "
+              << fill_drain_rounds << " fills of " << fill_drain_elements << " and drains:\n"
+              << "scl::deque shrink_lazy " << lazy_boundary << " / " << lazy_fill << " s, capacity " << lazy.capacity() << "\n"
+              << "scl::deque shrink_never " << never_boundary << " / " << never_fill << " s, capacity " << never.capacity() << "\n"
+              << "scl::deque shrink_eager " << eager_boundary << " / " << eager_fill << " s, capacity " << eager.capacity() << "\n"
+              << "std::deque " << std_boundary << " / " << std_fill << " s\n";
+    ASSERT_EQ(lazy_sum, std_sum);
+    ASSERT_EQ(never_sum, std_sum);
+    ASSERT_EQ(eager_sum, std_sum);
+    ASSERT_EQ(lazy.size(), deq_std.size());
+}
 
 }
 
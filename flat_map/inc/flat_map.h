@@ -0,0 +1,783 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include "vector.h"
+
+// Sequence containers library)
+namespace scl {
+
+namespace detail {
+/**
+ * @brief The position of the first element of [base, base+n) not less than key.
+ *        The branchless binary search: the range is halved by the conditional move,
+ *        so the loop has the fixed trip count log2(n) and no mispredicted branches.
+ */
+template<class T, class Key, class Compare>
+std::size_t branchless_lower_bound(const T* base, std::size_t n, const Key& key, const Compare& comp)
+{
+    if(n == 0){
+        return 0;
+    }
+    const T* first = base;
+    while(n > 1)
+    {
+        const std::size_t half = n / 2;
+        first = comp(first[half], key) ? first + half : first;
+        n -= half;
+    }
+    return static_cast<std::size_t>(first - base) + (comp(*first, key) ? 1 : 0);
+}
+
+/**
+ * @brief is_transparent - the comparator accepts the keys of the other types,
+ *        the heterogeneous lookup is enabled, e.g. std::less<> (C++14)
+ */
+template<class Compare, class = void>
+struct is_transparent : std::false_type
+{};
+
+template<class Compare>
+struct is_transparent<Compare, typename std::conditional<true, void, typename Compare::is_transparent>::type> : std::true_type
+{};
+
+/**
+ * @brief if_transparent - R for the heterogeneous lookup overloads,
+ *        C is the template parameter of the overload, so the failure is SFINAE
+ */
+template<class C, class R>
+using if_transparent = typename std::enable_if<is_transparent<C>::value, R>::type;
+}
+
+/**
+ * Sorted flat set
+ * @brief The keys are kept sorted and unique in one scl::vector, so the lookup
+ *  is the branchless binary search over the contiguous array.
+ *  The single insert and erase shift the tail, O(n), the range insert sorts the new keys
+ *  and merges them with the set once, O(n + m log m).
+ *  The lookup with the keys of the other types needs the transparent Compare.
+ */
+template<class Key, class Compare = std::less<Key>>
+class flat_set
+{
+private:
+    scl::vector<Key> m_keys;
+    Compare m_comp;
+
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using iterator = typename scl::vector<Key>::const_iterator;
+    using const_iterator = typename scl::vector<Key>::const_iterator;
+
+    flat_set() {}
+    explicit flat_set(const Compare& comp):m_comp(comp){}
+    template<class InputIt>
+    flat_set(InputIt first, InputIt last, const Compare& comp = Compare());
+
+    inline std::size_t size() const;
+    bool empty() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    const scl::vector<Key>& keys() const;
+
+    std::size_t lower_bound_index(const Key& key) const;
+    const_iterator lower_bound(const Key& key) const;
+    const_iterator find(const Key& key) const;
+    bool contains(const Key& key) const;
+    std::size_t count(const Key& key) const;
+    template<class K, class C = Compare>
+    detail::if_transparent<C, const_iterator> find(const K& key) const;
+    template<class K, class C = Compare>
+    detail::if_transparent<C, bool> contains(const K& key) const;
+
+    std::pair<const_iterator, bool> insert(const Key& key);
+    template<class InputIt>
+    void insert(InputIt first, InputIt last);
+    std::size_t erase(const Key& key);
+    void reserve(std::size_t cap);
+    void clear();
+};
+
+/**
+ * Sorted flat map
+ * @brief The keys are kept sorted and unique in one scl::vector, the values are stored
+ *  in the other vector at the same positions. So the lookup scans only the keys
+ *  and the values are touched once the key is found.
+ *  The iterator gives the pair of the references std::pair<const Key&, T&>.
+ *  The range insert sorts the new pairs and merges them with the map once,
+ *  the existing keys keep their values, of the equal new keys the first one wins.
+ */
+template<class Key, class T, class Compare = std::less<Key>>
+class flat_map
+{
+private:
+    scl::vector<Key> m_keys;
+    scl::vector<T> m_values;
+    Compare m_comp;
+
+    template<class K>
+    std::size_t index_of(const K& key) const;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using key_compare = Compare;
+
+    /**
+     * @brief The random access iterator over the positions, V is T or const T.
+     */
+    template<class Map, class V>
+    class basic_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<Key, T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::pair<const Key&, V&>;
+
+        basic_iterator() noexcept:m_map(nullptr), m_index(0){}
+        basic_iterator(Map* map, std::size_t index) noexcept:m_map(map), m_index(index){}
+        template<class M2, class V2, class = typename std::enable_if<std::is_convertible<V2*, V*>::value>::type>
+        basic_iterator(const basic_iterator<M2, V2>& other) noexcept:m_map(other.map()), m_index(other.index()){}
+
+        inline std::size_t index() const {return m_index;}
+        inline Map* map() const {return m_map;}
+        inline const Key& key() const {return m_map->keys()[m_index];}
+        inline V& value() const {return m_map->values()[m_index];}
+        inline reference operator*() const {return reference(key(), value());}
+        inline reference operator[](difference_type n) const {return *(*this + n);}
+
+        basic_iterator& operator++(){++m_index; return *this;}//++i
+        basic_iterator& operator--(){--m_index; return *this;}//--i
+        basic_iterator operator++(int){basic_iterator it = *this; ++m_index; return it;}//i++
+        basic_iterator operator--(int){basic_iterator it = *this; --m_index; return it;}//i--
+        basic_iterator& operator+=(difference_type n){m_index += n; return *this;}
+        basic_iterator& operator-=(difference_type n){m_index -= n; return *this;}
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n){return it += n;}
+        friend basic_iterator operator-(basic_iterator it, difference_type n){return it -= n;}
+        friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs)
+        {
+            return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_index == rhs.m_index;}
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_index != rhs.m_index;}
+        friend bool operator<(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_index < rhs.m_index;}
+
+    private:
+        Map* m_map;
+        std::size_t m_index;
+    };
+
+    using iterator = basic_iterator<flat_map, T>;
+    using const_iterator = basic_iterator<const flat_map, const T>;
+
+    flat_map() {}
+    explicit flat_map(const Compare& comp):m_comp(comp){}
+    template<class InputIt>
+    flat_map(InputIt first, InputIt last, const Compare& comp = Compare());
+
+    inline std::size_t size() const;
+    bool empty() const;
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const scl::vector<Key>& keys() const;
+    scl::vector<T>& values();
+    const scl::vector<T>& values() const;
+
+    std::size_t lower_bound_index(const Key& key) const;
+    iterator find(const Key& key);
+    const_iterator find(const Key& key) const;
+    bool contains(const Key& key) const;
+    std::size_t count(const Key& key) const;
+    template<class K, class C = Compare>
+    detail::if_transparent<C, iterator> find(const K& key);
+    template<class K, class C = Compare>
+    detail::if_transparent<C, const_iterator> find(const K& key) const;
+    template<class K, class C = Compare>
+    detail::if_transparent<C, bool> contains(const K& key) const;
+
+    T& operator[](const Key& key);
+    T& at(const Key& key);
+    const T& at(const Key& key) const;
+
+    std::pair<iterator, bool> insert(const Key& key, const T& value);
+    std::pair<iterator, bool> insert_or_assign(const Key& key, const T& value);
+    template<class InputIt>
+    void insert(InputIt first, InputIt last);
+    std::size_t erase(const Key& key);
+    void reserve(std::size_t cap);
+    void clear();
+};
+
+/**
+ * @brief Ctor from the range [first, last), the keys are sorted once.
+ */
+template<class Key, class Compare>
+template<class InputIt>
+flat_set<Key, Compare>::flat_set(InputIt first, InputIt last, const Compare& comp)
+    :m_comp(comp)
+{
+    insert(first, last);
+}
+
+/**
+ * @brief The number of keys.
+ */
+template<class Key, class Compare>
+std::size_t flat_set<Key, Compare>::size() const
+{
+    return m_keys.size();
+}
+
+/**
+ * @brief Checks whether the set is empty.
+ */
+template<class Key, class Compare>
+bool flat_set<Key, Compare>::empty() const
+{
+    return m_keys.empty();
+}
+
+/**
+ * @brief Begin iterator, the keys are in the ascending order.
+ */
+template<class Key, class Compare>
+typename flat_set<Key, Compare>::const_iterator flat_set<Key, Compare>::begin() const
+{
+    return m_keys.cbegin();
+}
+
+/**
+ * @brief End iterator.
+ */
+template<class Key, class Compare>
+typename flat_set<Key, Compare>::const_iterator flat_set<Key, Compare>::end() const
+{
+    return m_keys.cend();
+}
+
+/**
+ * @brief The sorted keys, e.g. for the SIMD or the parallel scans.
+ */
+template<class Key, class Compare>
+const scl::vector<Key>& flat_set<Key, Compare>::keys() const
+{
+    return m_keys;
+}
+
+/**
+ * @brief The position of the first key not less than key.
+ */
+template<class Key, class Compare>
+std::size_t flat_set<Key, Compare>::lower_bound_index(const Key& key) const
+{
+    return detail::branchless_lower_bound(m_keys.data(), m_keys.size(), key, m_comp);
+}
+
+/**
+ * @brief The iterator to the first key not less than key.
+ */
+template<class Key, class Compare>
+typename flat_set<Key, Compare>::const_iterator flat_set<Key, Compare>::lower_bound(const Key& key) const
+{
+    return begin() + lower_bound_index(key);
+}
+
+/**
+ * @brief The iterator to the key, end() if it is missing.
+ */
+template<class Key, class Compare>
+typename flat_set<Key, Compare>::const_iterator flat_set<Key, Compare>::find(const Key& key) const
+{
+    const std::size_t i = lower_bound_index(key);
+    return (i < m_keys.size() && !m_comp(key, m_keys[i])) ? begin() + i : end();
+}
+
+/**
+ * @brief Checks whether the key is in the set.
+ */
+template<class Key, class Compare>
+bool flat_set<Key, Compare>::contains(const Key& key) const
+{
+    return find(key) != end();
+}
+
+/**
+ * @brief The number of the keys equal to key, 0 or 1.
+ */
+template<class Key, class Compare>
+std::size_t flat_set<Key, Compare>::count(const Key& key) const
+{
+    return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief The heterogeneous find, e.g. by the string view without the string construction.
+ */
+template<class Key, class Compare>
+template<class K, class C>
+detail::if_transparent<C, typename flat_set<Key, Compare>::const_iterator>
+flat_set<Key, Compare>::find(const K& key) const
+{
+    const std::size_t i = detail::branchless_lower_bound(m_keys.data(), m_keys.size(), key, m_comp);
+    return (i < m_keys.size() && !m_comp(key, m_keys[i])) ? begin() + i : end();
+}
+
+/**
+ * @brief The heterogeneous contains.
+ */
+template<class Key, class Compare>
+template<class K, class C>
+detail::if_transparent<C, bool> flat_set<Key, Compare>::contains(const K& key) const
+{
+    return find(key) != end();
+}
+
+/**
+ * @brief Inserts the key keeping the order, the tail is shifted.
+ * @return The iterator to the key and true if it was inserted.
+ */
+template<class Key, class Compare>
+std::pair<typename flat_set<Key, Compare>::const_iterator, bool> flat_set<Key, Compare>::insert(const Key& key)
+{
+    const std::size_t i = lower_bound_index(key);
+    if(i < m_keys.size() && !m_comp(key, m_keys[i])){
+        return std::make_pair(begin() + i, false);
+    }
+    m_keys.emplace(m_keys.cbegin() + i, key);
+    return std::make_pair(begin() + i, true);
+}
+
+/**
+ * @brief Inserts the keys of [first, last): they are sorted and merged with the set in one pass,
+ *        instead of the tail shift per key.
+ */
+template<class Key, class Compare>
+template<class InputIt>
+void flat_set<Key, Compare>::insert(InputIt first, InputIt last)
+{
+    scl::vector<Key> fresh;
+    for(; first != last; ++first)
+    {
+        fresh.push_back(*first);
+    }
+    if(fresh.empty()){
+        return;
+    }
+    const Compare& comp = m_comp;
+    std::sort(fresh.begin(), fresh.end(), comp);
+    scl::vector<Key> merged;
+    merged.reserve(m_keys.size() + fresh.size());
+    std::size_t i = 0, j = 0;
+    while(i < m_keys.size() || j < fresh.size())
+    {
+        if(j == fresh.size() || (i < m_keys.size() && comp(m_keys[i], fresh[j]))){
+            merged.push_back(std::move(m_keys[i++]));
+            continue;
+        }
+        // The key equal to the last merged one is a duplicate
+        if(merged.empty() || comp(merged.back(), fresh[j])){
+            if(i < m_keys.size() && !comp(fresh[j], m_keys[i])){
+                merged.push_back(std::move(m_keys[i++]));
+            }
+            else{
+                merged.push_back(std::move(fresh[j]));
+            }
+        }
+        ++j;
+    }
+    m_keys = std::move(merged);
+}
+
+/**
+ * @brief Removes the key.
+ * @return The number of the removed keys, 0 or 1.
+ */
+template<class Key, class Compare>
+std::size_t flat_set<Key, Compare>::erase(const Key& key)
+{
+    const_iterator it = find(key);
+    if(it == end()){
+        return 0;
+    }
+    m_keys.erase(it);
+    return 1;
+}
+
+/**
+ * @brief Reserves the storage for cap keys.
+ */
+template<class Key, class Compare>
+void flat_set<Key, Compare>::reserve(std::size_t cap)
+{
+    m_keys.reserve(cap);
+}
+
+/**
+ * @brief Removes all the keys.
+ */
+template<class Key, class Compare>
+void flat_set<Key, Compare>::clear()
+{
+    m_keys.clear();
+}
+
+/**
+ * @brief Ctor from the range of the pairs [first, last), the pairs are sorted once.
+ */
+template<class Key, class T, class Compare>
+template<class InputIt>
+flat_map<Key, T, Compare>::flat_map(InputIt first, InputIt last, const Compare& comp)
+    :m_comp(comp)
+{
+    insert(first, last);
+}
+
+/**
+ * @brief The number of the pairs.
+ */
+template<class Key, class T, class Compare>
+std::size_t flat_map<Key, T, Compare>::size() const
+{
+    return m_keys.size();
+}
+
+/**
+ * @brief Checks whether the map is empty.
+ */
+template<class Key, class T, class Compare>
+bool flat_map<Key, T, Compare>::empty() const
+{
+    return m_keys.empty();
+}
+
+/**
+ * @brief Begin iterator, the keys are in the ascending order.
+ */
+template<class Key, class T, class Compare>
+typename flat_map<Key, T, Compare>::iterator flat_map<Key, T, Compare>::begin()
+{
+    return iterator(this, 0);
+}
+
+/**
+ * @brief End iterator.
+ */
+template<class Key, class T, class Compare>
+typename flat_map<Key, T, Compare>::iterator flat_map<Key, T, Compare>::end()
+{
+    return iterator(this, m_keys.size());
+}
+
+/**
+ * @brief Const begin iterator.
+ */
+template<class Key, class T, class Compare>
+typename flat_map<Key, T, Compare>::const_iterator flat_map<Key, T, Compare>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+/**
+ * @brief Const end iterator.
+ */
+template<class Key, class T, class Compare>
+typename flat_map<Key, T, Compare>::const_iterator flat_map<Key, T, Compare>::end() const
+{
+    return const_iterator(this, m_keys.size());
+}
+
+/**
+ * @brief The sorted keys.
+ */
+template<class Key, class T, class Compare>
+const scl::vector<Key>& flat_map<Key, T, Compare>::keys() const
+{
+    return m_keys;
+}
+
+/**
+ * @brief The values in the order of the keys, the values may be changed in place.
+ */
+template<class Key, class T, class Compare>
+scl::vector<T>& flat_map<Key, T, Compare>::values()
+{
+    return m_values;
+}
+
+/**
+ * @brief The const values in the order of the keys.
+ */
+template<class Key, class T, class Compare>
+const scl::vector<T>& flat_map<Key, T, Compare>::values() const
+{
+    return m_values;
+}
+
+/**
+ * @brief The position of the key, size() if it is missing.
+ */
+template<class Key, class T, class Compare>
+template<class K>
+std::size_t flat_map<Key, T, Compare>::index_of(const K& key) const
+{
+    const std::size_t i = detail::branchless_lower_bound(m_keys.data(), m_keys.size(), key, m_comp);
+    return (i < m_keys.size() && !m_comp(key, m_keys[i])) ? i : m_keys.size();
+}
+
+/**
+ * @brief The position of the first key not less than key.
+ */
+template<class Key, class T, class Compare>
+std::size_t flat_map<Key, T, Compare>::lower_bound_index(const Key& key) const
+{
+    return detail::branchless_lower_bound(m_keys.data(), m_keys.size(), key, m_comp);
+}
+
+/**
+ * @brief The iterator to the pair of the key, end() if it is missing.
+ */
+template<class Key, class T, class Compare>
+typename flat_map<Key, T, Compare>::iterator flat_map<Key, T, Compare>::find(const Key& key)
+{
+    return iterator(this, index_of(key));
+}
+
+/**
+ * @brief The const iterator to the pair of the key, end() if it is missing.
+ */
+template<class Key, class T, class Compare>
+typename flat_map<Key, T, Compare>::const_iterator flat_map<Key, T, Compare>::find(const Key& key) const
+{
+    return const_iterator(this, index_of(key));
+}
+
+/**
+ * @brief Checks whether the key is in the map.
+ */
+template<class Key, class T, class Compare>
+bool flat_map<Key, T, Compare>::contains(const Key& key) const
+{
+    return index_of(key) != m_keys.size();
+}
+
+/**
+ * @brief The number of the keys equal to key, 0 or 1.
+ */
+template<class Key, class T, class Compare>
+std::size_t flat_map<Key, T, Compare>::count(const Key& key) const
+{
+    return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief The heterogeneous find.
+ */
+template<class Key, class T, class Compare>
+template<class K, class C>
+detail::if_transparent<C, typename flat_map<Key, T, Compare>::iterator>
+flat_map<Key, T, Compare>::find(const K& key)
+{
+    return iterator(this, index_of(key));
+}
+
+/**
+ * @brief The heterogeneous const find.
+ */
+template<class Key, class T, class Compare>
+template<class K, class C>
+detail::if_transparent<C, typename flat_map<Key, T, Compare>::const_iterator>
+flat_map<Key, T, Compare>::find(const K& key) const
+{
+    return const_iterator(this, index_of(key));
+}
+
+/**
+ * @brief The heterogeneous contains.
+ */
+template<class Key, class T, class Compare>
+template<class K, class C>
+detail::if_transparent<C, bool> flat_map<Key, T, Compare>::contains(const K& key) const
+{
+    return index_of(key) != m_keys.size();
+}
+
+/**
+ * @brief The value of the key, the default value is inserted if the key is missing.
+ */
+template<class Key, class T, class Compare>
+T& flat_map<Key, T, Compare>::operator[](const Key& key)
+{
+    return insert(key, T()).first.value();
+}
+
+/**
+ * @brief The value of the key.
+ * @throw std::out_of_range if the key is missing.
+ */
+template<class Key, class T, class Compare>
+T& flat_map<Key, T, Compare>::at(const Key& key)
+{
+    const std::size_t i = index_of(key);
+    if(i == m_keys.size()){
+        throw std::out_of_range("Flat map error: the key is missing");
+    }
+    return m_values[i];
+}
+
+/**
+ * @brief The const value of the key.
+ * @throw std::out_of_range if the key is missing.
+ */
+template<class Key, class T, class Compare>
+const T& flat_map<Key, T, Compare>::at(const Key& key) const
+{
+    const std::size_t i = index_of(key);
+    if(i == m_keys.size()){
+        throw std::out_of_range("Flat map error: the key is missing");
+    }
+    return m_values[i];
+}
+
+/**
+ * @brief Inserts the pair if the key is missing, the tails of both arrays are shifted.
+ * @return The iterator to the pair of the key and true if it was inserted.
+ */
+template<class Key, class T, class Compare>
+std::pair<typename flat_map<Key, T, Compare>::iterator, bool> flat_map<Key, T, Compare>::insert(const Key& key, const T& value)
+{
+    const std::size_t i = lower_bound_index(key);
+    if(i < m_keys.size() && !m_comp(key, m_keys[i])){
+        return std::make_pair(iterator(this, i), false);
+    }
+    m_values.emplace(m_values.cbegin() + i, value);
+    try{
+        m_keys.emplace(m_keys.cbegin() + i, key);
+    }
+    catch(...){
+        m_values.erase(m_values.cbegin() + i);
+        throw;
+    }
+    return std::make_pair(iterator(this, i), true);
+}
+
+/**
+ * @brief Inserts the pair or assigns the value of the existing key.
+ * @return The iterator to the pair of the key and true if it was inserted.
+ */
+template<class Key, class T, class Compare>
+std::pair<typename flat_map<Key, T, Compare>::iterator, bool> flat_map<Key, T, Compare>::insert_or_assign(const Key& key, const T& value)
+{
+    std::pair<iterator, bool> result = insert(key, value);
+    if(!result.second){
+        result.first.value() = value;
+    }
+    return result;
+}
+
+/**
+ * @brief Inserts the pairs of [first, last): they are stable sorted by the keys
+ *        and merged with the map in one pass. The existing keys keep their values,
+ *        of the equal new keys the first one is inserted.
+ */
+template<class Key, class T, class Compare>
+template<class InputIt>
+void flat_map<Key, T, Compare>::insert(InputIt first, InputIt last)
+{
+    scl::vector<std::pair<Key, T>> fresh;
+    for(; first != last; ++first)
+    {
+        fresh.push_back(*first);
+    }
+    if(fresh.empty()){
+        return;
+    }
+    const Compare& comp = m_comp;
+    std::stable_sort(fresh.begin(), fresh.end(), [&comp](const std::pair<Key, T>& lhs, const std::pair<Key, T>& rhs)
+    {
+        return comp(lhs.first, rhs.first);
+    });
+    scl::vector<Key> keys;
+    scl::vector<T> values;
+    keys.reserve(m_keys.size() + fresh.size());
+    values.reserve(m_keys.size() + fresh.size());
+    std::size_t i = 0, j = 0;
+    while(i < m_keys.size() || j < fresh.size())
+    {
+        if(j == fresh.size() || (i < m_keys.size() && comp(m_keys[i], fresh[j].first))){
+            keys.push_back(std::move(m_keys[i]));
+            values.push_back(std::move(m_values[i]));
+            ++i;
+            continue;
+        }
+        // The key equal to the last merged one is a duplicate
+        if(keys.empty() || comp(keys.back(), fresh[j].first)){
+            if(i < m_keys.size() && !comp(fresh[j].first, m_keys[i])){
+                keys.push_back(std::move(m_keys[i]));
+                values.push_back(std::move(m_values[i]));
+                ++i;
+            }
+            else{
+                keys.push_back(std::move(fresh[j].first));
+                values.push_back(std::move(fresh[j].second));
+            }
+        }
+        ++j;
+    }
+    m_keys = std::move(keys);
+    m_values = std::move(values);
+}
+
+/**
+ * @brief Removes the pair of the key.
+ * @return The number of the removed pairs, 0 or 1.
+ */
+template<class Key, class T, class Compare>
+std::size_t flat_map<Key, T, Compare>::erase(const Key& key)
+{
+    const std::size_t i = index_of(key);
+    if(i == m_keys.size()){
+        return 0;
+    }
+    m_keys.erase(m_keys.cbegin() + i);
+    m_values.erase(m_values.cbegin() + i);
+    return 1;
+}
+
+/**
+ * @brief Reserves the storage for cap pairs.
+ */
+template<class Key, class T, class Compare>
+void flat_map<Key, T, Compare>::reserve(std::size_t cap)
+{
+    m_keys.reserve(cap);
+    m_values.reserve(cap);
+}
+
+/**
+ * @brief Removes all the pairs.
+ */
+template<class Key, class T, class Compare>
+void flat_map<Key, T, Compare>::clear()
+{
+    m_keys.clear();
+    m_values.clear();
+}
+
+}
+
+#endif //FLAT_MAP_H
@@ -0,0 +1,233 @@
+#ifndef FLAT_MAP_TESTS_H
+#define FLAT_MAP_TESTS_H
+
+#include <iostream>
+#include <ctime>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include "vector.h"
+#include "flat_map.h"
+
+namespace flat_map_testing {
+const std::size_t num_of_elements = 100000;
+const std::size_t bench_elements = 1000000;
+const std::size_t bench_lookups = 5000000;
+const int module = 1000000;
+
+/**
+ * @brief get_time_sec - get time in seconds
+ * @return the time in seconds
+ */
+inline double get_time_sec()
+{
+    return static_cast<double>(clock())/ CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief get_new_time calculating the total time and setting the current time in seconds
+ * @param sum_time - summary time
+ * @param last_time - last time value
+ */
+void get_new_time(double &sum_time, double &last_time)
+{
+    sum_time += get_time_sec() - last_time;
+    last_time = get_time_sec();
+}
+
+/**
+ * @brief The transparent comparator of the strings, the lookup by const char* builds no string
+ */
+struct string_less
+{
+    using is_transparent = void;
+    bool operator()(const std::string& lhs, const std::string& rhs) const {return lhs < rhs;}
+    bool operator()(const std::string& lhs, const char* rhs) const {return std::strcmp(lhs.c_str(), rhs) < 0;}
+    bool operator()(const char* lhs, const std::string& rhs) const {return std::strcmp(lhs, rhs.c_str()) < 0;}
+};
+
+TEST(CheckFlatSet, InsertFindErase)
+{
+    //Arrange
+    scl::flat_set<int> set;
+    std::set<int> set_std;
+    //Act
+    for(std::size_t i=0; i<10000; ++i)
+    {
+        int k = std::rand() % 5000;
+        ASSERT_EQ(set.insert(k).second, set_std.insert(k).second);
+    }
+    for(int k=0; k<5000; k+=3)
+    {
+        ASSERT_EQ(set.erase(k), set_std.erase(k));
+    }
+    //Assert
+    ASSERT_EQ(set.size(), set_std.size());
+    ASSERT_TRUE(std::equal(set.begin(), set.end(), set_std.begin()));
+    for(int k=-1; k<=5000; ++k)
+    {
+        ASSERT_EQ(set.contains(k), set_std.count(k) == 1);
+        ASSERT_EQ(set.lower_bound(k) - set.begin(), std::distance(set_std.begin(), set_std.lower_bound(k)));
+    }
+}
+
+TEST(CheckFlatSet, RangeInsert)
+{
+    //Arrange
+    std::vector<int> first, second;
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        first.push_back(std::rand() % module);
+        second.push_back(std::rand() % module);
+    }
+    //Act
+    scl::flat_set<int> set(first.begin(), first.end());
+    set.insert(second.begin(), second.end());
+    std::set<int> set_std(first.begin(), first.end());
+    set_std.insert(second.begin(), second.end());
+    //Assert
+    ASSERT_EQ(set.size(), set_std.size());
+    ASSERT_TRUE(std::equal(set.begin(), set.end(), set_std.begin()));
+}
+
+TEST(CheckFlatMap, InsertFindErase)
+{
+    //Arrange
+    scl::flat_map<int, std::string> map;
+    std::map<int, std::string> map_std;
+    //Act
+    for(std::size_t i=0; i<10000; ++i)
+    {
+        int k = std::rand() % 5000;
+        std::string v = std::to_string(i);
+        ASSERT_EQ(map.insert(k, v).second, map_std.insert(std::make_pair(k, v)).second);
+    }
+    map[-5] = "minus";
+    map_std[-5] = "minus";
+    map.insert_or_assign(0, "zero");
+    map_std[0] = "zero";
+    for(int k=0; k<5000; k+=7)
+    {
+        ASSERT_EQ(map.erase(k), map_std.erase(k));
+    }
+    //Assert
+    ASSERT_EQ(map.size(), map_std.size());
+    std::map<int, std::string>::iterator it_std = map_std.begin();
+    for(std::pair<const int&, std::string&> pair : map)
+    {
+        ASSERT_EQ(pair.first, it_std->first);
+        ASSERT_EQ(pair.second, it_std->second);
+        ++it_std;
+    }
+    ASSERT_EQ(map.at(-5), "minus");
+    ASSERT_THROW(map.at(7), std::out_of_range);
+    ASSERT_TRUE(map.find(7) == map.end());
+    map.find(-5).value() = "changed";
+    ASSERT_EQ((*map.find(-5)).second, "changed");
+    const scl::flat_map<int, std::string>& cmap = map;
+    scl::flat_map<int, std::string>::const_iterator found = cmap.find(-5);
+    ASSERT_EQ(found.key(), -5);
+    ASSERT_TRUE(std::is_sorted(map.keys().begin(), map.keys().end()));
+}
+
+TEST(CheckFlatMap, RangeInsertAndHeterogeneousLookup)
+{
+    //Arrange
+    std::vector<std::pair<std::string, int>> pairs = {{"delta", 4}, {"alpha", 1}, {"charlie", 3}, {"alpha", 100}};
+    std::vector<std::pair<std::string, int>> more = {{"bravo", 2}, {"delta", 400}, {"echo", 5}};
+    //Act
+    scl::flat_map<std::string, int, string_less> map(pairs.begin(), pairs.end());
+    map.insert(more.begin(), more.end());
+    //Assert
+    ASSERT_EQ(map.size(), 5U);
+    ASSERT_EQ(map.at("alpha"), 1);
+    ASSERT_EQ(map.at("delta"), 4);
+    ASSERT_EQ(map.find("bravo").value(), 2);
+    ASSERT_TRUE(map.contains("echo"));
+    ASSERT_FALSE(map.contains("foxtrot"));
+    ASSERT_EQ(map.keys()[0], "alpha");
+    ASSERT_EQ(map.keys()[4], "echo");
+    scl::flat_set<std::string, string_less> set;
+    set.insert("x");
+    ASSERT_TRUE(set.contains("x"));
+    ASSERT_TRUE(set.find("y") == set.end());
+}
+
+TEST(CompareFlatMap, Lookup)
+{
+    std::vector<std::pair<std::int64_t, std::int64_t>> pairs;
+    for(std::size_t i=0; i<bench_elements; ++i)
+    {
+        std::int64_t k = std::rand() % module * 16;
+        pairs.push_back(std::make_pair(k, k / 2));
+    }
+    std::vector<std::int64_t> queries;
+    for(std::size_t i=0; i<bench_lookups; ++i)
+    {
+        queries.push_back(std::rand() % module * 16);
+    }
+    double flat_build = 0, map_build = 0, flat_time = 0, map_time = 0, std_bound_time = 0, last_time = get_time_sec();
+    scl::flat_map<std::int64_t, std::int64_t> flat(pairs.begin(), pairs.end());
+    get_new_time(flat_build, last_time);
+    std::map<std::int64_t, std::int64_t> map(pairs.begin(), pairs.end());
+    get_new_time(map_build, last_time);
+    std::int64_t flat_sum = 0, map_sum = 0, bound_sum = 0;
+    for(std::int64_t key : queries)
+    {
+        scl::flat_map<std::int64_t, std::int64_t>::iterator it = flat.find(key);
+        if(it != flat.end()) flat_sum += it.value();
+    }
+    get_new_time(flat_time, last_time);
+    for(std::int64_t key : queries)
+    {
+        std::map<std::int64_t, std::int64_t>::iterator it = map.find(key);
+        if(it != map.end()) map_sum += it->second;
+    }
+    get_new_time(map_time, last_time);
+    const scl::vector<std::int64_t>& keys = flat.keys();
+    for(std::int64_t key : queries)
+    {
+        scl::vector<std::int64_t>::const_iterator it = std::lower_bound(keys.begin(), keys.end(), key);
+        if(it != keys.end() && *it == key) bound_sum += flat.values()[static_cast<std::size_t>(it - keys.begin())];
+    }
+    get_new_time(std_bound_time, last_time);
+    std::cout << "build " << bench_elements << ": flat_map range insert " << flat_build << " s, std::map " << map_build << " s\n"
+              << "lookup " << bench_lookups << ": flat_map " << flat_time << " s, std::map " << map_time
+              << " s, std::lower_bound " << std_bound_time << " s\n";
+    ASSERT_EQ(flat_sum, map_sum);
+    ASSERT_EQ(flat_sum, bound_sum);
+    ASSERT_EQ(flat.size(), map.size());
+}
+
+TEST(CompareFlatMap, RangeInsertVsSingle)
+{
+    std::vector<int> keys;
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        keys.push_back(std::rand() % module);
+    }
+    double single_time = 0, range_time = 0, last_time = get_time_sec();
+    scl::flat_set<int> single;
+    for(int k : keys)
+    {
+        single.insert(k);
+    }
+    get_new_time(single_time, last_time);
+    scl::flat_set<int> range;
+    range.insert(keys.begin(), keys.end());
+    get_new_time(range_time, last_time);
+    std::cout << "insert " << num_of_elements << " keys: one by one " << single_time << " s, range " << range_time << " s\n";
+    ASSERT_TRUE(std::equal(single.begin(), single.end(), range.begin()));
+}
+
+}
+
+#endif //FLAT_MAP_TESTS_H
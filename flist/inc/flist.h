@@ -2,29 +2,38 @@
 #define FLIST_H
 #include <cstdint>
 #include <string>
+#include <memory>
 #include <stdexcept>
 
 // Sequence containers library)
 namespace scl {
 
 //forward linked list
-template<class T>
+//nodes are obtained from the Allocator rebound to the node type
+template<class T, class Allocator = std::allocator<T>>
 class flist
 {
 private:
     //node
     struct tnode
     {
+        tnode(const T& val, tnode *next):m_val(val), m_next(next){}
         T m_val;
         tnode *m_next;
     };
 
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<tnode>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    node_allocator m_alloc;
     tnode *m_head;
     tnode *m_tail;
     std::size_t m_count;
 
     //private methdots
-    void copy_flist(const flist<T> &other);
+    tnode* create_node(const T& val, tnode* next);
+    void destroy_node(tnode* node);
+    void copy_flist(const flist<T, Allocator> &other);
     // Search prev node for pos
     tnode* prev(tnode* pos);
     // Return next node for this
@@ -44,15 +53,18 @@ public:
         inline iterator& operator++(int junk){iterator ret(*this); ++*this; return ret;} //i++
         inline bool operator ==(const iterator& other) const {return ptr_node == other.ptr_node;}
         inline bool operator !=(const iterator& other) const {return ptr_node != other.ptr_node;}
-        friend flist<T>::iterator flist<T>::insert_after(const iterator &pos, const T &data);
-        friend flist<T>::iterator flist<T>::erase_after(iterator& pos);
-        friend void flist<T>::swap(iterator &first, iterator &second);
+        friend flist<T, Allocator>::iterator flist<T, Allocator>::insert_after(const iterator &pos, const T &data);
+        friend flist<T, Allocator>::iterator flist<T, Allocator>::erase_after(iterator& pos);
+        friend void flist<T, Allocator>::swap(iterator &first, iterator &second);
 
     private:
         tnode *ptr_node;
     };
 
+    using allocator_type = Allocator;
+
     flist() noexcept;
+    explicit flist(const Allocator& alloc) noexcept;
     ~flist();
     explicit flist(const flist &other);
     flist &operator=(const flist &other);
@@ -84,18 +96,33 @@ public:
 /**
  * @brief Default ctor
  */
-template<class T>
-flist<T>::flist() noexcept
+template<class T, class Allocator>
+flist<T, Allocator>::flist() noexcept
     :m_head(nullptr)
     ,m_tail(nullptr)
     ,m_count(0)
 {}
 
+/**
+ * @brief Ctor with the allocator instance
+ */
+template<class T, class Allocator>
+flist<T, Allocator>::flist(const Allocator& alloc) noexcept
+    :m_alloc(alloc)
+    ,m_head(nullptr)
+    ,m_tail(nullptr)
+    ,m_count(0)
+{}
+
 /**
  * @brief Copy ctor
  */
-template<class T>
-flist<T>::flist(const flist &other)
+template<class T, class Allocator>
+flist<T, Allocator>::flist(const flist &other)
+    :m_alloc(node_traits::select_on_container_copy_construction(other.m_alloc))
+    ,m_head(nullptr)
+    ,m_tail(nullptr)
+    ,m_count(0)
 {
     copy_flist(other);
 }
@@ -103,16 +130,19 @@ flist<T>::flist(const flist &other)
 /**
  * @brief Assignment operator
  */
-template<class T>
-flist<T>& flist<T>::operator=(const flist &other)
+template<class T, class Allocator>
+flist<T, Allocator>& flist<T, Allocator>::operator=(const flist &other)
 {
     if(this == &other){
         return *this;
     }
 
-    if(empty()){
+    if(!empty()){
         clear();
     }
+    if(node_traits::propagate_on_container_copy_assignment::value){
+        m_alloc = other.m_alloc;
+    }
     copy_flist(other);
     return *this;
 }
@@ -120,8 +150,8 @@ flist<T>& flist<T>::operator=(const flist &other)
 /**
  * @brief Dtor
  */
-template<class T>
-flist<T>::~flist()
+template<class T, class Allocator>
+flist<T, Allocator>::~flist()
 {
     clear();
 }
@@ -129,14 +159,12 @@ flist<T>::~flist()
 /**
  * @brief
  */
-template<class T>
-void flist<T>::add(const T &data)
+template<class T, class Allocator>
+void flist<T, Allocator>::add(const T &data)
 {
     //1. alloc new node instance.
-    tnode *tmp = new (std::nothrow) tnode();
+    tnode *tmp = create_node(data, nullptr);
     if(tmp != NULL){
-        tmp->m_val = data;
-        tmp->m_next = nullptr;
         //2. checks whether list empty.
         if(m_head == nullptr){
             /* If the list is empty,
@@ -160,15 +188,14 @@ void flist<T>::add(const T &data)
 /**
  * @brief
  */
-template<class T>
-typename flist<T>::iterator flist<T>::insert_after(const iterator& pos, const T &data)
+template<class T, class Allocator>
+typename flist<T, Allocator>::iterator flist<T, Allocator>::insert_after(const iterator& pos, const T &data)
 {
     //Add temp node and this iterator position as current node
-    tnode *result = new (std::nothrow) tnode();
+    tnode *result = create_node(data, nullptr);
     tnode *curr_node = pos.ptr_node;
 
     if(result != NULL){
-        result->m_val = data;
 
         if(curr_node->m_next == nullptr){
             // If pos - tail node, adding after him
@@ -186,14 +213,14 @@ typename flist<T>::iterator flist<T>::insert_after(const iterator& pos, const T
 /**
  * @brief
  */
-template<class T>
-typename flist<T>::iterator flist<T>::erase_after(iterator& pos)
+template<class T, class Allocator>
+typename flist<T, Allocator>::iterator flist<T, Allocator>::erase_after(iterator& pos)
 {
     tnode* curr_pos = pos.ptr_node;
     tnode* tmp = curr_pos->m_next;
 
     curr_pos->m_next = tmp->m_next;
-    delete tmp;
+    destroy_node(tmp);
     --m_count;
     return iterator(curr_pos->m_next);
 }
@@ -201,15 +228,12 @@ typename flist<T>::iterator flist<T>::erase_after(iterator& pos)
 /**
  * @brief
  */
-template<class T>
-void flist<T>::push_front(const T& data)
+template<class T, class Allocator>
+void flist<T, Allocator>::push_front(const T& data)
 {
-    tnode *result = new (std::nothrow) tnode();
+    tnode *result = create_node(data, m_head);
 
     if(result != NULL){
-        result->m_val = data;
-
-        result->m_next = m_head;
         m_head = result;
         ++m_count;
     }
@@ -218,17 +242,18 @@ void flist<T>::push_front(const T& data)
 /**
  * @brief
  */
-template<class T>
-void flist<T>::pop_front()
+template<class T, class Allocator>
+void flist<T, Allocator>::pop_front()
 {
     if(m_count == 1){
+        destroy_node(m_head);
         m_head = nullptr;
         m_tail = nullptr;
     }
     else{
         tnode *temp_head = m_head;
         m_head = m_head->m_next;
-        delete temp_head;
+        destroy_node(temp_head);
     }
     --m_count;
 }
@@ -236,8 +261,8 @@ void flist<T>::pop_front()
 /**
  * @brief
  */
-template<class T>
-void flist<T>::clear()
+template<class T, class Allocator>
+void flist<T, Allocator>::clear()
 {
     if(empty()){
         return;
@@ -246,7 +271,7 @@ void flist<T>::clear()
     tnode *current_tnode = m_head;
     while(current_tnode != nullptr){
         tnode* next_tnode = current_tnode->m_next;
-        delete current_tnode;
+        destroy_node(current_tnode);
         current_tnode = next_tnode;
         --m_count;
     }
@@ -257,8 +282,8 @@ void flist<T>::clear()
 /**
  *
  */
-template<class T>
-void flist<T>::swap(iterator& first, iterator& second)
+template<class T, class Allocator>
+void flist<T, Allocator>::swap(iterator& first, iterator& second)
 {
     tnode* first_node = first.ptr_node;
     tnode* second_node = second.ptr_node;
@@ -306,35 +331,35 @@ void flist<T>::swap(iterator& first, iterator& second)
     first_node->m_next = next_second_node;
 }
 
-template<class T>
-inline std::size_t flist<T>::size() const noexcept
+template<class T, class Allocator>
+inline std::size_t flist<T, Allocator>::size() const noexcept
 {
     return m_count;
 }
 
-template<class T>
-inline bool flist<T>::empty() const noexcept
+template<class T, class Allocator>
+inline bool flist<T, Allocator>::empty() const noexcept
 {
     return m_head == NULL;
 }
 
 //TODO - edit method using std::advance, or self implementation
-template<class T>
-inline T flist<T>::get_value(tnode *node)
+template<class T, class Allocator>
+inline T flist<T, Allocator>::get_value(tnode *node)
 {
     if(node != NULL)
     return node->m_val;
 }
 
 //TODO - edit method using std::advance, or self implementation
-template<class T>
-inline void flist<T>::set_value(tnode *node, const T &val)
+template<class T, class Allocator>
+inline void flist<T, Allocator>::set_value(tnode *node, const T &val)
 {
     node->m-val = val;
 }
 
-template<class T>
-inline typename flist<T>::iterator flist<T>::begin()
+template<class T, class Allocator>
+inline typename flist<T, Allocator>::iterator flist<T, Allocator>::begin()
 {
     if(empty()){
         throw std::runtime_error("List is empty.");
@@ -342,8 +367,8 @@ inline typename flist<T>::iterator flist<T>::begin()
     return iterator(m_head);
 }
 
-template<class T>
-inline typename flist<T>::iterator flist<T>::cbegin() const
+template<class T, class Allocator>
+inline typename flist<T, Allocator>::iterator flist<T, Allocator>::cbegin() const
 {
     if(empty()){
         throw std::runtime_error("List is empty.");
@@ -351,25 +376,54 @@ inline typename flist<T>::iterator flist<T>::cbegin() const
     return iterator(m_head);
 }
 
-template<class T>
-inline typename flist<T>::iterator flist<T>::end()
+template<class T, class Allocator>
+inline typename flist<T, Allocator>::iterator flist<T, Allocator>::end()
 {
     return iterator(m_tail->m_next);
 }
 
-template<class T>
-inline typename flist<T>::iterator flist<T>::cend() const
+template<class T, class Allocator>
+inline typename flist<T, Allocator>::iterator flist<T, Allocator>::cend() const
 {
     return iterator(m_tail->m_next);
 }
 
+/**
+ * @brief Private internal method. Allocates and constructs the node using the allocator.
+ * @param val const reference to the node value
+ * @param next the next node pointer
+ */
+template<class T, class Allocator>
+typename flist<T, Allocator>::tnode* flist<T, Allocator>::create_node(const T& val, tnode* next)
+{
+    tnode* node = node_traits::allocate(m_alloc, 1);
+    try{
+        node_traits::construct(m_alloc, node, val, next);
+    }
+    catch(...){
+        node_traits::deallocate(m_alloc, node, 1);
+        throw;
+    }
+    return node;
+}
+
+/**
+ * @brief Private internal method. Destroys the node and returns it to the allocator.
+ */
+template<class T, class Allocator>
+void flist<T, Allocator>::destroy_node(tnode* node)
+{
+    node_traits::destroy(m_alloc, node);
+    node_traits::deallocate(m_alloc, node, 1);
+}
+
 /**
  * @brief Private internal method. Check the head node of validity
  *        and then sequentially adds nodes with the given value.
  * @param other const reference other flist for copy
  */
-template<class T>
-void flist<T>::copy_flist(const flist<T>& other)
+template<class T, class Allocator>
+void flist<T, Allocator>::copy_flist(const flist<T, Allocator>& other)
 {
     if(other.m_head != nullptr){
         tnode *tmp = other.m_head;
@@ -383,8 +437,8 @@ void flist<T>::copy_flist(const flist<T>& other)
 /**
  * @brief Private internal method.
  */
-template<class T>
-typename flist<T>::tnode* flist<T>::prev(tnode* pos)
+template<class T, class Allocator>
+typename flist<T, Allocator>::tnode* flist<T, Allocator>::prev(tnode* pos)
 {
     // If list empty, or one head node return
     if(empty()||(pos == m_head)){
@@ -402,8 +456,8 @@ typename flist<T>::tnode* flist<T>::prev(tnode* pos)
 /**
  * @brief Private internal method.
  */
-template<class T>
-typename flist<T>::tnode* flist<T>::next(tnode* pos)
+template<class T, class Allocator>
+typename flist<T, Allocator>::tnode* flist<T, Allocator>::next(tnode* pos)
 {
     if(empty()){
         return pos;
@@ -0,0 +1,195 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+
+/**
+ * @brief SCL_INSTRUMENT_EVENT - reports the event to the m_stats member of the container.
+ *        The containers include this header only if SCL_INSTRUMENT is defined,
+ *        otherwise they define the macro as the empty statement and have no m_stats member.
+ */
+#define SCL_INSTRUMENT_EVENT(event) m_stats.event
+
+// Sequence containers library)
+namespace scl {
+
+/**
+ * @brief The counters of the storage management, all the sizes are in bytes.
+ *        m_allocations - the number of the storage blocks obtained from the allocator
+ *        m_reallocations - the allocations, which replaced the storage with elements
+ *        m_bytes_copied - the bytes of the elements copied from the other container or range
+ *        m_bytes_moved - the bytes of the elements moved inside the container or to the new storage
+ *        m_peak_capacity - the largest storage block
+ *        m_wasted_capacity - the unused bytes of the released storage blocks,
+ *                            for the instance the unused bytes of the current storage are added
+ */
+struct container_stats
+{
+    std::size_t m_allocations = 0;
+    std::size_t m_reallocations = 0;
+    std::size_t m_bytes_copied = 0;
+    std::size_t m_bytes_moved = 0;
+    std::size_t m_peak_capacity = 0;
+    std::size_t m_wasted_capacity = 0;
+};
+
+/**
+ * @brief The counters of one container instance, every event is also added
+ *        to the totals of the Container type, the totals are updated with the relaxed atomics.
+ *        The copy of the container starts with the zero counters.
+ */
+template<class Container>
+class instrument
+{
+private:
+    struct totals
+    {
+        std::atomic<std::size_t> m_allocations{0};
+        std::atomic<std::size_t> m_reallocations{0};
+        std::atomic<std::size_t> m_bytes_copied{0};
+        std::atomic<std::size_t> m_bytes_moved{0};
+        std::atomic<std::size_t> m_peak_capacity{0};
+        std::atomic<std::size_t> m_wasted_capacity{0};
+    };
+
+    container_stats m_counters;
+
+    static totals& global();
+    static void add(std::atomic<std::size_t>& counter, std::size_t value);
+
+public:
+    instrument() noexcept {}
+    instrument(const instrument&) noexcept {}
+    instrument& operator=(const instrument&) noexcept {return *this;}
+
+    void on_allocate(std::size_t bytes);
+    void on_reallocate(std::size_t unused_bytes);
+    void on_copy(std::size_t bytes);
+    void on_move(std::size_t bytes);
+    void on_release(std::size_t unused_bytes);
+
+    container_stats stats(std::size_t unused_bytes) const;
+    static container_stats total();
+    static void reset_total();
+};
+
+/**
+ * @brief The totals of the Container type, shared by all the instances.
+ */
+template<class Container>
+typename instrument<Container>::totals& instrument<Container>::global()
+{
+    static totals counters;
+    return counters;
+}
+
+template<class Container>
+void instrument<Container>::add(std::atomic<std::size_t>& counter, std::size_t value)
+{
+    counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+/**
+ * @brief The storage block of bytes is obtained from the allocator.
+ */
+template<class Container>
+void instrument<Container>::on_allocate(std::size_t bytes)
+{
+    ++m_counters.m_allocations;
+    add(global().m_allocations, 1);
+    if(bytes > m_counters.m_peak_capacity){
+        m_counters.m_peak_capacity = bytes;
+    }
+    std::size_t peak = global().m_peak_capacity.load(std::memory_order_relaxed);
+    while(bytes > peak && !global().m_peak_capacity.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+    {}
+}
+
+/**
+ * @brief The elements are transferred to the new storage block,
+ *        the old block is released with unused_bytes.
+ */
+template<class Container>
+void instrument<Container>::on_reallocate(std::size_t unused_bytes)
+{
+    ++m_counters.m_reallocations;
+    add(global().m_reallocations, 1);
+    on_release(unused_bytes);
+}
+
+/**
+ * @brief The bytes of the elements are copied into the container.
+ */
+template<class Container>
+void instrument<Container>::on_copy(std::size_t bytes)
+{
+    m_counters.m_bytes_copied += bytes;
+    add(global().m_bytes_copied, bytes);
+}
+
+/**
+ * @brief The bytes of the elements are moved or relocated.
+ */
+template<class Container>
+void instrument<Container>::on_move(std::size_t bytes)
+{
+    m_counters.m_bytes_moved += bytes;
+    add(global().m_bytes_moved, bytes);
+}
+
+/**
+ * @brief The storage block is released with unused_bytes never filled at the moment.
+ */
+template<class Container>
+void instrument<Container>::on_release(std::size_t unused_bytes)
+{
+    m_counters.m_wasted_capacity += unused_bytes;
+    add(global().m_wasted_capacity, unused_bytes);
+}
+
+/**
+ * @brief The counters of the instance.
+ * @param unused_bytes The unused bytes of the current storage.
+ */
+template<class Container>
+container_stats instrument<Container>::stats(std::size_t unused_bytes) const
+{
+    container_stats result = m_counters;
+    result.m_wasted_capacity += unused_bytes;
+    return result;
+}
+
+/**
+ * @brief The totals of all the instances of the Container type.
+ */
+template<class Container>
+container_stats instrument<Container>::total()
+{
+    container_stats result;
+    result.m_allocations = global().m_allocations.load(std::memory_order_relaxed);
+    result.m_reallocations = global().m_reallocations.load(std::memory_order_relaxed);
+    result.m_bytes_copied = global().m_bytes_copied.load(std::memory_order_relaxed);
+    result.m_bytes_moved = global().m_bytes_moved.load(std::memory_order_relaxed);
+    result.m_peak_capacity = global().m_peak_capacity.load(std::memory_order_relaxed);
+    result.m_wasted_capacity = global().m_wasted_capacity.load(std::memory_order_relaxed);
+    return result;
+}
+
+/**
+ * @brief Clears the totals of the Container type, e.g. between the telemetry periods.
+ */
+template<class Container>
+void instrument<Container>::reset_total()
+{
+    global().m_allocations.store(0, std::memory_order_relaxed);
+    global().m_reallocations.store(0, std::memory_order_relaxed);
+    global().m_bytes_copied.store(0, std::memory_order_relaxed);
+    global().m_bytes_moved.store(0, std::memory_order_relaxed);
+    global().m_peak_capacity.store(0, std::memory_order_relaxed);
+    global().m_wasted_capacity.store(0, std::memory_order_relaxed);
+}
+
+}
+
+#endif //INSTRUMENT_H
@@ -0,0 +1,125 @@
+#ifndef INSTRUMENT_TESTS_H
+#define INSTRUMENT_TESTS_H
+
+#include <iostream>
+#include <ctime>
+#include <gtest/gtest.h>
+
+#include <string>
+#include "vector.h"
+#include "deque.h"
+#include "instrument.h"
+
+namespace instrument_testing {
+const std::size_t num_of_elements = 100000;
+
+/**
+ * @brief Prints the counters in one line
+ */
+void print_stats(const char* name, const scl::container_stats& stats)
+{
+    std::cout << name << ": allocations " << stats.m_allocations
+              << ", reallocations " << stats.m_reallocations
+              << ", copied " << stats.m_bytes_copied
+              << " B, moved " << stats.m_bytes_moved
+              << " B, peak capacity " << stats.m_peak_capacity
+              << " B, wasted " << stats.m_wasted_capacity << " B\n";
+}
+
+TEST(CheckInstrument, VectorGrowth)
+{
+    //Arrange
+    scl::vector<int> vec;
+    //Act
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        vec.push_back(static_cast<int>(i));
+    }
+    scl::container_stats stats = vec.stats();
+    //Assert
+    print_stats("push_back", stats);
+    ASSERT_GT(stats.m_allocations, 1U);
+    ASSERT_EQ(stats.m_reallocations, stats.m_allocations - 1);
+    ASSERT_GE(stats.m_bytes_moved, num_of_elements*sizeof(int));
+    ASSERT_EQ(stats.m_bytes_copied, 0U);
+    ASSERT_EQ(stats.m_peak_capacity, vec.capacity()*sizeof(int));
+    ASSERT_EQ(stats.m_wasted_capacity, (vec.capacity()-vec.size())*sizeof(int));
+}
+
+TEST(CheckInstrument, VectorReserveAndCopy)
+{
+    //Arrange
+    scl::vector<std::string> vec;
+    //Act
+    vec.reserve(num_of_elements);
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        vec.emplace_back("value");
+    }
+    scl::vector<std::string> copy(vec);
+    //Assert
+    scl::container_stats stats = vec.stats();
+    print_stats("reserve", stats);
+    ASSERT_EQ(stats.m_allocations, 2U);
+    ASSERT_EQ(stats.m_reallocations, 1U);
+    ASSERT_EQ(stats.m_bytes_moved, 0U);
+    ASSERT_EQ(stats.m_wasted_capacity, DEFAULT_CAPACITE_SIZE*sizeof(std::string));
+    ASSERT_EQ(copy.stats().m_bytes_copied, num_of_elements*sizeof(std::string));
+    ASSERT_EQ(copy.stats().m_allocations, 1U);
+}
+
+TEST(CheckInstrument, TotalsPerType)
+{
+    //Arrange
+    scl::vector<long>::total_stats();
+    scl::instrument<scl::vector<long>>::reset_total();
+    scl::instrument<scl::vector<short>>::reset_total();
+    //Act
+    {
+        scl::vector<long> first, second;
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            first.push_back(static_cast<long>(i));
+        }
+        second.push_back(1);
+        second = first;
+    }
+    scl::vector<short> other;
+    //Assert
+    scl::container_stats total = scl::vector<long>::total_stats();
+    print_stats("vector<long> total", total);
+    ASSERT_GT(total.m_allocations, 3U);
+    ASSERT_EQ(total.m_bytes_copied, num_of_elements*sizeof(long));
+    ASSERT_GE(total.m_peak_capacity, num_of_elements*sizeof(long));
+    ASSERT_GT(total.m_wasted_capacity, 0U);
+    ASSERT_EQ(scl::vector<short>::total_stats().m_allocations, 1U);
+    ASSERT_EQ(scl::vector<short>::total_stats().m_bytes_moved, 0U);
+}
+
+TEST(CheckInstrument, DequeGrowthAndCopy)
+{
+    //Arrange
+    scl::deque<int> deq;
+    const std::size_t block = scl::deque<int>::buffer_size();
+    //Act
+    for(std::size_t i=0; i<200; ++i)
+    {
+        deq.push_back(static_cast<int>(i));
+    }
+    scl::deque<int> copy(deq);
+    //Assert
+    // The deque grows by the blocks, the elements are never moved
+    scl::container_stats stats = deq.stats();
+    print_stats("deque", stats);
+    ASSERT_EQ(stats.m_allocations, (200U + block - 1)/block);
+    ASSERT_EQ(stats.m_reallocations, 0U);
+    ASSERT_EQ(stats.m_bytes_moved, 0U);
+    ASSERT_EQ(stats.m_peak_capacity, block*sizeof(int));
+    ASSERT_EQ(stats.m_wasted_capacity, (stats.m_allocations*block - 200U)*sizeof(int));
+    ASSERT_EQ(copy.stats().m_bytes_copied, 200U*sizeof(int));
+    ASSERT_GE(scl::deque<int>::total_stats().m_allocations, 4U);
+}
+
+}
+
+#endif //INSTRUMENT_TESTS_H
@@ -0,0 +1,37 @@
+#ifndef MMAP_HEADER_H
+#define MMAP_HEADER_H
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief MMAP_VECTOR_MAGIC - the first bytes of the file, "SCLMMAP" with the zero byte
+ * @brief MMAP_VECTOR_VERSION - the version of the file layout
+ * @brief MMAP_HEADER_SIZE - the size of the header, the elements start after it
+ */
+constexpr std::uint64_t MMAP_VECTOR_MAGIC = 0x0050414D4D4C4353ULL;
+constexpr std::uint32_t MMAP_VECTOR_VERSION = 1U;
+constexpr std::size_t MMAP_HEADER_SIZE = 64U;
+
+// Sequence containers library)
+namespace scl {
+
+/**
+ * @brief The header at the beginning of the mapping,
+ *        the file can be opened without any deserialization.
+ *        The same layout is written by the vector snapshot, see vector_snapshot.h,
+ *        so the snapshot is opened by mmap_vector and the mmap_vector file is loaded as the snapshot.
+ */
+struct mmap_header
+{
+    std::uint64_t m_magic;
+    std::uint32_t m_version;
+    std::uint32_t m_elem_size;
+    std::uint64_t m_size;
+    std::uint64_t m_reserved[5];
+};
+
+static_assert(sizeof(mmap_header) == MMAP_HEADER_SIZE, "mmap_vector error: wrong header size");
+
+}
+
+#endif //MMAP_HEADER_H
@@ -0,0 +1,607 @@
+#ifndef MMAP_VECTOR_H
+#define MMAP_VECTOR_H
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <cassert>
+#include <utility>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mmap_header.h"
+
+// Sequence containers library)
+namespace scl {
+
+/**
+ * Vector in the memory mapped region
+ * @brief The elements are stored in the file mapping or in the anonymous mapping.
+ *  The interface follows scl::vector, only trivially copyable types are supported,
+ *  the elements are never constructed or destroyed.
+ *  The storage grows with mremap, so the pages are never copied, but the address
+ *  of the elements can be changed by the growth.
+ *  The file layout is mmap_header and the array of elements, the size is stored
+ *  in the header by flush() and by the destructor. The file is truncated
+ *  to the used length in the destructor.
+ */
+template<class T>
+class mmap_vector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "mmap_vector error: T must be trivially copyable");
+    static_assert(alignof(T) <= MMAP_HEADER_SIZE, "mmap_vector error: T alignment is too large");
+
+private:
+    int m_fd = -1;
+    bool m_read_only = false;
+    char* m_base = nullptr;
+    std::size_t m_length = 0;
+    std::size_t m_size = 0;
+    std::size_t m_cap = 0;
+
+    static std::size_t page_size();
+    static std::size_t round_to_page(std::size_t bytes);
+    static void throw_errno(const char* what);
+
+    inline T* data_ptr() const;
+    inline mmap_header* header() const;
+    void map(std::size_t length);
+    void remap(std::size_t length);
+    void close();
+
+public:
+
+    class iterator
+    {
+    public:
+        iterator() noexcept {}
+        explicit iterator(T* ptr):m_ptr(ptr){}
+
+        inline iterator& operator=(const iterator& other){m_ptr = other.m_ptr; return *this;}
+
+        iterator& operator++(){++m_ptr; return *this;}//++i
+        iterator& operator--(){--m_ptr; return *this;}//--i
+        iterator operator++(int junk){iterator it = *this; ++m_ptr; return it;}//i++
+        iterator operator--(int junk){iterator it = *this; --m_ptr; return it;}//i--
+        inline T& operator*(){return *m_ptr;}
+        inline T* operator->(){return m_ptr;}
+        bool operator==(const iterator& other){return m_ptr == other.m_ptr;}
+        bool operator!=(const iterator& other){return m_ptr != other.m_ptr;}
+
+    private:
+        T* m_ptr;
+    };
+
+    mmap_vector() noexcept;
+    explicit mmap_vector(const std::string& path, bool read_only = false);
+    mmap_vector(const mmap_vector<T>& other) = delete;
+    mmap_vector(mmap_vector<T>&& other) noexcept;
+    ~mmap_vector();
+    mmap_vector<T>& operator=(const mmap_vector<T>& other) = delete;
+    mmap_vector<T>& operator=(mmap_vector<T>&& other) noexcept;
+
+    inline std::size_t capacity() const;
+    inline std::size_t size() const;
+    bool empty() const;
+    inline bool is_file_backed() const;
+    inline bool is_read_only() const;
+
+    iterator begin();
+    iterator cbegin() const;
+    iterator end();
+    iterator cend() const;
+    T& front();
+    T& back();
+    T* data();
+    const T* data() const;
+    void push_back(const T& data);
+    void pop_back();
+
+    void reserve(std::size_t cap);
+    void resize(std::size_t size);
+    void clear();
+
+    void flush(bool async = false);
+    void flush(std::size_t first, std::size_t count, bool async = false);
+
+    T& operator[](std::size_t index);
+    const T& operator[](std::size_t index) const;
+};
+
+/**
+ * @brief Default ctor, the anonymous mapping is created by the first growth
+ */
+template<class T>
+mmap_vector<T>::mmap_vector() noexcept
+{}
+
+/**
+ * @brief Opens the existing file or creates the new one.
+ *        The existing file is mapped as is, the header is checked only.
+ *        The foreign file is left unchanged, its header is read before the mapping.
+ * @param path The path of the file.
+ * @param read_only The file is opened and mapped for reading, the vector can't be changed.
+ */
+template<class T>
+mmap_vector<T>::mmap_vector(const std::string& path, bool read_only)
+    :m_read_only(read_only)
+{
+    m_fd = ::open(path.c_str(), read_only ? O_RDONLY : (O_RDWR | O_CREAT), 0644);
+    if(m_fd < 0){
+        throw_errno("mmap_vector error: unable to open the file");
+    }
+    try{
+        struct stat st;
+        if(::fstat(m_fd, &st) != 0){
+            throw_errno("mmap_vector error: unable to stat the file");
+        }
+        std::size_t file_size = static_cast<std::size_t>(st.st_size);
+        if(file_size == 0){
+            if(read_only){
+                throw std::runtime_error("mmap_vector error: the file is empty");
+            }
+            map(round_to_page(MMAP_HEADER_SIZE + sizeof(T)));
+            mmap_header* hdr = header();
+            hdr->m_magic = MMAP_VECTOR_MAGIC;
+            hdr->m_version = MMAP_VECTOR_VERSION;
+            hdr->m_elem_size = static_cast<std::uint32_t>(sizeof(T));
+            hdr->m_size = 0;
+            return;
+        }
+        if(file_size < MMAP_HEADER_SIZE){
+            throw std::runtime_error("mmap_vector error: the file is too small");
+        }
+        // The header is checked before the mapping, which extends the file to the page boundary
+        mmap_header hdr;
+        ssize_t count = 0;
+        do{
+            count = ::pread(m_fd, &hdr, sizeof(hdr), 0);
+        }while(count < 0 && errno == EINTR);
+        if(count < 0){
+            throw_errno("mmap_vector error: unable to read the file header");
+        }
+        if(static_cast<std::size_t>(count) != sizeof(hdr) ||
+           hdr.m_magic != MMAP_VECTOR_MAGIC || hdr.m_version != MMAP_VECTOR_VERSION ||
+           hdr.m_elem_size != sizeof(T) || hdr.m_size > (file_size - MMAP_HEADER_SIZE) / sizeof(T)){
+            throw std::runtime_error("mmap_vector error: the file header doesn't match");
+        }
+        map(read_only ? file_size : round_to_page(file_size));
+        m_size = static_cast<std::size_t>(hdr.m_size);
+    }
+    catch(...){
+        // The file isn't ours yet, it must not be changed
+        m_read_only = true;
+        close();
+        throw;
+    }
+}
+
+/**
+ * @brief Move ctor, takes the mapping of other
+ */
+template<class T>
+mmap_vector<T>::mmap_vector(mmap_vector<T>&& other) noexcept
+    :m_fd(other.m_fd)
+    ,m_read_only(other.m_read_only)
+    ,m_base(other.m_base)
+    ,m_length(other.m_length)
+    ,m_size(other.m_size)
+    ,m_cap(other.m_cap)
+{
+    other.m_fd = -1;
+    other.m_base = nullptr;
+    other.m_length = 0;
+    other.m_size = 0;
+    other.m_cap = 0;
+}
+
+/**
+ * @brief Dtor, stores the size, unmaps and truncates the file to the used length
+ */
+template<class T>
+mmap_vector<T>::~mmap_vector()
+{
+    close();
+}
+
+/**
+ * @brief Move assignment operator
+ */
+template<class T>
+mmap_vector<T>& mmap_vector<T>::operator=(mmap_vector<T>&& other) noexcept
+{
+    if(this != &other){
+        close();
+        std::swap(m_fd, other.m_fd);
+        std::swap(m_read_only, other.m_read_only);
+        std::swap(m_base, other.m_base);
+        std::swap(m_length, other.m_length);
+        std::swap(m_size, other.m_size);
+        std::swap(m_cap, other.m_cap);
+    }
+    return *this;
+}
+
+/**
+ * @brief The number of elements that fit into the current mapping.
+ */
+template<class T>
+std::size_t mmap_vector<T>::capacity() const
+{
+    return m_cap;
+}
+
+/**
+ * @brief The number of elements.
+ */
+template<class T>
+std::size_t mmap_vector<T>::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief Checks whether the container is empty.
+ */
+template<class T>
+bool mmap_vector<T>::empty() const
+{
+    return m_size == 0;
+}
+
+/**
+ * @brief Checks whether the elements are stored in the file.
+ */
+template<class T>
+bool mmap_vector<T>::is_file_backed() const
+{
+    return m_fd >= 0;
+}
+
+/**
+ * @brief Checks whether the mapping is read only.
+ */
+template<class T>
+bool mmap_vector<T>::is_read_only() const
+{
+    return m_read_only;
+}
+
+/**
+* @brief Begin iterator.
+*/
+template<class T>
+typename mmap_vector<T>::iterator mmap_vector<T>::begin()
+{
+    return iterator(data_ptr());
+}
+
+/**
+ * @brief Const begin iterator.
+ */
+template<class T>
+typename mmap_vector<T>::iterator mmap_vector<T>::cbegin() const
+{
+    return iterator(data_ptr());
+}
+
+/**
+ * @brief End iterator.
+ */
+template<class T>
+typename mmap_vector<T>::iterator mmap_vector<T>::end()
+{
+    return iterator(data_ptr()+m_size);
+}
+
+/**
+ * @brief Const end iterator.
+ */
+template<class T>
+typename mmap_vector<T>::iterator mmap_vector<T>::cend() const
+{
+    return iterator(data_ptr()+m_size);
+}
+
+/**
+ * @brief Get a first element from the array.
+ */
+template<class T>
+T& mmap_vector<T>::front()
+{
+    return data_ptr()[0];
+}
+
+/**
+ * @brief Get a back element from the array.
+ */
+template<class T>
+T& mmap_vector<T>::back()
+{
+    return data_ptr()[m_size-1];
+}
+
+/**
+ * @brief Pointer to the first element in the mapping.
+ */
+template<class T>
+T* mmap_vector<T>::data()
+{
+    return data_ptr();
+}
+
+/**
+ * @brief Const pointer to the first element in the mapping.
+ */
+template<class T>
+const T* mmap_vector<T>::data() const
+{
+    return data_ptr();
+}
+
+/**
+ * @brief Adds an element to the end.
+ *        If no space to add an element, then the mapping is doubled by mremap.
+ */
+template<class T>
+void mmap_vector<T>::push_back(const T& data)
+{
+    assert(!m_read_only && "mmap_vector error: the mapping is read only");
+    if(m_size >= m_cap)
+    {
+        // data may refer into the mapping which can be moved
+        T tmp(data);
+        reserve(m_cap ? m_cap*2 : 1);
+        std::memcpy(static_cast<void*>(data_ptr()+m_size), &tmp, sizeof(T));
+    }
+    else
+    {
+        std::memcpy(static_cast<void*>(data_ptr()+m_size), &data, sizeof(T));
+    }
+    ++m_size;
+}
+
+/**
+ * @brief Removes the last element of the container.
+ */
+template<class T>
+void mmap_vector<T>::pop_back()
+{
+    assert(!m_read_only && "mmap_vector error: the mapping is read only");
+    --m_size;
+}
+
+/**
+ * @brief Increases the capacity of the container to a value greater or equal to cap.
+ *        The file is extended by ftruncate, the mapping is extended by mremap,
+ *        the elements are not copied.
+ * @param cap new capacity of the container.
+ */
+template<class T>
+void mmap_vector<T>::reserve(std::size_t cap)
+{
+    assert(!m_read_only && "mmap_vector error: the mapping is read only");
+    if(cap <= m_cap){
+        return;
+    }
+    std::size_t length = round_to_page(MMAP_HEADER_SIZE + cap*sizeof(T));
+    if(m_base == nullptr){
+        map(length);
+    }
+    else{
+        remap(length);
+    }
+}
+
+/**
+ * @brief Sets the size of the container, the new elements are zero filled.
+ * @param size new container size.
+ */
+template<class T>
+void mmap_vector<T>::resize(std::size_t size)
+{
+    assert(!m_read_only && "mmap_vector error: the mapping is read only");
+    if(size > m_size){
+        reserve(size);
+        std::memset(static_cast<void*>(data_ptr()+m_size), 0, (size-m_size)*sizeof(T));
+    }
+    m_size = size;
+}
+
+/**
+ * @brief Remove elements from the container, the mapping is kept.
+ */
+template<class T>
+void mmap_vector<T>::clear()
+{
+    assert(!m_read_only && "mmap_vector error: the mapping is read only");
+    m_size = 0;
+}
+
+/**
+ * @brief Stores the size in the header and writes the mapping to the file with msync.
+ * @param async MS_ASYNC is used if true, the call waits for the writing otherwise.
+ */
+template<class T>
+void mmap_vector<T>::flush(bool async)
+{
+    if(m_base == nullptr || m_fd < 0 || m_read_only){
+        return;
+    }
+    header()->m_size = m_size;
+    if(::msync(m_base, m_length, async ? MS_ASYNC : MS_SYNC) != 0){
+        throw_errno("mmap_vector error: msync failed");
+    }
+}
+
+/**
+ * @brief Stores the size in the header and writes the pages of the elements
+ *        [first, first+count) and the header to the file with msync.
+ * @param first Index of the first element.
+ * @param count The number of elements.
+ * @param async MS_ASYNC is used if true, the call waits for the writing otherwise.
+ */
+template<class T>
+void mmap_vector<T>::flush(std::size_t first, std::size_t count, bool async)
+{
+    if(m_base == nullptr || m_fd < 0 || m_read_only || count == 0){
+        return;
+    }
+    assert((first+count <= m_size) && "mmap_vector error: flush range out of range");
+    header()->m_size = m_size;
+    int flags = async ? MS_ASYNC : MS_SYNC;
+    if(::msync(m_base, page_size(), flags) != 0){
+        throw_errno("mmap_vector error: msync failed");
+    }
+    std::size_t begin = MMAP_HEADER_SIZE + first*sizeof(T);
+    std::size_t end = begin + count*sizeof(T);
+    begin = begin / page_size() * page_size();
+    if(::msync(m_base + begin, end - begin, flags) != 0){
+        throw_errno("mmap_vector error: msync failed");
+    }
+}
+
+/**
+ * @brief Operator array subscripting.
+ */
+template<class T>
+T& mmap_vector<T>::operator[](std::size_t index)
+{
+    return data_ptr()[index];
+}
+
+/**
+ * @brief Constant operator array subscripting
+ */
+template<class T>
+const T& mmap_vector<T>::operator[](std::size_t index) const
+{
+    return data_ptr()[index];
+}
+
+/**
+ * @brief The size of the memory page.
+ */
+template<class T>
+std::size_t mmap_vector<T>::page_size()
+{
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+/**
+ * @brief Rounds the bytes up to the whole pages.
+ */
+template<class T>
+std::size_t mmap_vector<T>::round_to_page(std::size_t bytes)
+{
+    return (bytes + page_size()-1) / page_size() * page_size();
+}
+
+/**
+ * @brief Throws std::system_error with the errno value.
+ */
+template<class T>
+void mmap_vector<T>::throw_errno(const char* what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+/**
+ * @brief Pointer to the elements, they start after the header.
+ */
+template<class T>
+T* mmap_vector<T>::data_ptr() const
+{
+    return reinterpret_cast<T*>(m_base + MMAP_HEADER_SIZE);
+}
+
+/**
+ * @brief Pointer to the header at the beginning of the mapping.
+ */
+template<class T>
+mmap_header* mmap_vector<T>::header() const
+{
+    return reinterpret_cast<mmap_header*>(m_base);
+}
+
+/**
+ * @brief Creates the mapping of length bytes, the file is extended if needed.
+ */
+template<class T>
+void mmap_vector<T>::map(std::size_t length)
+{
+    void* addr = nullptr;
+    if(m_fd >= 0){
+        if(!m_read_only && ::ftruncate(m_fd, static_cast<off_t>(length)) != 0){
+            throw_errno("mmap_vector error: unable to extend the file");
+        }
+        int prot = m_read_only ? PROT_READ : (PROT_READ | PROT_WRITE);
+        addr = ::mmap(nullptr, length, prot, MAP_SHARED, m_fd, 0);
+    }
+    else{
+        addr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if(addr == MAP_FAILED){
+        throw_errno("mmap_vector error: mmap failed");
+    }
+    m_base = static_cast<char*>(addr);
+    m_length = length;
+    m_cap = (length - MMAP_HEADER_SIZE) / sizeof(T);
+}
+
+/**
+ * @brief Extends the mapping to length bytes with mremap, the mapping may be moved.
+ */
+template<class T>
+void mmap_vector<T>::remap(std::size_t length)
+{
+    if(m_fd >= 0 && ::ftruncate(m_fd, static_cast<off_t>(length)) != 0){
+        throw_errno("mmap_vector error: unable to extend the file");
+    }
+    void* addr = ::mremap(m_base, m_length, length, MREMAP_MAYMOVE);
+    if(addr == MAP_FAILED){
+        throw_errno("mmap_vector error: mremap failed");
+    }
+    m_base = static_cast<char*>(addr);
+    m_length = length;
+    m_cap = (length - MMAP_HEADER_SIZE) / sizeof(T);
+}
+
+/**
+ * @brief Stores the size in the header, unmaps and closes the file
+ *        truncated to the used length.
+ */
+template<class T>
+void mmap_vector<T>::close()
+{
+    if(m_base != nullptr){
+        if(m_fd >= 0 && !m_read_only){
+            header()->m_size = m_size;
+        }
+        ::munmap(m_base, m_length);
+        m_base = nullptr;
+    }
+    if(m_fd >= 0){
+        if(!m_read_only){
+            // The error is ignored, the file is still valid with the tail
+            int res = ::ftruncate(m_fd, static_cast<off_t>(MMAP_HEADER_SIZE + m_size*sizeof(T)));
+            (void)res;
+        }
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_length = 0;
+    m_size = 0;
+    m_cap = 0;
+}
+
+}
+
+#endif //MMAP_VECTOR_H
@@ -0,0 +1,166 @@
+#ifndef MMAP_VECTOR_TESTS_H
+#define MMAP_VECTOR_TESTS_H
+
+#include <iostream>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "mmap_vector.h"
+
+namespace mmap_vector_testing {
+const std::size_t num_of_elements = 1000001;
+const int module = 1000000;
+
+/**
+ * @brief POD record stored in the file
+ */
+struct Record
+{
+    std::uint64_t m_id;
+    double m_value;
+    char m_tag[16];
+};
+
+/**
+ * @brief temp_path - creates the unique temporary file name
+ * @return the path of the file, the file doesn't exist
+ */
+inline std::string temp_path()
+{
+    char name[] = "/tmp/scl_mmap_vector_XXXXXX";
+    int fd = ::mkstemp(name);
+    ::close(fd);
+    ::unlink(name);
+    return std::string(name);
+}
+
+class MmapVectorFileFixture: public ::testing::Test
+{
+public:
+    std::string path;
+
+    static void SetUpTestSuite() {std::cout << "Set Up Test Suite" << "\n";}
+    static void TearDownTestSuite() {std::cout << "Tear Down Test Suite" << "\n";}
+
+protected:
+
+    void SetUp() override
+    {
+        path = temp_path();
+    }
+
+    void TearDown() override
+    {
+        ::unlink(path.c_str());
+    }
+};
+
+TEST(CheckMmapVector, CheckAnonymous)
+{
+    //Arrange
+    scl::mmap_vector<int> vec;
+    //Act
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        vec.push_back(static_cast<int>(i % module));
+    }
+    //Assert
+    ASSERT_FALSE(vec.is_file_backed());
+    ASSERT_EQ(vec.size(), num_of_elements);
+    ASSERT_GE(vec.capacity(), num_of_elements);
+    std::size_t i = 0;
+    for(auto it = vec.begin(); it != vec.end(); ++it, ++i)
+    {
+        ASSERT_EQ(*it, static_cast<int>(i % module));
+    }
+    vec.pop_back();
+    ASSERT_EQ(vec.back(), static_cast<int>((num_of_elements-2) % module));
+    vec.clear();
+    ASSERT_TRUE(vec.empty());
+}
+
+TEST_F(MmapVectorFileFixture, CheckReopen)
+{
+    //Arrange
+    {
+        scl::mmap_vector<Record> vec(path);
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            Record rec{i, static_cast<double>(i)/2, "record"};
+            vec.push_back(rec);
+        }
+        vec.flush(0, 10);
+        vec.flush(true);
+    }
+    //Act
+    scl::mmap_vector<Record> reopened(path);
+    reopened.push_back(Record{num_of_elements, 0.0, "last"});
+    scl::mmap_vector<Record> moved(std::move(reopened));
+    //Assert
+    ASSERT_TRUE(moved.is_file_backed());
+    ASSERT_EQ(moved.size(), num_of_elements+1);
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        ASSERT_EQ(moved[i].m_id, i);
+        ASSERT_EQ(moved[i].m_value, static_cast<double>(i)/2);
+    }
+    ASSERT_EQ(std::string(moved.back().m_tag), "last");
+}
+
+TEST_F(MmapVectorFileFixture, CheckReadOnly)
+{
+    //Arrange
+    {
+        scl::mmap_vector<std::uint64_t> vec(path);
+        vec.resize(num_of_elements);
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            vec[i] = i*i;
+        }
+    }
+    //Act
+    scl::mmap_vector<std::uint64_t> view(path, true);
+    //Assert
+    ASSERT_TRUE(view.is_read_only());
+    ASSERT_EQ(view.size(), num_of_elements);
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        ASSERT_EQ(view[i], i*i);
+    }
+    ASSERT_THROW(scl::mmap_vector<Record> wrong(path, true), std::runtime_error);
+    ASSERT_THROW(scl::mmap_vector<Record> missing(path + ".missing", true), std::system_error);
+}
+
+TEST_F(MmapVectorFileFixture, CheckForeignFile)
+{
+    //Arrange
+    const std::string text(100, 'x');
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        std::fwrite(text.data(), 1, text.size(), file);
+        std::fclose(file);
+    }
+    //Act
+    //Assert
+    ASSERT_THROW(scl::mmap_vector<std::uint64_t> vec(path), std::runtime_error);
+    ASSERT_THROW(scl::mmap_vector<std::uint64_t> view(path, true), std::runtime_error);
+    struct stat st;
+    ASSERT_EQ(::stat(path.c_str(), &st), 0);
+    ASSERT_EQ(static_cast<std::size_t>(st.st_size), text.size());
+    std::string content(text.size(), '\0');
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fread(&content[0], 1, content.size(), file), content.size());
+    std::fclose(file);
+    ASSERT_EQ(content, text);
+}
+
+}
+
+#endif //MMAP_VECTOR_TESTS_H
@@ -0,0 +1,445 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <cassert>
+#include <new>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <type_traits>
+#include "aligned_allocator.h"
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#endif
+
+/**
+ * @brief MPMC_QUEUE_MIN_CAPACITY - the smallest capacity of the queue, the power of two
+ * @brief MPMC_QUEUE_SPIN_COUNT - the attempts of the blocking push/pop before the thread sleeps on the futex
+ */
+constexpr std::size_t MPMC_QUEUE_MIN_CAPACITY = 2U;
+constexpr std::size_t MPMC_QUEUE_SPIN_COUNT = 64U;
+static_assert((MPMC_QUEUE_MIN_CAPACITY & (MPMC_QUEUE_MIN_CAPACITY - 1)) == 0, "MPMC queue error: the minimal capacity must be the power of two");
+
+// Sequence containers library)
+namespace scl {
+
+namespace detail {
+
+/**
+ * @brief The hint to the core in the spin loop, the pause of x86.
+ */
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+/**
+ * @brief Sleeps while word is expected, the spurious wake-ups are possible.
+ *        Without the futex the thread only yields, the caller retries anyway.
+ */
+inline void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected)
+{
+#if defined(__linux__)
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "MPMC queue error: the futex word must be 32 bit");
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)expected;
+    std::this_thread::yield();
+#endif
+}
+
+/**
+ * @brief Wakes up to count threads sleeping on word.
+ */
+inline void futex_wake(std::atomic<std::uint32_t>& word, int count)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)count;
+#endif
+}
+
+/**
+ * @brief The heavy side of the asymmetric fence: the full barrier on every running thread
+ *        of the process, so the light side needs only the compiler barrier.
+ * @return False if the barrier was not run.
+ */
+inline bool membarrier()
+{
+#if defined(__linux__) && defined(SYS_membarrier)
+    return syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Registers the process for the private expedited membarrier once and runs it once,
+ *        false if the kernel doesn't support it.
+ */
+inline bool membarrier_available()
+{
+#if defined(__linux__) && defined(SYS_membarrier)
+    static const bool available = syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0 && membarrier();
+    return available;
+#else
+    return false;
+#endif
+}
+
+}
+
+/**
+ * Multiple producer multiple consumer queue
+ * @brief The bounded lock-free queue of D. Vyukov: the array of the power of two size,
+ *        every cell has the sequence number. The cell of the position pos is free for the push
+ *        when its sequence is pos and holds the element for the pop when its sequence is pos + 1,
+ *        the pop sets it to pos + capacity() for the next lap. The producers claim the position
+ *        by compare_exchange of m_enqueue_pos, the consumers of m_dequeue_pos, the element is
+ *        published by the release store of the sequence, so the threads never wait for each other
+ *        except the one at the same cell.
+ *        push() and pop() block: they try MPMC_QUEUE_SPIN_COUNT times and then sleep on the futex,
+ *        the first success of the opposite side after that wakes all the sleepers of the side,
+ *        so the syscall is made once per sleep, not once per element.
+ *        Off Linux there is no futex and no membarrier: the blocked thread yields between the retries.
+ *        The success pays no fence for the check of the sleepers: the sleeper pays
+ *        for both sides by membarrier() before it sleeps, see light_fence().
+ *        T must be nothrow move constructible and assignable, the claimed cell is never left empty.
+ *        The object is over-aligned, it is not allocated by new before C++17.
+ */
+template<class T>
+class mpmc_queue
+{
+    static_assert(std::is_nothrow_move_constructible<T>::value, "MPMC queue error: the type must be nothrow move constructible");
+    static_assert(std::is_nothrow_move_assignable<T>::value, "MPMC queue error: the type must be nothrow move assignable");
+
+private:
+    struct cell
+    {
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    alignas(CACHE_LINE_SIZE) cell* m_cells;
+    std::size_t m_mask;
+    std::atomic<bool> m_asymmetric;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_enqueue_pos;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_dequeue_pos;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> m_push_epoch;
+    std::atomic<std::uint32_t> m_pop_sleepers;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> m_pop_epoch;
+    std::atomic<std::uint32_t> m_push_sleepers;
+
+    static std::size_t s_ceil_pow2(std::size_t n);
+    static T* value(cell& slot);
+    void light_fence() const;
+    bool heavy_fence();
+    void notify(std::atomic<std::uint32_t>& epoch, std::atomic<std::uint32_t>& sleepers);
+
+public:
+    explicit mpmc_queue(std::size_t capacity);
+    ~mpmc_queue();
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    std::size_t capacity() const noexcept;
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    bool try_push(const T& val);
+    bool try_push(T&& val);
+    bool try_pop(T& val);
+
+    void push(const T& val);
+    void push(T&& val);
+    void pop(T& val);
+};
+
+/**
+ * @brief The smallest power of two not less than n and MPMC_QUEUE_MIN_CAPACITY.
+ */
+template<class T>
+std::size_t mpmc_queue<T>::s_ceil_pow2(std::size_t n)
+{
+    std::size_t power = MPMC_QUEUE_MIN_CAPACITY;
+    while(power < n)
+    {
+        power *= 2;
+    }
+    return power;
+}
+
+template<class T>
+T* mpmc_queue<T>::value(cell& slot)
+{
+    return reinterpret_cast<T*>(&slot.storage);
+}
+
+/**
+ * @brief Orders the published cell before the load of sleepers on the fast path.
+ *        With membarrier the compiler barrier is enough, heavy_fence() of the sleeper
+ *        runs the full barrier on this thread if it is between the two.
+ *        Without membarrier it is the seq_cst fence.
+ */
+template<class T>
+void mpmc_queue<T>::light_fence() const
+{
+    if(m_asymmetric.load(std::memory_order_relaxed)){
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+    else{
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+/**
+ * @brief Orders the registration of the sleeper before its retry
+ *        and pairs with light_fence() of every other thread.
+ *        If membarrier() fails, the queue falls back to the seq_cst fence on both sides.
+ * @return False if membarrier() failed: the other threads may have skipped the fence,
+ *         so the caller must not sleep until the next retry.
+ */
+template<class T>
+bool mpmc_queue<T>::heavy_fence()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(!m_asymmetric.load(std::memory_order_relaxed) || detail::membarrier()){
+        return true;
+    }
+    m_asymmetric.store(false, std::memory_order_relaxed);
+    return false;
+}
+
+/**
+ * @brief Wakes the threads sleeping on epoch after the success of the opposite side.
+ *        The fences order the published cell before the load of sleepers and the registration
+ *        of the sleeper before its retry, so either the sleeper sees the cell or the cell owner
+ *        sees the sleeper.
+ *        The registrations are taken by the exchange, the woken threads register again.
+ */
+template<class T>
+void mpmc_queue<T>::notify(std::atomic<std::uint32_t>& epoch, std::atomic<std::uint32_t>& sleepers)
+{
+    light_fence();
+    if(sleepers.load(std::memory_order_relaxed) != 0 && sleepers.exchange(0, std::memory_order_relaxed) != 0){
+        epoch.fetch_add(1, std::memory_order_release);
+        detail::futex_wake(epoch, INT_MAX);
+    }
+}
+
+/**
+ * @brief Constructor, the capacity is rounded up to the power of two.
+ */
+template<class T>
+mpmc_queue<T>::mpmc_queue(std::size_t capacity)
+    :m_cells(nullptr)
+    ,m_mask(s_ceil_pow2(capacity) - 1)
+    ,m_asymmetric(detail::membarrier_available())
+    ,m_enqueue_pos(0)
+    ,m_dequeue_pos(0)
+    ,m_push_epoch(0)
+    ,m_pop_sleepers(0)
+    ,m_pop_epoch(0)
+    ,m_push_sleepers(0)
+{
+    m_cells = new cell[m_mask + 1];
+    for(std::size_t pos = 0; pos <= m_mask; ++pos)
+    {
+        m_cells[pos].sequence.store(pos, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Destructor, the elements left in the queue are destroyed. No thread may use the queue.
+ */
+template<class T>
+mpmc_queue<T>::~mpmc_queue()
+{
+    const std::size_t end = m_enqueue_pos.load(std::memory_order_acquire);
+    for(std::size_t pos = m_dequeue_pos.load(std::memory_order_acquire); pos != end; ++pos)
+    {
+        value(m_cells[pos & m_mask])->~T();
+    }
+    delete[] m_cells;
+}
+
+template<class T>
+std::size_t mpmc_queue<T>::capacity() const noexcept
+{
+    return m_mask + 1;
+}
+
+/**
+ * @brief The snapshot of the number of the elements, the claimed cells are counted.
+ */
+template<class T>
+std::size_t mpmc_queue<T>::size() const noexcept
+{
+    const std::size_t dequeue_pos = m_dequeue_pos.load(std::memory_order_acquire);
+    const std::size_t enqueue_pos = m_enqueue_pos.load(std::memory_order_acquire);
+    return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+}
+
+template<class T>
+bool mpmc_queue<T>::empty() const noexcept
+{
+    return size() == 0;
+}
+
+/**
+ * @brief Inserts the copy of val, false if the queue is full.
+ *        The copy is made before the cell is claimed.
+ */
+template<class T>
+bool mpmc_queue<T>::try_push(const T& val)
+{
+    return try_push(T(val));
+}
+
+/**
+ * @brief Inserts val by move, false if the queue is full, then val is not moved.
+ */
+template<class T>
+bool mpmc_queue<T>::try_push(T&& val)
+{
+    std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    cell* slot = nullptr;
+    for(;;)
+    {
+        slot = &m_cells[pos & m_mask];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const std::intptr_t lap = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+        if(lap == 0){
+            if(m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                break;
+            }
+        }
+        else if(lap < 0){
+            return false;
+        }
+        else{
+            pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    ::new(static_cast<void*>(&slot->storage)) T(std::move(val));
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    notify(m_push_epoch, m_pop_sleepers);
+    return true;
+}
+
+/**
+ * @brief Moves the first element to val and removes it, false if the queue is empty.
+ */
+template<class T>
+bool mpmc_queue<T>::try_pop(T& val)
+{
+    std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    cell* slot = nullptr;
+    for(;;)
+    {
+        slot = &m_cells[pos & m_mask];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const std::intptr_t lap = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+        if(lap == 0){
+            if(m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                break;
+            }
+        }
+        else if(lap < 0){
+            return false;
+        }
+        else{
+            pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    T* item = value(*slot);
+    val = std::move(*item);
+    item->~T();
+    slot->sequence.store(pos + m_mask + 1, std::memory_order_release);
+    notify(m_pop_epoch, m_push_sleepers);
+    return true;
+}
+
+/**
+ * @brief Inserts the copy of val, waits while the queue is full.
+ */
+template<class T>
+void mpmc_queue<T>::push(const T& val)
+{
+    push(T(val));
+}
+
+/**
+ * @brief Inserts val by move, spins and then sleeps on the futex while the queue is full.
+ *        The epoch is read before the registration, so the pop after the retry changes it
+ *        and the futex does not sleep. The registration left by the successful retry
+ *        costs one spurious wake-up at most.
+ */
+template<class T>
+void mpmc_queue<T>::push(T&& val)
+{
+    for(std::size_t spin = 0; spin < MPMC_QUEUE_SPIN_COUNT; ++spin)
+    {
+        if(try_push(std::move(val))){
+            return;
+        }
+        detail::cpu_relax();
+    }
+    for(;;)
+    {
+        const std::uint32_t epoch = m_pop_epoch.load(std::memory_order_acquire);
+        m_push_sleepers.fetch_add(1, std::memory_order_relaxed);
+        const bool ordered = heavy_fence();
+        if(try_push(std::move(val))){
+            return;
+        }
+        if(ordered){
+            detail::futex_wait(m_pop_epoch, epoch);
+        }
+    }
+}
+
+/**
+ * @brief Moves the first element to val and removes it,
+ *        spins and then sleeps on the futex while the queue is empty.
+ */
+template<class T>
+void mpmc_queue<T>::pop(T& val)
+{
+    for(std::size_t spin = 0; spin < MPMC_QUEUE_SPIN_COUNT; ++spin)
+    {
+        if(try_pop(val)){
+            return;
+        }
+        detail::cpu_relax();
+    }
+    for(;;)
+    {
+        const std::uint32_t epoch = m_push_epoch.load(std::memory_order_acquire);
+        m_pop_sleepers.fetch_add(1, std::memory_order_relaxed);
+        const bool ordered = heavy_fence();
+        if(try_pop(val)){
+            return;
+        }
+        if(ordered){
+            detail::futex_wait(m_push_epoch, epoch);
+        }
+    }
+}
+
+}
+
+#endif //MPMC_QUEUE_H
@@ -0,0 +1,10 @@
+#include <iostream>
+#include "mpmc_queue.h"
+#include "tests.h"
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
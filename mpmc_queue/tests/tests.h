@@ -0,0 +1,206 @@
+#ifndef MPMC_QUEUE_TESTS_H
+#define MPMC_QUEUE_TESTS_H
+
+#include <iostream>
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include "mpmc_queue.h"
+#include "test_utils.h"
+
+namespace mpmc_queue_testing {
+const std::size_t num_of_elements = 100000;
+const std::size_t queue_capacity = 1024;
+const std::size_t bench_elements = 2000000;
+const std::size_t thread_counts[] = {1, 2, 4};
+
+using scl_testing::get_wall_time_sec;
+using scl_testing::locked_deque;
+
+/**
+ * @brief Moves bench_elements numbers from producers threads to consumers threads
+ *        by the blocking push/pop, every thread takes the equal share.
+ *        Returns the sum of the received numbers.
+ */
+template<class Queue>
+std::uint64_t fan_in_out(Queue& queue, std::size_t producers, std::size_t consumers, double& time)
+{
+    std::vector<std::uint64_t> sums(consumers, 0);
+    std::vector<std::thread> threads;
+    const double start = get_wall_time_sec();
+    for(std::size_t p=0; p<producers; ++p)
+    {
+        threads.emplace_back([&queue, p, producers]
+        {
+            for(std::uint64_t val=p; val<bench_elements; val+=producers)
+            {
+                queue.push(val);
+            }
+        });
+    }
+    for(std::size_t c=0; c<consumers; ++c)
+    {
+        threads.emplace_back([&queue, &sums, c, consumers]
+        {
+            std::uint64_t val = 0, sum = 0;
+            for(std::size_t i=0; i<bench_elements/consumers; ++i)
+            {
+                queue.pop(val);
+                sum += val;
+            }
+            sums[c] = sum;
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    time = get_wall_time_sec() - start;
+    std::uint64_t sum = 0;
+    for(std::uint64_t part : sums)
+    {
+        sum += part;
+    }
+    return sum;
+}
+
+TEST(CheckMpmcQueue, SingleThreadWrapAround)
+{
+    //Arrange
+    scl::mpmc_queue<std::string> queue(100);
+    std::string val;
+    //Act
+    std::size_t pushed = 0;
+    while(queue.try_push(std::to_string(pushed)))
+    {
+        ++pushed;
+    }
+    //Assert
+    ASSERT_EQ(queue.capacity(), 128U);
+    ASSERT_EQ(pushed, 128U);
+    ASSERT_EQ(queue.size(), 128U);
+    std::string rejected = "rejected";
+    ASSERT_FALSE(queue.try_push(std::move(rejected)));
+    ASSERT_EQ(rejected, "rejected");
+    std::size_t popped = 0;
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        ASSERT_TRUE(queue.try_pop(val));
+        ASSERT_EQ(val, std::to_string(popped++));
+        queue.push(std::to_string(pushed++));
+    }
+    for(std::size_t i=0; i<128; ++i)
+    {
+        queue.pop(val);
+        ASSERT_EQ(val, std::to_string(popped++));
+    }
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.try_pop(val));
+    queue.push("left for the destructor");
+}
+
+TEST(CheckMpmcQueue, ManyProducersAndConsumers)
+{
+    //Arrange
+    const std::size_t producers = 4, consumers = 3, per_producer = num_of_elements;
+    scl::mpmc_queue<std::uint64_t> queue(64);
+    std::vector<std::vector<std::uint64_t>> received(consumers);
+    std::vector<std::thread> threads;
+    //Act
+    for(std::size_t p=0; p<producers; ++p)
+    {
+        threads.emplace_back([&queue, p, per_producer]
+        {
+            for(std::uint64_t i=0; i<per_producer; ++i)
+            {
+                const std::uint64_t val = p*per_producer + i;
+                if(i % 2 == 0){
+                    queue.push(val);
+                }
+                else{
+                    while(!queue.try_push(val))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        });
+    }
+    for(std::size_t c=0; c<consumers; ++c)
+    {
+        threads.emplace_back([&queue, &received, c, consumers, producers, per_producer]
+        {
+            const std::size_t share = producers*per_producer/consumers + (c == 0 ? producers*per_producer%consumers : 0);
+            std::uint64_t val = 0;
+            while(received[c].size() < share)
+            {
+                if(received[c].size() % 3 == 0){
+                    queue.pop(val);
+                }
+                else if(!queue.try_pop(val)){
+                    std::this_thread::yield();
+                    continue;
+                }
+                received[c].push_back(val);
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    //Assert
+    ASSERT_TRUE(queue.empty());
+    std::vector<std::uint64_t> all;
+    for(const std::vector<std::uint64_t>& part : received)
+    {
+        std::vector<std::uint64_t> last(producers, 0);
+        std::vector<bool> seen(producers, false);
+        for(std::uint64_t val : part)
+        {
+            const std::size_t p = val / per_producer;
+            ASSERT_TRUE(!seen[p] || last[p] < val);
+            seen[p] = true;
+            last[p] = val;
+        }
+        all.insert(all.end(), part.begin(), part.end());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(all.size(), producers*per_producer);
+    for(std::size_t i=0; i<all.size(); ++i)
+    {
+        ASSERT_EQ(all[i], i);
+    }
+}
+
+TEST(CompareMpmcQueue, ProducersConsumersMatrix)
+{
+    const std::uint64_t expected = static_cast<std::uint64_t>(bench_elements) * (bench_elements - 1) / 2;
+    std::cout << bench_elements << " elements, blocking push/pop, mpmc_queue of " << queue_capacity
+              << " / mutex scl::deque, hardware threads " << std::thread::hardware_concurrency() << "\n";
+    for(std::size_t producers : thread_counts)
+    {
+        for(std::size_t consumers : thread_counts)
+        {
+            double queue_time = 0, locked_time = 0;
+            {
+                scl::mpmc_queue<std::uint64_t> queue(queue_capacity);
+                ASSERT_EQ(fan_in_out(queue, producers, consumers, queue_time), expected);
+            }
+            {
+                locked_deque<std::uint64_t> locked;
+                ASSERT_EQ(fan_in_out(locked, producers, consumers, locked_time), expected);
+            }
+            std::cout << producers << " producers x " << consumers << " consumers: mpmc_queue "
+                      << queue_time << " s, mutex scl::deque " << locked_time << " s\n";
+        }
+    }
+}
+
+}
+
+#endif //MPMC_QUEUE_TESTS_H
@@ -0,0 +1,447 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <utility>
+#include <type_traits>
+#include "vector.h"
+
+// Sequence containers library)
+namespace scl {
+/**
+ * Parallel algorithms over the contiguous storage of scl::vector.
+ * @brief The input is statically partitioned into one chunk per thread of the pool,
+ *        the calling thread processes a chunk too.
+ *        The algorithms must not be called from the tasks of the same pool.
+ */
+namespace parallel {
+
+// The smallest chunk worth handing to the other thread
+const std::size_t MIN_CHUNK_SIZE = 4096;
+// The stride of the first touch, the smallest page size
+const std::size_t FIRST_TOUCH_PAGE_SIZE = 4096;
+
+/**
+ * @brief Fixed size thread pool.
+ *        A pool of size n runs n-1 workers, the thread calling run() is the n-th one.
+ */
+class thread_pool
+{
+private:
+    scl::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop = false;
+
+    void worker();
+
+public:
+    explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency());
+    ~thread_pool();
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    std::size_t size() const;
+
+    template<class F>
+    void submit(F&& task);
+    template<class F>
+    void run(std::size_t n, F fn);
+};
+
+/**
+ * @brief Ctor, starts threads-1 workers.
+ * @param threads The parallelism of the pool, 0 is treated as 1.
+ */
+inline thread_pool::thread_pool(std::size_t threads)
+{
+    for(std::size_t i=1; i<threads; ++i)
+    {
+        m_workers.emplace_back(&thread_pool::worker, this);
+    }
+}
+
+/**
+ * @brief Dtor, finishes the queued tasks and joins the workers.
+ */
+inline thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for(std::thread& thread : m_workers)
+    {
+        thread.join();
+    }
+}
+
+/**
+ * @brief The number of the threads running the tasks, the caller included.
+ */
+inline std::size_t thread_pool::size() const
+{
+    return m_workers.size() + 1;
+}
+
+/**
+ * @brief The worker loop, takes the tasks until the pool is stopped and drained.
+ */
+inline void thread_pool::worker()
+{
+    for(;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]{return m_stop || !m_tasks.empty();});
+            if(m_tasks.empty()){
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+/**
+ * @brief Queues the task for the workers.
+ *        The task runs on the caller if the pool has no workers.
+ */
+template<class F>
+void thread_pool::submit(F&& task)
+{
+    if(m_workers.empty())
+    {
+        task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.emplace_back(std::forward<F>(task));
+    }
+    m_cv.notify_one();
+}
+
+/**
+ * @brief Runs fn(0), ..., fn(n-1) on the pool and waits for them.
+ *        fn(0) runs on the calling thread. The first exception is rethrown
+ *        after all the calls are finished.
+ */
+template<class F>
+void thread_pool::run(std::size_t n, F fn)
+{
+    if(n == 0){
+        return;
+    }
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    std::size_t remaining = n;
+    std::exception_ptr error;
+
+    auto call = [&](std::size_t i)
+    {
+        try{
+            fn(i);
+        }
+        catch(...){
+            std::lock_guard<std::mutex> lock(done_mutex);
+            if(!error) error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(done_mutex);
+        if(--remaining == 0) done_cv.notify_one();
+    };
+
+    for(std::size_t i=1; i<n; ++i)
+    {
+        submit([&call, i]{call(i);});
+    }
+    call(0);
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done_cv.wait(lock, [&]{return remaining == 0;});
+    if(error){
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief The pool shared by the overloads without the pool parameter.
+ */
+inline thread_pool& default_pool()
+{
+    static thread_pool pool;
+    return pool;
+}
+
+/**
+ * @brief The number of the chunks for n elements: one per thread,
+ *        but none smaller than MIN_CHUNK_SIZE.
+ */
+inline std::size_t chunk_count(const thread_pool& pool, std::size_t n)
+{
+    return std::max<std::size_t>(1, std::min(pool.size(), n / MIN_CHUNK_SIZE));
+}
+
+/**
+ * @brief Calls fn(chunk, first, last) for every chunk of [0, n) on the pool.
+ * @return The number of the chunks.
+ */
+template<class F>
+std::size_t for_chunks(thread_pool& pool, std::size_t n, F fn)
+{
+    const std::size_t chunks = chunk_count(pool, n);
+    pool.run(chunks, [&](std::size_t c)
+    {
+        fn(c, n*c/chunks, n*(c+1)/chunks);
+    });
+    return chunks;
+}
+
+/**
+ * @brief Applies f to every element.
+ */
+template<class T, class Allocator, class GrowthPolicy, class F>
+void for_each(thread_pool& pool, vector<T, Allocator, GrowthPolicy>& vec, F f)
+{
+    T* data = vec.data();
+    for_chunks(pool, vec.size(), [&](std::size_t, std::size_t first, std::size_t last)
+    {
+        std::for_each(data+first, data+last, f);
+    });
+}
+
+/**
+ * @brief Stores op(in[i]) to out[i], out is resized to the size of in.
+ */
+template<class T, class A1, class G1, class U, class A2, class G2, class UnaryOp>
+void transform(thread_pool& pool, const vector<T, A1, G1>& in, vector<U, A2, G2>& out, UnaryOp op)
+{
+    out.resize(in.size());
+    const T* src = in.data();
+    U* dest = out.data();
+    for_chunks(pool, in.size(), [&](std::size_t, std::size_t first, std::size_t last)
+    {
+        std::transform(src+first, src+last, dest+first, op);
+    });
+}
+
+/**
+ * @brief Folds the elements with op, starting from init.
+ *        op must be associative, the chunk results are combined in order.
+ */
+template<class T, class Allocator, class GrowthPolicy, class BinaryOp = std::plus<T>>
+T reduce(thread_pool& pool, const vector<T, Allocator, GrowthPolicy>& vec, T init, BinaryOp op = BinaryOp())
+{
+    const T* data = vec.data();
+    const std::size_t n = vec.size();
+    if(n == 0){
+        return init;
+    }
+    scl::vector<T> partial(chunk_count(pool, n));
+    for_chunks(pool, n, [&](std::size_t c, std::size_t first, std::size_t last)
+    {
+        T acc = data[first];
+        for(std::size_t i=first+1; i<last; ++i)
+        {
+            acc = op(acc, data[i]);
+        }
+        partial[c] = acc;
+    });
+    for(std::size_t c=0; c<partial.size(); ++c)
+    {
+        init = op(init, partial[c]);
+    }
+    return init;
+}
+
+/**
+ * @brief Stores the prefix folds in[0] op ... op in[i] to out[i], out is resized to the size of in.
+ *        Every chunk is scanned locally, then the carries of the previous chunks are applied.
+ *        op must be associative.
+ */
+template<class T, class A1, class G1, class A2, class G2, class BinaryOp = std::plus<T>>
+void inclusive_scan(thread_pool& pool, const vector<T, A1, G1>& in, vector<T, A2, G2>& out, BinaryOp op = BinaryOp())
+{
+    const std::size_t n = in.size();
+    out.resize(n);
+    if(n == 0){
+        return;
+    }
+    const T* src = in.data();
+    T* dest = out.data();
+    const std::size_t chunks = chunk_count(pool, n);
+    for_chunks(pool, n, [&](std::size_t, std::size_t first, std::size_t last)
+    {
+        dest[first] = src[first];
+        for(std::size_t i=first+1; i<last; ++i)
+        {
+            dest[i] = op(dest[i-1], src[i]);
+        }
+    });
+    if(chunks == 1){
+        return;
+    }
+    // The carry of the chunk c is the fold of all the chunks before it
+    scl::vector<T> carry(chunks);
+    carry[1] = dest[n/chunks - 1];
+    for(std::size_t c=2; c<chunks; ++c)
+    {
+        carry[c] = op(carry[c-1], dest[n*c/chunks - 1]);
+    }
+    for_chunks(pool, n, [&](std::size_t c, std::size_t first, std::size_t last)
+    {
+        if(c == 0){
+            return;
+        }
+        for(std::size_t i=first; i<last; ++i)
+        {
+            dest[i] = op(carry[c], dest[i]);
+        }
+    });
+}
+
+/**
+ * @brief Sorts the elements with comp.
+ *        The chunks are sorted in parallel, then merged pairwise in log2(chunks) rounds.
+ */
+template<class T, class Allocator, class GrowthPolicy, class Compare = std::less<T>>
+void sort(thread_pool& pool, vector<T, Allocator, GrowthPolicy>& vec, Compare comp = Compare())
+{
+    T* data = vec.data();
+    const std::size_t n = vec.size();
+    const std::size_t chunks = for_chunks(pool, n, [&](std::size_t, std::size_t first, std::size_t last)
+    {
+        std::sort(data+first, data+last, comp);
+    });
+    for(std::size_t width=1; width<chunks; width*=2)
+    {
+        const std::size_t pairs = (chunks + 2*width - 1) / (2*width);
+        pool.run(pairs, [&](std::size_t p)
+        {
+            const std::size_t left = p*2*width;
+            const std::size_t middle = std::min(left+width, chunks);
+            const std::size_t right = std::min(left+2*width, chunks);
+            if(middle == right){
+                return;
+            }
+            std::inplace_merge(data + n*left/chunks, data + n*middle/chunks, data + n*right/chunks, comp);
+        });
+    }
+}
+
+/**
+ * @brief Resizes vec to n elements, the new elements are set to value
+ *        by the chunks of for_chunks(pool, n). So the pages of every chunk are first touched
+ *        by the thread, which processes the same chunk in the later parallel loops,
+ *        and the NUMA policy places them on the node of this thread.
+ *        Only for the trivially copyable types, see vector::resize_uninitialized().
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void resize(thread_pool& pool, vector<T, Allocator, GrowthPolicy>& vec, std::size_t n, const T& value = T())
+{
+    const std::size_t old_size = vec.size();
+    vec.resize_uninitialized(n);
+    if(n <= old_size){
+        return;
+    }
+    T* data = vec.data();
+    for_chunks(pool, n, [&](std::size_t, std::size_t first, std::size_t last)
+    {
+        first = std::max(first, old_size);
+        if(first < last){
+            std::fill(data+first, data+last, value);
+        }
+    });
+}
+
+/**
+ * @brief Reserves the storage for cap elements and first touches its unused pages
+ *        by the chunks of for_chunks(pool, cap), one write per page.
+ *        The following resize_uninitialized() or push_back() don't fault the pages in
+ *        and the pages stay on the nodes of the threads processing the chunks.
+ *        Only for the trivially copyable types, whose storage may be written as bytes.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void reserve(thread_pool& pool, vector<T, Allocator, GrowthPolicy>& vec, std::size_t cap)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Parallel error: reserve() needs a trivially copyable type");
+    vec.reserve(cap);
+    const std::size_t size = vec.size();
+    char* bytes = reinterpret_cast<char*>(vec.data());
+    for_chunks(pool, cap, [&](std::size_t, std::size_t first, std::size_t last)
+    {
+        first = std::max(first, size);
+        if(first >= last){
+            return;
+        }
+        char* end = bytes + last*sizeof(T);
+        for(char* page = bytes + first*sizeof(T); page < end; page += FIRST_TOUCH_PAGE_SIZE)
+        {
+            *page = 0;
+        }
+        // The stride may step over the beginning of the last page
+        *(end-1) = 0;
+    });
+}
+
+/**
+ * @brief The overloads running on the default pool.
+ */
+template<class T, class Allocator, class GrowthPolicy, class F>
+void for_each(vector<T, Allocator, GrowthPolicy>& vec, F f)
+{
+    for_each(default_pool(), vec, f);
+}
+
+template<class T, class A1, class G1, class U, class A2, class G2, class UnaryOp>
+void transform(const vector<T, A1, G1>& in, vector<U, A2, G2>& out, UnaryOp op)
+{
+    transform(default_pool(), in, out, op);
+}
+
+template<class T, class Allocator, class GrowthPolicy, class BinaryOp = std::plus<T>>
+T reduce(const vector<T, Allocator, GrowthPolicy>& vec, T init, BinaryOp op = BinaryOp())
+{
+    return reduce(default_pool(), vec, init, op);
+}
+
+template<class T, class A1, class G1, class A2, class G2, class BinaryOp = std::plus<T>>
+void inclusive_scan(const vector<T, A1, G1>& in, vector<T, A2, G2>& out, BinaryOp op = BinaryOp())
+{
+    inclusive_scan(default_pool(), in, out, op);
+}
+
+template<class T, class Allocator, class GrowthPolicy, class Compare = std::less<T>>
+void sort(vector<T, Allocator, GrowthPolicy>& vec, Compare comp = Compare())
+{
+    sort(default_pool(), vec, comp);
+}
+
+template<class T, class Allocator, class GrowthPolicy>
+void resize(vector<T, Allocator, GrowthPolicy>& vec, std::size_t n, const T& value = T())
+{
+    resize(default_pool(), vec, n, value);
+}
+
+template<class T, class Allocator, class GrowthPolicy>
+void reserve(vector<T, Allocator, GrowthPolicy>& vec, std::size_t cap)
+{
+    reserve(default_pool(), vec, cap);
+}
+
+}
+}
+
+#endif //PARALLEL_H
@@ -0,0 +1,251 @@
+#ifndef PARALLEL_TESTS_H
+#define PARALLEL_TESTS_H
+
+#include <iostream>
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include "vector.h"
+#include "parallel.h"
+#include "test_timer.h"
+
+namespace parallel_testing {
+const std::size_t num_of_elements = 1000003;
+const std::size_t max_threads = 4;
+const std::size_t bench_sizes[] = {10000000, 100000000};
+const std::size_t sort_bench_size = 10000000;
+const std::size_t touch_bench_size = 20000000;
+const int module = 1000;
+
+using scl_testing::get_wall_time_sec;
+
+/**
+ * @brief get_new_time calculating the total time and setting the current time in seconds
+ * @param sum_time - summary time
+ * @param last_time - last time value
+ */
+void get_new_time(double &sum_time, double &last_time)
+{
+    sum_time += get_wall_time_sec() - last_time;
+    last_time = get_wall_time_sec();
+}
+
+class ParallelCheckFixture: public ::testing::Test
+{
+public:
+    scl::vector<std::int64_t> *vec;
+    std::vector<std::int64_t> *vec_std;
+
+    static void SetUpTestSuite() {std::cout << "Set Up Test Suite" << "\n";}
+    static void TearDownTestSuite() {std::cout << "Tear Down Test Suite" << "\n";}
+
+protected:
+
+    void SetUp() override
+    {
+        vec = new scl::vector<std::int64_t>;
+        vec_std = new std::vector<std::int64_t>;
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            std::int64_t k = std::rand() % module - module/2;
+            vec->push_back(k);
+            vec_std->push_back(k);
+        }
+    }
+
+    void TearDown() override
+    {
+        delete vec;
+        delete vec_std;
+    }
+};
+
+TEST_F(ParallelCheckFixture, CheckAlgorithms)
+{
+    for(std::size_t threads=1; threads<=max_threads; ++threads)
+    {
+        //Arrange
+        scl::parallel::thread_pool pool(threads);
+        scl::vector<std::int64_t> data(*vec);
+        scl::vector<double> halves;
+        scl::vector<std::int64_t> scan;
+        std::vector<std::int64_t> scan_std(vec_std->size());
+        std::vector<std::int64_t> sorted_std(*vec_std);
+        //Act
+        scl::parallel::for_each(pool, data, [](std::int64_t& v){v *= 2;});
+        scl::parallel::transform(pool, *vec, halves, [](std::int64_t v){return v / 2.0;});
+        std::int64_t sum = scl::parallel::reduce(pool, *vec, std::int64_t(10));
+        std::int64_t max = scl::parallel::reduce(pool, *vec, std::int64_t(-module),
+                                                 [](std::int64_t a, std::int64_t b){return std::max(a, b);});
+        scl::parallel::inclusive_scan(pool, *vec, scan);
+        std::partial_sum(vec_std->begin(), vec_std->end(), scan_std.begin());
+        scl::parallel::sort(pool, *vec);
+        std::sort(sorted_std.begin(), sorted_std.end());
+        //Assert
+        ASSERT_EQ(pool.size(), threads);
+        ASSERT_EQ(sum, std::accumulate(vec_std->begin(), vec_std->end(), std::int64_t(10)));
+        ASSERT_EQ(max, *std::max_element(vec_std->begin(), vec_std->end()));
+        ASSERT_EQ(halves.size(), vec_std->size());
+        ASSERT_EQ(scan.size(), vec_std->size());
+        for(std::size_t i=0; i<vec_std->size(); ++i)
+        {
+            ASSERT_EQ(data[i], (*vec_std)[i] * 2);
+            ASSERT_EQ(halves[i], (*vec_std)[i] / 2.0);
+            ASSERT_EQ(scan[i], scan_std[i]);
+            ASSERT_EQ((*vec)[i], sorted_std[i]);
+        }
+        std::copy(vec_std->begin(), vec_std->end(), vec->begin());
+    }
+}
+
+TEST(CheckParallel, CheckSmallAndEmpty)
+{
+    //Arrange
+    scl::parallel::thread_pool pool(4);
+    scl::vector<int> empty, small, out;
+    for(int i=5; i>0; --i)
+    {
+        small.push_back(i);
+    }
+    //Act
+    scl::parallel::sort(pool, empty);
+    scl::parallel::inclusive_scan(pool, empty, out);
+    int empty_sum = scl::parallel::reduce(pool, empty, 7);
+    scl::parallel::sort(small);
+    //Assert
+    ASSERT_EQ(empty_sum, 7);
+    ASSERT_TRUE(out.empty());
+    ASSERT_EQ(scl::parallel::reduce(small, 0), 15);
+    ASSERT_TRUE(std::is_sorted(small.begin(), small.end()));
+}
+
+TEST(CheckParallel, CheckException)
+{
+    //Arrange
+    scl::parallel::thread_pool pool(4);
+    scl::vector<int> data(num_of_elements);
+    //Act
+    //Assert
+    ASSERT_THROW(pool.run(8, [](std::size_t i){if(i == 5) throw std::runtime_error("task");}), std::runtime_error);
+    ASSERT_THROW(scl::parallel::for_each(pool, data, [](int&){throw std::logic_error("element");}), std::logic_error);
+    std::size_t calls = 0;
+    std::mutex calls_mutex;
+    pool.run(16, [&](std::size_t){std::lock_guard<std::mutex> lock(calls_mutex); ++calls;});
+    ASSERT_EQ(calls, 16U);
+}
+
+TEST(CheckParallel, CheckFirstTouch)
+{
+    //Arrange
+    scl::parallel::thread_pool pool(4);
+    scl::vector<std::int64_t> data, buffer;
+    scl::vector<char> bytes;
+    data.push_back(-1);
+    //Act
+    scl::parallel::resize(pool, data, num_of_elements, std::int64_t(7));
+    scl::parallel::reserve(pool, buffer, num_of_elements);
+    const std::int64_t* storage = buffer.data();
+    buffer.resize_uninitialized(num_of_elements);
+    scl::parallel::reserve(pool, bytes, 3*scl::parallel::FIRST_TOUCH_PAGE_SIZE + 1);
+    //Assert
+    ASSERT_EQ(data.size(), num_of_elements);
+    ASSERT_EQ(data[0], -1);
+    for(std::size_t i=1; i<num_of_elements; ++i)
+    {
+        ASSERT_EQ(data[i], 7);
+    }
+    ASSERT_EQ(buffer.size(), num_of_elements);
+    ASSERT_EQ(buffer.data(), storage);
+    ASSERT_TRUE(bytes.empty());
+    ASSERT_GE(bytes.capacity(), 3*scl::parallel::FIRST_TOUCH_PAGE_SIZE + 1);
+    scl::parallel::resize(pool, data, 10);
+    ASSERT_EQ(data.size(), 10U);
+}
+
+TEST(CompareParallel, FirstTouch)
+{
+    const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    double serial_time = 0, uninitialized_time = 0, last_time = get_wall_time_sec();
+    {
+        scl::vector<std::int64_t> data;
+        data.resize(touch_bench_size);
+        get_new_time(serial_time, last_time);
+    }
+    {
+        last_time = get_wall_time_sec();
+        scl::vector<std::int64_t> data;
+        data.resize_uninitialized(touch_bench_size);
+        get_new_time(uninitialized_time, last_time);
+    }
+    std::cout << "resize " << touch_bench_size << ": serial " << serial_time
+              << " s, uninitialized " << uninitialized_time << " s\n";
+    for(std::size_t threads=1; threads<=hardware; threads*=2)
+    {
+        scl::parallel::thread_pool pool(threads);
+        scl::vector<std::int64_t> data;
+        double resize_time = 0;
+        last_time = get_wall_time_sec();
+        scl::parallel::resize(pool, data, touch_bench_size);
+        get_new_time(resize_time, last_time);
+        std::cout << "parallel resize " << touch_bench_size << ", threads " << threads << ": " << resize_time << " s\n";
+        ASSERT_EQ(data[touch_bench_size-1], 0);
+    }
+}
+
+TEST(CompareParallel, Scaling)
+{
+    const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::cout << "hardware threads: " << hardware << "\n";
+    for(std::size_t size : bench_sizes)
+    {
+        scl::vector<std::int64_t> data(size), out;
+        for(std::size_t i=0; i<size; ++i)
+        {
+            data[i] = static_cast<std::int64_t>(i % module);
+        }
+        std::int64_t reference = 0;
+        for(std::size_t threads=1; threads<=hardware; threads*=2)
+        {
+            scl::parallel::thread_pool pool(threads);
+            double for_each_time = 0, transform_time = 0, reduce_time = 0, scan_time = 0, last_time = get_wall_time_sec();
+            scl::parallel::for_each(pool, data, [](std::int64_t& v){v += 1;});
+            get_new_time(for_each_time, last_time);
+            scl::parallel::transform(pool, data, out, [](std::int64_t v){return v * 3;});
+            get_new_time(transform_time, last_time);
+            std::int64_t sum = scl::parallel::reduce(pool, out, std::int64_t(0));
+            get_new_time(reduce_time, last_time);
+            scl::parallel::inclusive_scan(pool, data, out);
+            get_new_time(scan_time, last_time);
+            scl::parallel::for_each(pool, data, [](std::int64_t& v){v -= 1;});
+            std::cout << "size " << size << ", threads " << threads << ": for_each " << for_each_time
+                      << " transform " << transform_time << " reduce " << reduce_time
+                      << " inclusive_scan " << scan_time << " s\n";
+            if(threads == 1) reference = sum;
+            ASSERT_EQ(sum, reference);
+        }
+    }
+    scl::vector<int> input(sort_bench_size);
+    for(std::size_t i=0; i<sort_bench_size; ++i)
+    {
+        input[i] = std::rand();
+    }
+    for(std::size_t threads=1; threads<=hardware; threads*=2)
+    {
+        scl::parallel::thread_pool pool(threads);
+        scl::vector<int> data(input);
+        double sort_time = 0, last_time = get_wall_time_sec();
+        scl::parallel::sort(pool, data);
+        get_new_time(sort_time, last_time);
+        std::cout << "sort size " << sort_bench_size << ", threads " << threads << ": " << sort_time << " s\n";
+        ASSERT_TRUE(std::is_sorted(data.cbegin(), data.cend()));
+    }
+}
+
+}
+
+#endif //PARALLEL_TESTS_H
@@ -0,0 +1,814 @@
+#ifndef PERSISTENT_VECTOR_H
+#define PERSISTENT_VECTOR_H
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <new>
+#include <atomic>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+
+/**
+ * @brief PERSISTENT_VECTOR_BITS - the bits of the index consumed by one level of the trie
+ * @brief PERSISTENT_VECTOR_BRANCHING - the number of the children of the node and the elements of the leaf
+ */
+constexpr std::size_t PERSISTENT_VECTOR_BITS = 5U;
+constexpr std::size_t PERSISTENT_VECTOR_BRANCHING = std::size_t(1) << PERSISTENT_VECTOR_BITS;
+
+// Sequence containers library)
+namespace scl {
+
+template<class T>
+class persistent_vector;
+template<class T>
+class transient_vector;
+
+namespace detail {
+/**
+ * The radix balanced trie
+ * @brief The elements are stored in the leaves of PERSISTENT_VECTOR_BRANCHING elements,
+ *  the index is split into the groups of PERSISTENT_VECTOR_BITS bits, one group per level.
+ *  The last leaf (the tail) is kept out of the trie, so push_back and pop_back touch
+ *  the trie only once per PERSISTENT_VECTOR_BRANCHING elements.
+ *  The nodes are shared between the tries and counted by the atomic reference counters.
+ *  A node referenced only once belongs to this trie and is changed in place,
+ *  a shared node is copied first, so the change copies only the path from the root.
+ */
+template<class T>
+class radix_tree
+{
+private:
+    static constexpr std::size_t BITS = PERSISTENT_VECTOR_BITS;
+    static constexpr std::size_t BRANCHING = PERSISTENT_VECTOR_BRANCHING;
+    static constexpr std::size_t MASK = PERSISTENT_VECTOR_BRANCHING - 1;
+
+    struct node
+    {
+        std::atomic<std::size_t> m_refs{1};
+    };
+
+    struct inner : node
+    {
+        node* m_children[PERSISTENT_VECTOR_BRANCHING] = {};
+    };
+
+    struct leaf : node
+    {
+        std::size_t m_count = 0;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage[PERSISTENT_VECTOR_BRANCHING];
+
+        T* values() {return reinterpret_cast<T*>(m_storage);}
+        const T* values() const {return reinterpret_cast<const T*>(m_storage);}
+        ~leaf()
+        {
+            for(std::size_t i=0; i<m_count; ++i)
+            {
+                values()[i].~T();
+            }
+        }
+    };
+
+    node* m_root = nullptr;
+    node* m_tail = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_shift = PERSISTENT_VECTOR_BITS;
+
+    static node* retain(node* n);
+    static void release(node* n, std::size_t shift);
+    static leaf* edit_leaf(node*& slot);
+    static inner* edit_inner(node*& slot, std::size_t shift);
+    static node* new_path(std::size_t shift, node* tail);
+
+    std::size_t tail_offset() const;
+    node* leaf_node(std::size_t index) const;
+    void push_tail(node*& slot, std::size_t shift, node* tail);
+    bool pop_tail(node*& slot, std::size_t shift);
+
+public:
+    radix_tree() noexcept {}
+    radix_tree(const radix_tree& other) noexcept;
+    radix_tree(radix_tree&& other) noexcept;
+    ~radix_tree();
+    radix_tree& operator=(radix_tree other) noexcept;
+    void swap(radix_tree& other) noexcept;
+
+    inline std::size_t size() const {return m_size;}
+    const T* leaf_for(std::size_t index) const;
+    const T& get(std::size_t index) const;
+
+    template<class... Args>
+    void emplace_back(Args&&... args);
+    void set(std::size_t index, const T& value);
+    void pop_back();
+};
+
+template<class T>
+constexpr std::size_t radix_tree<T>::BITS;
+template<class T>
+constexpr std::size_t radix_tree<T>::BRANCHING;
+template<class T>
+constexpr std::size_t radix_tree<T>::MASK;
+
+/**
+ * @brief Copy ctor, O(1): the root and the tail are shared.
+ */
+template<class T>
+radix_tree<T>::radix_tree(const radix_tree& other) noexcept
+    :m_root(retain(other.m_root))
+    ,m_tail(retain(other.m_tail))
+    ,m_size(other.m_size)
+    ,m_shift(other.m_shift)
+{}
+
+/**
+ * @brief Move ctor, other is left empty.
+ */
+template<class T>
+radix_tree<T>::radix_tree(radix_tree&& other) noexcept
+{
+    swap(other);
+}
+
+/**
+ * @brief Dtor, releases the root and the tail, the nodes are deleted by the last owner.
+ */
+template<class T>
+radix_tree<T>::~radix_tree()
+{
+    release(m_root, m_shift);
+    release(m_tail, 0);
+}
+
+/**
+ * @brief Assignment operator, copy and swap.
+ */
+template<class T>
+radix_tree<T>& radix_tree<T>::operator=(radix_tree other) noexcept
+{
+    swap(other);
+    return *this;
+}
+
+template<class T>
+void radix_tree<T>::swap(radix_tree& other) noexcept
+{
+    std::swap(m_root, other.m_root);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_size, other.m_size);
+    std::swap(m_shift, other.m_shift);
+}
+
+/**
+ * @brief Adds the owner to the node.
+ */
+template<class T>
+typename radix_tree<T>::node* radix_tree<T>::retain(node* n)
+{
+    if(n != nullptr){
+        n->m_refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    return n;
+}
+
+/**
+ * @brief Removes the owner of the node, the last owner deletes the node and releases its children.
+ * @param shift The level of the node, 0 for the leaves.
+ */
+template<class T>
+void radix_tree<T>::release(node* n, std::size_t shift)
+{
+    if(n == nullptr || n->m_refs.fetch_sub(1, std::memory_order_acq_rel) != 1){
+        return;
+    }
+    if(shift == 0){
+        delete static_cast<leaf*>(n);
+        return;
+    }
+    inner* in = static_cast<inner*>(n);
+    for(node* child : in->m_children)
+    {
+        release(child, shift-BITS);
+    }
+    delete in;
+}
+
+/**
+ * @brief Makes the leaf in the slot owned only by this trie, the shared leaf is copied.
+ */
+template<class T>
+typename radix_tree<T>::leaf* radix_tree<T>::edit_leaf(node*& slot)
+{
+    leaf* src = static_cast<leaf*>(slot);
+    if(src->m_refs.load(std::memory_order_acquire) == 1){
+        return src;
+    }
+    leaf* copy = new leaf;
+    try{
+        for(; copy->m_count<src->m_count; ++copy->m_count)
+        {
+            ::new(static_cast<void*>(copy->values()+copy->m_count)) T(src->values()[copy->m_count]);
+        }
+    }
+    catch(...){
+        delete copy;
+        throw;
+    }
+    release(slot, 0);
+    slot = copy;
+    return copy;
+}
+
+/**
+ * @brief Makes the inner node in the slot owned only by this trie,
+ *        the shared node is copied and its children get one more owner.
+ */
+template<class T>
+typename radix_tree<T>::inner* radix_tree<T>::edit_inner(node*& slot, std::size_t shift)
+{
+    inner* src = static_cast<inner*>(slot);
+    if(src->m_refs.load(std::memory_order_acquire) == 1){
+        return src;
+    }
+    inner* copy = new inner;
+    for(std::size_t i=0; i<BRANCHING; ++i)
+    {
+        copy->m_children[i] = retain(src->m_children[i]);
+    }
+    release(slot, shift);
+    slot = copy;
+    return copy;
+}
+
+/**
+ * @brief Builds the chain of the inner nodes from the level shift down to the leaf tail.
+ */
+template<class T>
+typename radix_tree<T>::node* radix_tree<T>::new_path(std::size_t shift, node* tail)
+{
+    if(shift == 0){
+        return tail;
+    }
+    inner* n = new inner;
+    try{
+        n->m_children[0] = new_path(shift-BITS, tail);
+    }
+    catch(...){
+        delete n;
+        throw;
+    }
+    return n;
+}
+
+/**
+ * @brief The index of the first element of the tail.
+ */
+template<class T>
+std::size_t radix_tree<T>::tail_offset() const
+{
+    return m_size < BRANCHING ? 0 : ((m_size-1) >> BITS) << BITS;
+}
+
+/**
+ * @brief The leaf holding the element at index.
+ */
+template<class T>
+typename radix_tree<T>::node* radix_tree<T>::leaf_node(std::size_t index) const
+{
+    if(index >= tail_offset()){
+        return m_tail;
+    }
+    node* n = m_root;
+    for(std::size_t shift=m_shift; shift>0; shift-=BITS)
+    {
+        n = static_cast<inner*>(n)->m_children[(index >> shift) & MASK];
+    }
+    return n;
+}
+
+/**
+ * @brief The values of the leaf holding the element at index.
+ */
+template<class T>
+const T* radix_tree<T>::leaf_for(std::size_t index) const
+{
+    return static_cast<const leaf*>(leaf_node(index))->values();
+}
+
+/**
+ * @brief The element at index, O(log32 n).
+ */
+template<class T>
+const T& radix_tree<T>::get(std::size_t index) const
+{
+    return leaf_for(index)[index & MASK];
+}
+
+/**
+ * @brief Inserts the full tail into the trie under the node in the slot of the level shift.
+ */
+template<class T>
+void radix_tree<T>::push_tail(node*& slot, std::size_t shift, node* tail)
+{
+    inner* parent = edit_inner(slot, shift);
+    node*& child = parent->m_children[((m_size-1) >> shift) & MASK];
+    if(shift == BITS){
+        child = tail;
+    }
+    else if(child != nullptr){
+        push_tail(child, shift-BITS, tail);
+    }
+    else{
+        child = new_path(shift-BITS, tail);
+    }
+}
+
+/**
+ * @brief Appends the element constructed from args.
+ *        The full tail is moved into the trie, the trie grows by one level
+ *        when the root is full.
+ */
+template<class T>
+template<class... Args>
+void radix_tree<T>::emplace_back(Args&&... args)
+{
+    if(m_tail == nullptr){
+        m_tail = new leaf;
+    }
+    if(m_size - tail_offset() < BRANCHING){
+        leaf* tail = edit_leaf(m_tail);
+        ::new(static_cast<void*>(tail->values()+tail->m_count)) T(std::forward<Args>(args)...);
+        ++tail->m_count;
+        ++m_size;
+        return;
+    }
+    leaf* fresh = new leaf;
+    try{
+        ::new(static_cast<void*>(fresh->values())) T(std::forward<Args>(args)...);
+        fresh->m_count = 1;
+        if(m_root == nullptr){
+            inner* root = new inner;
+            root->m_children[0] = m_tail;
+            m_root = root;
+        }
+        else if((m_size >> BITS) > (std::size_t(1) << m_shift)){
+            inner* root = new inner;
+            try{
+                root->m_children[1] = new_path(m_shift, m_tail);
+            }
+            catch(...){
+                delete root;
+                throw;
+            }
+            root->m_children[0] = m_root;
+            m_root = root;
+            m_shift += BITS;
+        }
+        else{
+            push_tail(m_root, m_shift, m_tail);
+        }
+    }
+    catch(...){
+        delete fresh;
+        throw;
+    }
+    m_tail = fresh;
+    ++m_size;
+}
+
+/**
+ * @brief Replaces the element at index, only the path to its leaf is copied.
+ */
+template<class T>
+void radix_tree<T>::set(std::size_t index, const T& value)
+{
+    if(index >= tail_offset()){
+        edit_leaf(m_tail)->values()[index & MASK] = value;
+        return;
+    }
+    node** slot = &m_root;
+    for(std::size_t shift=m_shift; shift>0; shift-=BITS)
+    {
+        slot = &edit_inner(*slot, shift)->m_children[(index >> shift) & MASK];
+    }
+    edit_leaf(*slot)->values()[index & MASK] = value;
+}
+
+/**
+ * @brief Removes the last leaf of the trie under the node in the slot of the level shift.
+ * @return true if the node has no children left: the removed leaf was the first child,
+ *         or the first child was removed because it became empty.
+ */
+template<class T>
+bool radix_tree<T>::pop_tail(node*& slot, std::size_t shift)
+{
+    inner* parent = edit_inner(slot, shift);
+    const std::size_t sub = ((m_size-2) >> shift) & MASK;
+    node*& child = parent->m_children[sub];
+    if(shift == BITS || pop_tail(child, shift-BITS)){
+        release(child, shift-BITS);
+        child = nullptr;
+    }
+    // Above the leaf level the node is empty only if its first child was removed
+    return sub == 0 && child == nullptr;
+}
+
+/**
+ * @brief Removes the last element. When the tail gets empty,
+ *        the last leaf of the trie becomes the tail, the root with one child is collapsed.
+ */
+template<class T>
+void radix_tree<T>::pop_back()
+{
+    assert((m_size > 0) && "Persistent vector error: pop_back() on empty container");
+    if(m_size - tail_offset() > 1){
+        leaf* tail = edit_leaf(m_tail);
+        --tail->m_count;
+        tail->values()[tail->m_count].~T();
+        --m_size;
+        return;
+    }
+    if(m_root == nullptr){
+        release(m_tail, 0);
+        m_tail = nullptr;
+        m_size = 0;
+        return;
+    }
+    node* new_tail = retain(leaf_node(m_size-2));
+    try{
+        if(pop_tail(m_root, m_shift)){
+            release(m_root, m_shift);
+            m_root = nullptr;
+        }
+    }
+    catch(...){
+        release(new_tail, 0);
+        throw;
+    }
+    if(m_root != nullptr && m_shift > BITS && static_cast<inner*>(m_root)->m_children[1] == nullptr){
+        node* child = retain(static_cast<inner*>(m_root)->m_children[0]);
+        release(m_root, m_shift);
+        m_root = child;
+        m_shift -= BITS;
+    }
+    release(m_tail, 0);
+    m_tail = new_tail;
+    --m_size;
+}
+}
+
+/**
+ * Persistent vector
+ * @brief The immutable vector, every change returns the new vector and leaves this one intact.
+ *  The versions share the unchanged nodes of the radix trie, so the copy (the snapshot) is O(1)
+ *  and push_back, set and pop_back copy O(log32 n) nodes of one path.
+ *  The access by index is O(log32 n), the iterator is O(1) per element.
+ *  The instances are immutable, so one version may be read by many threads,
+ *  the node counters are atomic and the versions are released by any thread.
+ *  The bulk building goes through transient_vector, which changes its own nodes in place.
+ */
+template<class T>
+class persistent_vector
+{
+private:
+    detail::radix_tree<T> m_tree;
+
+    friend class transient_vector<T>;
+    explicit persistent_vector(detail::radix_tree<T>&& tree) noexcept:m_tree(std::move(tree)){}
+
+public:
+    using value_type = T;
+
+    /**
+     * @brief The forward iterator, looks up the leaf once per PERSISTENT_VECTOR_BRANCHING elements.
+     */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() noexcept:m_tree(nullptr), m_index(0), m_values(nullptr){}
+        const_iterator(const detail::radix_tree<T>* tree, std::size_t index)
+            :m_tree(tree), m_index(index)
+            ,m_values(index < tree->size() ? tree->leaf_for(index) : nullptr)
+        {}
+
+        inline reference operator*() const {return m_values[m_index & (PERSISTENT_VECTOR_BRANCHING-1)];}
+        inline pointer operator->() const {return &**this;}
+        const_iterator& operator++()//++i
+        {
+            ++m_index;
+            if((m_index & (PERSISTENT_VECTOR_BRANCHING-1)) == 0 && m_index < m_tree->size()){
+                m_values = m_tree->leaf_for(m_index);
+            }
+            return *this;
+        }
+        const_iterator operator++(int){const_iterator it = *this; ++*this; return it;}//i++
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs){return lhs.m_index == rhs.m_index;}
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs){return lhs.m_index != rhs.m_index;}
+
+    private:
+        const detail::radix_tree<T>* m_tree;
+        std::size_t m_index;
+        const T* m_values;
+    };
+
+    using iterator = const_iterator;
+
+    persistent_vector() noexcept {}
+    persistent_vector(std::initializer_list<T> ilist);
+    template<class InputIt>
+    persistent_vector(InputIt first, InputIt last);
+
+    inline std::size_t size() const;
+    bool empty() const;
+
+    const T& operator[](std::size_t index) const;
+    const T& at(std::size_t index) const;
+    const T& front() const;
+    const T& back() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    persistent_vector push_back(const T& value) const;
+    persistent_vector set(std::size_t index, const T& value) const;
+    persistent_vector pop_back() const;
+
+    transient_vector<T> transient() const;
+};
+
+/**
+ * Transient vector
+ * @brief The mutable builder of persistent_vector. It shares the nodes with the source version,
+ *  the shared nodes are copied on the first change, the own nodes are changed in place,
+ *  so the bulk push_back costs like the vector push_back.
+ *  persistent() hands the trie to the new persistent_vector in O(1).
+ *  The transient is not thread safe.
+ */
+template<class T>
+class transient_vector
+{
+private:
+    detail::radix_tree<T> m_tree;
+
+    friend class persistent_vector<T>;
+    explicit transient_vector(const detail::radix_tree<T>& tree) noexcept:m_tree(tree){}
+
+public:
+    using value_type = T;
+
+    transient_vector() noexcept {}
+
+    inline std::size_t size() const;
+    bool empty() const;
+    const T& operator[](std::size_t index) const;
+
+    void push_back(const T& value);
+    void push_back(T&& value);
+    template<class... Args>
+    void emplace_back(Args&&... args);
+    void set(std::size_t index, const T& value);
+    void pop_back();
+
+    persistent_vector<T> persistent();
+};
+
+/**
+ * @brief Ctor from the initializer list, built by the transient.
+ */
+template<class T>
+persistent_vector<T>::persistent_vector(std::initializer_list<T> ilist)
+    :persistent_vector(ilist.begin(), ilist.end())
+{}
+
+/**
+ * @brief Ctor from the range [first, last), built by the transient.
+ */
+template<class T>
+template<class InputIt>
+persistent_vector<T>::persistent_vector(InputIt first, InputIt last)
+{
+    transient_vector<T> builder;
+    for(; first != last; ++first)
+    {
+        builder.push_back(*first);
+    }
+    m_tree = std::move(builder.m_tree);
+}
+
+/**
+ * @brief The number of elements.
+ */
+template<class T>
+std::size_t persistent_vector<T>::size() const
+{
+    return m_tree.size();
+}
+
+/**
+ * @brief Checks whether the container is empty.
+ */
+template<class T>
+bool persistent_vector<T>::empty() const
+{
+    return m_tree.size() == 0;
+}
+
+/**
+ * @brief The element at index, O(log32 n).
+ */
+template<class T>
+const T& persistent_vector<T>::operator[](std::size_t index) const
+{
+    assert((index < m_tree.size()) && "Persistent vector error: index out of range");
+    return m_tree.get(index);
+}
+
+/**
+ * @brief The element at index with the bounds checking.
+ * @throw std::out_of_range if index is not less than size().
+ */
+template<class T>
+const T& persistent_vector<T>::at(std::size_t index) const
+{
+    if(index >= m_tree.size()){
+        throw std::out_of_range("Persistent vector error: index out of range");
+    }
+    return m_tree.get(index);
+}
+
+/**
+ * @brief The first element.
+ */
+template<class T>
+const T& persistent_vector<T>::front() const
+{
+    return (*this)[0];
+}
+
+/**
+ * @brief The last element, O(1): it is in the tail.
+ */
+template<class T>
+const T& persistent_vector<T>::back() const
+{
+    return (*this)[m_tree.size()-1];
+}
+
+/**
+ * @brief Begin iterator.
+ */
+template<class T>
+typename persistent_vector<T>::const_iterator persistent_vector<T>::begin() const
+{
+    return const_iterator(&m_tree, 0);
+}
+
+/**
+ * @brief End iterator.
+ */
+template<class T>
+typename persistent_vector<T>::const_iterator persistent_vector<T>::end() const
+{
+    return const_iterator(&m_tree, m_tree.size());
+}
+
+/**
+ * @brief The new version with value appended.
+ */
+template<class T>
+persistent_vector<T> persistent_vector<T>::push_back(const T& value) const
+{
+    detail::radix_tree<T> tree(m_tree);
+    tree.emplace_back(value);
+    return persistent_vector(std::move(tree));
+}
+
+/**
+ * @brief The new version with the element at index replaced by value.
+ */
+template<class T>
+persistent_vector<T> persistent_vector<T>::set(std::size_t index, const T& value) const
+{
+    assert((index < m_tree.size()) && "Persistent vector error: index out of range");
+    detail::radix_tree<T> tree(m_tree);
+    tree.set(index, value);
+    return persistent_vector(std::move(tree));
+}
+
+/**
+ * @brief The new version without the last element.
+ */
+template<class T>
+persistent_vector<T> persistent_vector<T>::pop_back() const
+{
+    detail::radix_tree<T> tree(m_tree);
+    tree.pop_back();
+    return persistent_vector(std::move(tree));
+}
+
+/**
+ * @brief The transient starting from this version, O(1).
+ */
+template<class T>
+transient_vector<T> persistent_vector<T>::transient() const
+{
+    return transient_vector<T>(m_tree);
+}
+
+/**
+ * @brief The number of elements.
+ */
+template<class T>
+std::size_t transient_vector<T>::size() const
+{
+    return m_tree.size();
+}
+
+/**
+ * @brief Checks whether the container is empty.
+ */
+template<class T>
+bool transient_vector<T>::empty() const
+{
+    return m_tree.size() == 0;
+}
+
+/**
+ * @brief The element at index, O(log32 n).
+ */
+template<class T>
+const T& transient_vector<T>::operator[](std::size_t index) const
+{
+    assert((index < m_tree.size()) && "Transient vector error: index out of range");
+    return m_tree.get(index);
+}
+
+/**
+ * @brief Appends the copy of value.
+ */
+template<class T>
+void transient_vector<T>::push_back(const T& value)
+{
+    m_tree.emplace_back(value);
+}
+
+/**
+ * @brief Appends the value by moving.
+ */
+template<class T>
+void transient_vector<T>::push_back(T&& value)
+{
+    m_tree.emplace_back(std::move(value));
+}
+
+/**
+ * @brief Appends the element constructed from args.
+ */
+template<class T>
+template<class... Args>
+void transient_vector<T>::emplace_back(Args&&... args)
+{
+    m_tree.emplace_back(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Replaces the element at index.
+ */
+template<class T>
+void transient_vector<T>::set(std::size_t index, const T& value)
+{
+    assert((index < m_tree.size()) && "Transient vector error: index out of range");
+    m_tree.set(index, value);
+}
+
+/**
+ * @brief Removes the last element.
+ */
+template<class T>
+void transient_vector<T>::pop_back()
+{
+    m_tree.pop_back();
+}
+
+/**
+ * @brief Moves the elements to the persistent vector in O(1), the transient is left empty.
+ */
+template<class T>
+persistent_vector<T> transient_vector<T>::persistent()
+{
+    return persistent_vector<T>(std::move(m_tree));
+}
+
+}
+
+#endif //PERSISTENT_VECTOR_H
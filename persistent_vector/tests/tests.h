@@ -0,0 +1,336 @@
+#ifndef PERSISTENT_VECTOR_TESTS_H
+#define PERSISTENT_VECTOR_TESTS_H
+
+#include <iostream>
+#include <ctime>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include "vector.h"
+#include "persistent_vector.h"
+
+namespace persistent_vector_testing {
+const std::size_t num_of_elements = 100000;
+const std::size_t bench_elements = 1000000;
+const std::size_t bench_updates = 20000;
+const std::size_t snapshot_period = 10;
+const int module = 1000;
+
+/**
+ * @brief get_time_sec - get time in seconds
+ * @return the time in seconds
+ */
+inline double get_time_sec()
+{
+    return static_cast<double>(clock())/ CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief get_new_time calculating the total time and setting the current time in seconds
+ * @param sum_time - summary time
+ * @param last_time - last time value
+ */
+void get_new_time(double &sum_time, double &last_time)
+{
+    sum_time += get_time_sec() - last_time;
+    last_time = get_time_sec();
+}
+
+template<class T>
+void check_equal(const scl::persistent_vector<T>& pvec, const std::vector<T>& expected)
+{
+    ASSERT_EQ(pvec.size(), expected.size());
+    std::size_t i = 0;
+    for(const T& value : pvec)
+    {
+        ASSERT_EQ(value, expected[i]);
+        ASSERT_EQ(pvec[i], expected[i]);
+        ++i;
+    }
+    ASSERT_EQ(i, expected.size());
+}
+
+TEST(CheckPersistentVector, PushBackAndVersions)
+{
+    //Arrange
+    scl::persistent_vector<int> pvec;
+    std::vector<int> expected;
+    std::vector<scl::persistent_vector<int>> versions;
+    std::vector<std::size_t> sizes = {0, 1, 31, 32, 33, 64, 1024, 1056, 1057, 32800, num_of_elements};
+    //Act
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        if(std::find(sizes.begin(), sizes.end(), i) != sizes.end()){
+            versions.push_back(pvec);
+        }
+        pvec = pvec.push_back(static_cast<int>(i));
+        expected.push_back(static_cast<int>(i));
+    }
+    //Assert
+    check_equal(pvec, expected);
+    for(const scl::persistent_vector<int>& version : versions)
+    {
+        check_equal(version, std::vector<int>(expected.begin(), expected.begin() + version.size()));
+    }
+    ASSERT_EQ(pvec.front(), 0);
+    ASSERT_EQ(pvec.back(), static_cast<int>(num_of_elements-1));
+    ASSERT_THROW(pvec.at(num_of_elements), std::out_of_range);
+}
+
+TEST(CheckPersistentVector, SetAndPopBack)
+{
+    //Arrange
+    scl::persistent_vector<std::string> pvec;
+    std::vector<std::string> expected;
+    for(std::size_t i=0; i<5000; ++i)
+    {
+        pvec = pvec.push_back(std::to_string(i));
+        expected.push_back(std::to_string(i));
+    }
+    const scl::persistent_vector<std::string> snapshot = pvec;
+    const std::vector<std::string> snapshot_expected = expected;
+    //Act
+    for(std::size_t n=0; n<1000; ++n)
+    {
+        std::size_t i = static_cast<std::size_t>(std::rand()) % expected.size();
+        pvec = pvec.set(i, "set" + std::to_string(n));
+        expected[i] = "set" + std::to_string(n);
+    }
+    check_equal(pvec, expected);
+    while(!expected.empty())
+    {
+        pvec = pvec.pop_back();
+        expected.pop_back();
+        if(expected.size() % 997 == 0) check_equal(pvec, expected);
+    }
+    //Assert
+    ASSERT_TRUE(pvec.empty());
+    check_equal(snapshot, snapshot_expected);
+    pvec = pvec.push_back("again");
+    ASSERT_EQ(pvec.back(), "again");
+}
+
+TEST(CheckPersistentVector, PopBackThreeLevels)
+{
+    //Arrange
+    const std::size_t branching = PERSISTENT_VECTOR_BRANCHING;
+    const std::size_t size = branching*branching*branching + 2*branching + 1;
+    scl::transient_vector<int> builder;
+    std::vector<int> expected;
+    for(std::size_t i=0; i<size; ++i)
+    {
+        builder.push_back(static_cast<int>(i));
+        expected.push_back(static_cast<int>(i));
+    }
+    scl::persistent_vector<int> pvec = builder.persistent();
+    scl::transient_vector<int> editor = pvec.transient();
+    //Act
+    while(!expected.empty())
+    {
+        pvec = pvec.pop_back();
+        editor.pop_back();
+        expected.pop_back();
+        ASSERT_EQ(editor.size(), expected.size());
+        if(!expected.empty()){
+            ASSERT_EQ(pvec.back(), expected.back());
+            ASSERT_EQ(editor[expected.size()-1], expected.back());
+        }
+        if(expected.size() % 997 == 0 || expected.size() + branching + 2 > size) check_equal(pvec, expected);
+    }
+    //Assert
+    ASSERT_TRUE(pvec.empty());
+    ASSERT_TRUE(editor.empty());
+}
+
+TEST(CheckPersistentVector, Transient)
+{
+    //Arrange
+    scl::persistent_vector<int> base{1, 2, 3};
+    std::vector<int> expected = {1, 2, 3};
+    //Act
+    scl::transient_vector<int> builder = base.transient();
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        builder.push_back(static_cast<int>(i));
+        expected.push_back(static_cast<int>(i));
+    }
+    builder.set(1, -2);
+    expected[1] = -2;
+    builder.pop_back();
+    expected.pop_back();
+    scl::persistent_vector<int> built = builder.persistent();
+    scl::transient_vector<int> editor = built.transient();
+    editor.set(num_of_elements/2, -1);
+    scl::persistent_vector<int> edited = editor.persistent();
+    //Assert
+    ASSERT_TRUE(builder.empty());
+    check_equal(base, std::vector<int>{1, 2, 3});
+    check_equal(built, expected);
+    expected[num_of_elements/2] = -1;
+    check_equal(edited, expected);
+    scl::vector<int> source;
+    source.push_back(4);
+    source.push_back(5);
+    scl::persistent_vector<int> from_range(source.begin(), source.end());
+    check_equal(from_range, std::vector<int>{4, 5});
+}
+
+TEST(CheckPersistentVector, ConcurrentReaders)
+{
+    //Arrange
+    scl::transient_vector<std::int64_t> builder;
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        builder.push_back(0);
+    }
+    scl::persistent_vector<std::int64_t> current = builder.persistent();
+    std::mutex current_mutex;
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> torn{0};
+    //Act
+    // Every version holds the same value in all the elements
+    std::vector<std::thread> readers;
+    for(int r=0; r<2; ++r)
+    {
+        readers.emplace_back([&]
+        {
+            while(!done.load())
+            {
+                scl::persistent_vector<std::int64_t> snapshot;
+                {
+                    std::lock_guard<std::mutex> lock(current_mutex);
+                    snapshot = current;
+                }
+                std::int64_t first = snapshot[0];
+                for(std::int64_t value : snapshot)
+                {
+                    if(value != first) ++torn;
+                }
+            }
+        });
+    }
+    for(std::int64_t version=1; version<=20; ++version)
+    {
+        scl::transient_vector<std::int64_t> editor = current.transient();
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            editor.set(i, version);
+        }
+        scl::persistent_vector<std::int64_t> next = editor.persistent();
+        std::lock_guard<std::mutex> lock(current_mutex);
+        current = next;
+    }
+    done = true;
+    for(std::thread& reader : readers)
+    {
+        reader.join();
+    }
+    //Assert
+    ASSERT_EQ(torn.load(), 0U);
+    ASSERT_EQ(current.back(), 20);
+}
+
+TEST(ComparePersistentVector, Snapshots)
+{
+    std::vector<std::size_t> indexes(bench_updates);
+    for(std::size_t& index : indexes)
+    {
+        index = static_cast<std::size_t>(std::rand()) % bench_elements;
+    }
+    double vector_time = 0, persistent_time = 0, last_time = get_time_sec();
+    std::size_t vector_sum = 0, persistent_sum = 0;
+    {
+        scl::vector<int> vec(bench_elements);
+        for(std::size_t n=0; n<bench_updates; ++n)
+        {
+            vec[indexes[n]] = static_cast<int>(n);
+            if(n % snapshot_period == 0){
+                scl::vector<int> snapshot(vec);
+                vector_sum += static_cast<std::size_t>(snapshot[indexes[n]]);
+            }
+        }
+    }
+    get_new_time(vector_time, last_time);
+    {
+        scl::transient_vector<int> builder;
+        for(std::size_t i=0; i<bench_elements; ++i)
+        {
+            builder.push_back(0);
+        }
+        scl::persistent_vector<int> pvec = builder.persistent();
+        for(std::size_t n=0; n<bench_updates; ++n)
+        {
+            pvec = pvec.set(indexes[n], static_cast<int>(n));
+            if(n % snapshot_period == 0){
+                scl::persistent_vector<int> snapshot(pvec);
+                persistent_sum += static_cast<std::size_t>(snapshot[indexes[n]]);
+            }
+        }
+    }
+    get_new_time(persistent_time, last_time);
+    std::cout << bench_updates << " updates of " << bench_elements << " elements, snapshot every "
+              << snapshot_period << ": copy-on-snapshot vector " << vector_time
+              << " s, persistent_vector " << persistent_time << " s\n";
+    ASSERT_EQ(vector_sum, persistent_sum);
+}
+
+TEST(ComparePersistentVector, BuildAndRead)
+{
+    double vector_time = 0, transient_time = 0, persistent_time = 0, last_time = get_time_sec();
+    scl::vector<int> vec;
+    for(std::size_t i=0; i<bench_elements; ++i)
+    {
+        vec.push_back(static_cast<int>(i));
+    }
+    get_new_time(vector_time, last_time);
+    scl::transient_vector<int> builder;
+    for(std::size_t i=0; i<bench_elements; ++i)
+    {
+        builder.push_back(static_cast<int>(i));
+    }
+    scl::persistent_vector<int> built = builder.persistent();
+    get_new_time(transient_time, last_time);
+    scl::persistent_vector<int> pvec;
+    for(std::size_t i=0; i<bench_elements; ++i)
+    {
+        pvec = pvec.push_back(static_cast<int>(i));
+    }
+    get_new_time(persistent_time, last_time);
+    std::cout << "build " << bench_elements << ": vector " << vector_time << " s, transient "
+              << transient_time << " s, persistent push_back " << persistent_time << " s\n";
+
+    double vector_read = 0, persistent_read = 0, iterate_read = 0;
+    std::int64_t vector_sum = 0, persistent_sum = 0, iterate_sum = 0;
+    last_time = get_time_sec();
+    for(std::size_t i=0; i<bench_elements; ++i)
+    {
+        vector_sum += vec[(i * 7919) % bench_elements];
+    }
+    get_new_time(vector_read, last_time);
+    for(std::size_t i=0; i<bench_elements; ++i)
+    {
+        persistent_sum += built[(i * 7919) % bench_elements];
+    }
+    get_new_time(persistent_read, last_time);
+    for(int value : built)
+    {
+        iterate_sum += value;
+    }
+    get_new_time(iterate_read, last_time);
+    std::cout << "scattered reads: vector " << vector_read << " s, persistent_vector " << persistent_read
+              << " s, persistent_vector iteration " << iterate_read << " s\n";
+    ASSERT_EQ(vector_sum, persistent_sum);
+    ASSERT_EQ(iterate_sum, persistent_sum);
+    ASSERT_EQ(pvec.size(), built.size());
+}
+
+}
+
+#endif //PERSISTENT_VECTOR_TESTS_H
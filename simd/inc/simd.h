@@ -0,0 +1,778 @@
+#ifndef SIMD_H
+#define SIMD_H
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include "vector.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCL_SIMD_X86 1
+#include <immintrin.h>
+#define SCL_SIMD_SSE2 __attribute__((target("sse2")))
+#define SCL_SIMD_AVX2 __attribute__((target("avx2")))
+#endif
+
+// Sequence containers library)
+namespace scl {
+/**
+ * Search and reduction kernels over the contiguous storage.
+ * @brief Every algorithm has a scalar, SSE2 and AVX2 version, the widest
+ *        instruction set supported by the CPU is picked at runtime.
+ *        The kernels are provided for int32_t, float and uint64_t elements.
+ */
+namespace simd {
+
+/**
+ * @brief The instruction sets of the kernels
+ */
+enum class isa
+{
+    scalar,
+    sse2,
+    avx2
+};
+
+/**
+ * @brief The accumulator type of sum(), wide enough to not overflow
+ *        on the int32_t elements and to keep the float precision.
+ */
+template<class T> struct sum_type;
+template<> struct sum_type<std::int32_t>{using type = std::int64_t;};
+template<> struct sum_type<float>{using type = double;};
+template<> struct sum_type<std::uint64_t>{using type = std::uint64_t;};
+
+/**
+ * @brief Checks whether the CPU supports the instruction set.
+ */
+inline bool is_supported(isa set)
+{
+#ifdef SCL_SIMD_X86
+    switch(set)
+    {
+    case isa::avx2: return __builtin_cpu_supports("avx2");
+    case isa::sse2: return __builtin_cpu_supports("sse2");
+    default: return true;
+    }
+#else
+    return set == isa::scalar;
+#endif
+}
+
+/**
+ * @brief The widest instruction set supported by the CPU.
+ */
+inline isa detect_isa()
+{
+    if(is_supported(isa::avx2)){
+        return isa::avx2;
+    }
+    if(is_supported(isa::sse2)){
+        return isa::sse2;
+    }
+    return isa::scalar;
+}
+
+namespace detail {
+inline isa& current_isa()
+{
+    static isa set = detect_isa();
+    return set;
+}
+}
+
+/**
+ * @brief The instruction set used by the kernels.
+ */
+inline isa active_isa()
+{
+    return detail::current_isa();
+}
+
+/**
+ * @brief Forces the instruction set, mostly for the tests and the benchmarks.
+ */
+inline void set_isa(isa set)
+{
+    assert(is_supported(set) && "Simd error: the instruction set is not supported");
+    detail::current_isa() = set;
+}
+
+namespace scalar {
+/**
+ * @brief Index of the first element equal to value, n if not found.
+ */
+template<class T>
+std::size_t find(const T* data, std::size_t n, T value)
+{
+    for(std::size_t i=0; i<n; ++i)
+    {
+        if(data[i] == value) return i;
+    }
+    return n;
+}
+
+/**
+ * @brief The number of elements equal to value.
+ */
+template<class T>
+std::size_t count(const T* data, std::size_t n, T value)
+{
+    std::size_t total = 0;
+    for(std::size_t i=0; i<n; ++i)
+    {
+        total += (data[i] == value);
+    }
+    return total;
+}
+
+/**
+ * @brief The smallest element, n must be positive.
+ */
+template<class T>
+T min(const T* data, std::size_t n)
+{
+    T result = data[0];
+    for(std::size_t i=1; i<n; ++i)
+    {
+        result = std::min(result, data[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief The largest element, n must be positive.
+ */
+template<class T>
+T max(const T* data, std::size_t n)
+{
+    T result = data[0];
+    for(std::size_t i=1; i<n; ++i)
+    {
+        result = std::max(result, data[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief The sum of the elements in the sum_type<T> accumulator.
+ */
+template<class T>
+typename sum_type<T>::type sum(const T* data, std::size_t n)
+{
+    typename sum_type<T>::type total = 0;
+    for(std::size_t i=0; i<n; ++i)
+    {
+        total += data[i];
+    }
+    return total;
+}
+}
+
+#ifdef SCL_SIMD_X86
+namespace sse2 {
+const std::size_t count_block = std::size_t(1) << 24;
+
+SCL_SIMD_SSE2 inline __m128i cmpeq_epi64(__m128i lhs, __m128i rhs)
+{
+    __m128i eq = _mm_cmpeq_epi32(lhs, rhs);
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2,3,0,1)));
+}
+
+SCL_SIMD_SSE2 inline __m128i blend(__m128i mask, __m128i on_true, __m128i on_false)
+{
+    return _mm_or_si128(_mm_and_si128(mask, on_true), _mm_andnot_si128(mask, on_false));
+}
+
+SCL_SIMD_SSE2 inline std::size_t find(const std::int32_t* data, std::size_t n, std::int32_t value)
+{
+    const __m128i needle = _mm_set1_epi32(value);
+    std::size_t i = 0;
+    for(; i+4 <= n; i+=4)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+        if(mask != 0) return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    return i + scalar::find(data+i, n-i, value);
+}
+
+SCL_SIMD_SSE2 inline std::size_t find(const float* data, std::size_t n, float value)
+{
+    const __m128 needle = _mm_set1_ps(value);
+    std::size_t i = 0;
+    for(; i+4 <= n; i+=4)
+    {
+        int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data+i), needle));
+        if(mask != 0) return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    return i + scalar::find(data+i, n-i, value);
+}
+
+SCL_SIMD_SSE2 inline std::size_t find(const std::uint64_t* data, std::size_t n, std::uint64_t value)
+{
+    const __m128i needle = _mm_set1_epi64x(static_cast<long long>(value));
+    std::size_t i = 0;
+    for(; i+2 <= n; i+=2)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+i));
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(cmpeq_epi64(block, needle)));
+        if(mask != 0) return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    return i + scalar::find(data+i, n-i, value);
+}
+
+SCL_SIMD_SSE2 inline std::size_t count(const std::int32_t* data, std::size_t n, std::int32_t value)
+{
+    const __m128i needle = _mm_set1_epi32(value);
+    std::size_t total = 0, i = 0;
+    const std::size_t end = n - n % 4;
+    while(i < end)
+    {
+        // The lane counters are flushed before they can overflow
+        const std::size_t block_end = std::min(end, i + count_block*4);
+        __m128i acc = _mm_setzero_si128();
+        for(; i < block_end; i+=4)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+i));
+            acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(block, needle));
+        }
+        alignas(16) std::uint32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        total += std::size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+    return total + scalar::count(data+i, n-i, value);
+}
+
+SCL_SIMD_SSE2 inline std::size_t count(const float* data, std::size_t n, float value)
+{
+    const __m128 needle = _mm_set1_ps(value);
+    std::size_t total = 0, i = 0;
+    const std::size_t end = n - n % 4;
+    while(i < end)
+    {
+        const std::size_t block_end = std::min(end, i + count_block*4);
+        __m128i acc = _mm_setzero_si128();
+        for(; i < block_end; i+=4)
+        {
+            acc = _mm_sub_epi32(acc, _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(data+i), needle)));
+        }
+        alignas(16) std::uint32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        total += std::size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+    return total + scalar::count(data+i, n-i, value);
+}
+
+SCL_SIMD_SSE2 inline std::size_t count(const std::uint64_t* data, std::size_t n, std::uint64_t value)
+{
+    const __m128i needle = _mm_set1_epi64x(static_cast<long long>(value));
+    __m128i acc = _mm_setzero_si128();
+    std::size_t i = 0;
+    for(; i+2 <= n; i+=2)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+i));
+        acc = _mm_sub_epi64(acc, cmpeq_epi64(block, needle));
+    }
+    alignas(16) std::uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return static_cast<std::size_t>(lanes[0] + lanes[1]) + scalar::count(data+i, n-i, value);
+}
+
+SCL_SIMD_SSE2 inline std::int32_t min(const std::int32_t* data, std::size_t n)
+{
+    if(n < 4) return scalar::min(data, n);
+    __m128i acc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    std::size_t i = 4;
+    for(; i+4 <= n; i+=4)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+i));
+        acc = blend(_mm_cmpgt_epi32(acc, block), block, acc);
+    }
+    alignas(16) std::int32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    std::int32_t result = scalar::min(lanes, 4);
+    return (i < n) ? std::min(result, scalar::min(data+i, n-i)) : result;
+}
+
+SCL_SIMD_SSE2 inline std::int32_t max(const std::int32_t* data, std::size_t n)
+{
+    if(n < 4) return scalar::max(data, n);
+    __m128i acc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    std::size_t i = 4;
+    for(; i+4 <= n; i+=4)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+i));
+        acc = blend(_mm_cmpgt_epi32(block, acc), block, acc);
+    }
+    alignas(16) std::int32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    std::int32_t result = scalar::max(lanes, 4);
+    return (i < n) ? std::max(result, scalar::max(data+i, n-i)) : result;
+}
+
+SCL_SIMD_SSE2 inline float min(const float* data, std::size_t n)
+{
+    if(n < 4) return scalar::min(data, n);
+    __m128 acc = _mm_loadu_ps(data);
+    std::size_t i = 4;
+    for(; i+4 <= n; i+=4)
+    {
+        acc = _mm_min_ps(acc, _mm_loadu_ps(data+i));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    float result = scalar::min(lanes, 4);
+    return (i < n) ? std::min(result, scalar::min(data+i, n-i)) : result;
+}
+
+SCL_SIMD_SSE2 inline float max(const float* data, std::size_t n)
+{
+    if(n < 4) return scalar::max(data, n);
+    __m128 acc = _mm_loadu_ps(data);
+    std::size_t i = 4;
+    for(; i+4 <= n; i+=4)
+    {
+        acc = _mm_max_ps(acc, _mm_loadu_ps(data+i));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    float result = scalar::max(lanes, 4);
+    return (i < n) ? std::max(result, scalar::max(data+i, n-i)) : result;
+}
+
+// SSE2 has no 64-bit compare, the unsigned min/max stay scalar
+inline std::uint64_t min(const std::uint64_t* data, std::size_t n){return scalar::min(data, n);}
+inline std::uint64_t max(const std::uint64_t* data, std::size_t n){return scalar::max(data, n);}
+
+SCL_SIMD_SSE2 inline std::int64_t sum(const std::int32_t* data, std::size_t n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    std::size_t i = 0;
+    for(; i+4 <= n; i+=4)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+i));
+        __m128i sign = _mm_cmpgt_epi32(zero, block);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(block, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(block, sign));
+    }
+    alignas(16) std::int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + scalar::sum(data+i, n-i);
+}
+
+SCL_SIMD_SSE2 inline double sum(const float* data, std::size_t n)
+{
+    __m128d acc_lo = _mm_setzero_pd(), acc_hi = _mm_setzero_pd();
+    std::size_t i = 0;
+    for(; i+4 <= n; i+=4)
+    {
+        __m128 block = _mm_loadu_ps(data+i);
+        acc_lo = _mm_add_pd(acc_lo, _mm_cvtps_pd(block));
+        acc_hi = _mm_add_pd(acc_hi, _mm_cvtps_pd(_mm_movehl_ps(block, block)));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, _mm_add_pd(acc_lo, acc_hi));
+    return lanes[0] + lanes[1] + scalar::sum(data+i, n-i);
+}
+
+SCL_SIMD_SSE2 inline std::uint64_t sum(const std::uint64_t* data, std::size_t n)
+{
+    __m128i acc = _mm_setzero_si128();
+    std::size_t i = 0;
+    for(; i+2 <= n; i+=2)
+    {
+        acc = _mm_add_epi64(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+i)));
+    }
+    alignas(16) std::uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + scalar::sum(data+i, n-i);
+}
+}
+
+namespace avx2 {
+const std::size_t count_block = std::size_t(1) << 24;
+
+SCL_SIMD_AVX2 inline std::size_t find(const std::int32_t* data, std::size_t n, std::int32_t value)
+{
+    const __m256i needle = _mm256_set1_epi32(value);
+    std::size_t i = 0;
+    for(; i+8 <= n; i+=8)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+        if(mask != 0) return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    return i + scalar::find(data+i, n-i, value);
+}
+
+SCL_SIMD_AVX2 inline std::size_t find(const float* data, std::size_t n, float value)
+{
+    const __m256 needle = _mm256_set1_ps(value);
+    std::size_t i = 0;
+    for(; i+8 <= n; i+=8)
+    {
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data+i), needle, _CMP_EQ_OQ));
+        if(mask != 0) return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    return i + scalar::find(data+i, n-i, value);
+}
+
+SCL_SIMD_AVX2 inline std::size_t find(const std::uint64_t* data, std::size_t n, std::uint64_t value)
+{
+    const __m256i needle = _mm256_set1_epi64x(static_cast<long long>(value));
+    std::size_t i = 0;
+    for(; i+4 <= n; i+=4)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+i));
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(block, needle)));
+        if(mask != 0) return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    return i + scalar::find(data+i, n-i, value);
+}
+
+SCL_SIMD_AVX2 inline std::size_t count(const std::int32_t* data, std::size_t n, std::int32_t value)
+{
+    const __m256i needle = _mm256_set1_epi32(value);
+    std::size_t total = 0, i = 0;
+    const std::size_t end = n - n % 8;
+    while(i < end)
+    {
+        // The lane counters are flushed before they can overflow
+        const std::size_t block_end = std::min(end, i + count_block*8);
+        __m256i acc = _mm256_setzero_si256();
+        for(; i < block_end; i+=8)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+i));
+            acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(block, needle));
+        }
+        alignas(32) std::uint32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        for(std::size_t l=0; l<8; ++l) total += lanes[l];
+    }
+    return total + scalar::count(data+i, n-i, value);
+}
+
+SCL_SIMD_AVX2 inline std::size_t count(const float* data, std::size_t n, float value)
+{
+    const __m256 needle = _mm256_set1_ps(value);
+    std::size_t total = 0, i = 0;
+    const std::size_t end = n - n % 8;
+    while(i < end)
+    {
+        const std::size_t block_end = std::min(end, i + count_block*8);
+        __m256i acc = _mm256_setzero_si256();
+        for(; i < block_end; i+=8)
+        {
+            __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(data+i), needle, _CMP_EQ_OQ);
+            acc = _mm256_sub_epi32(acc, _mm256_castps_si256(eq));
+        }
+        alignas(32) std::uint32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        for(std::size_t l=0; l<8; ++l) total += lanes[l];
+    }
+    return total + scalar::count(data+i, n-i, value);
+}
+
+SCL_SIMD_AVX2 inline std::size_t count(const std::uint64_t* data, std::size_t n, std::uint64_t value)
+{
+    const __m256i needle = _mm256_set1_epi64x(static_cast<long long>(value));
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for(; i+4 <= n; i+=4)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+i));
+        acc = _mm256_sub_epi64(acc, _mm256_cmpeq_epi64(block, needle));
+    }
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + scalar::count(data+i, n-i, value);
+}
+
+SCL_SIMD_AVX2 inline std::int32_t min(const std::int32_t* data, std::size_t n)
+{
+    if(n < 8) return scalar::min(data, n);
+    __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    std::size_t i = 8;
+    for(; i+8 <= n; i+=8)
+    {
+        acc = _mm256_min_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+i)));
+    }
+    alignas(32) std::int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    std::int32_t result = scalar::min(lanes, 8);
+    return (i < n) ? std::min(result, scalar::min(data+i, n-i)) : result;
+}
+
+SCL_SIMD_AVX2 inline std::int32_t max(const std::int32_t* data, std::size_t n)
+{
+    if(n < 8) return scalar::max(data, n);
+    __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    std::size_t i = 8;
+    for(; i+8 <= n; i+=8)
+    {
+        acc = _mm256_max_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+i)));
+    }
+    alignas(32) std::int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    std::int32_t result = scalar::max(lanes, 8);
+    return (i < n) ? std::max(result, scalar::max(data+i, n-i)) : result;
+}
+
+SCL_SIMD_AVX2 inline float min(const float* data, std::size_t n)
+{
+    if(n < 8) return scalar::min(data, n);
+    __m256 acc = _mm256_loadu_ps(data);
+    std::size_t i = 8;
+    for(; i+8 <= n; i+=8)
+    {
+        acc = _mm256_min_ps(acc, _mm256_loadu_ps(data+i));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, acc);
+    float result = scalar::min(lanes, 8);
+    return (i < n) ? std::min(result, scalar::min(data+i, n-i)) : result;
+}
+
+SCL_SIMD_AVX2 inline float max(const float* data, std::size_t n)
+{
+    if(n < 8) return scalar::max(data, n);
+    __m256 acc = _mm256_loadu_ps(data);
+    std::size_t i = 8;
+    for(; i+8 <= n; i+=8)
+    {
+        acc = _mm256_max_ps(acc, _mm256_loadu_ps(data+i));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, acc);
+    float result = scalar::max(lanes, 8);
+    return (i < n) ? std::max(result, scalar::max(data+i, n-i)) : result;
+}
+
+SCL_SIMD_AVX2 inline std::uint64_t min(const std::uint64_t* data, std::size_t n)
+{
+    if(n < 4) return scalar::min(data, n);
+    // The sign bit flip turns the signed compare into the unsigned one
+    const __m256i bias = _mm256_set1_epi64x(static_cast<long long>(std::uint64_t(1) << 63));
+    __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    std::size_t i = 4;
+    for(; i+4 <= n; i+=4)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+i));
+        __m256i gt = _mm256_cmpgt_epi64(_mm256_xor_si256(acc, bias), _mm256_xor_si256(block, bias));
+        acc = _mm256_blendv_epi8(acc, block, gt);
+    }
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    std::uint64_t result = scalar::min(lanes, 4);
+    return (i < n) ? std::min(result, scalar::min(data+i, n-i)) : result;
+}
+
+SCL_SIMD_AVX2 inline std::uint64_t max(const std::uint64_t* data, std::size_t n)
+{
+    if(n < 4) return scalar::max(data, n);
+    const __m256i bias = _mm256_set1_epi64x(static_cast<long long>(std::uint64_t(1) << 63));
+    __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    std::size_t i = 4;
+    for(; i+4 <= n; i+=4)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+i));
+        __m256i gt = _mm256_cmpgt_epi64(_mm256_xor_si256(block, bias), _mm256_xor_si256(acc, bias));
+        acc = _mm256_blendv_epi8(acc, block, gt);
+    }
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    std::uint64_t result = scalar::max(lanes, 4);
+    return (i < n) ? std::max(result, scalar::max(data+i, n-i)) : result;
+}
+
+SCL_SIMD_AVX2 inline std::int64_t sum(const std::int32_t* data, std::size_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for(; i+8 <= n; i+=8)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(block)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(block, 1)));
+    }
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::sum(data+i, n-i);
+}
+
+SCL_SIMD_AVX2 inline double sum(const float* data, std::size_t n)
+{
+    __m256d acc_lo = _mm256_setzero_pd(), acc_hi = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for(; i+8 <= n; i+=8)
+    {
+        __m256 block = _mm256_loadu_ps(data+i);
+        acc_lo = _mm256_add_pd(acc_lo, _mm256_cvtps_pd(_mm256_castps256_ps128(block)));
+        acc_hi = _mm256_add_pd(acc_hi, _mm256_cvtps_pd(_mm256_extractf128_ps(block, 1)));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(acc_lo, acc_hi));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::sum(data+i, n-i);
+}
+
+SCL_SIMD_AVX2 inline std::uint64_t sum(const std::uint64_t* data, std::size_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for(; i+4 <= n; i+=4)
+    {
+        acc = _mm256_add_epi64(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+i)));
+    }
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::sum(data+i, n-i);
+}
+}
+#endif
+
+/**
+ * @brief Index of the first element equal to value.
+ * @return The index, or n if there is no such element.
+ */
+template<class T>
+std::size_t find(const T* data, std::size_t n, T value)
+{
+#ifdef SCL_SIMD_X86
+    switch(active_isa())
+    {
+    case isa::avx2: return avx2::find(data, n, value);
+    case isa::sse2: return sse2::find(data, n, value);
+    default: break;
+    }
+#endif
+    return scalar::find(data, n, value);
+}
+
+/**
+ * @brief The number of elements equal to value.
+ */
+template<class T>
+std::size_t count(const T* data, std::size_t n, T value)
+{
+#ifdef SCL_SIMD_X86
+    switch(active_isa())
+    {
+    case isa::avx2: return avx2::count(data, n, value);
+    case isa::sse2: return sse2::count(data, n, value);
+    default: break;
+    }
+#endif
+    return scalar::count(data, n, value);
+}
+
+/**
+ * @brief The smallest element, the range must not be empty.
+ *        The result on the float NaN elements is unspecified.
+ */
+template<class T>
+T min(const T* data, std::size_t n)
+{
+    assert((n > 0) && "Simd error: min of the empty range");
+#ifdef SCL_SIMD_X86
+    switch(active_isa())
+    {
+    case isa::avx2: return avx2::min(data, n);
+    case isa::sse2: return sse2::min(data, n);
+    default: break;
+    }
+#endif
+    return scalar::min(data, n);
+}
+
+/**
+ * @brief The largest element, the range must not be empty.
+ *        The result on the float NaN elements is unspecified.
+ */
+template<class T>
+T max(const T* data, std::size_t n)
+{
+    assert((n > 0) && "Simd error: max of the empty range");
+#ifdef SCL_SIMD_X86
+    switch(active_isa())
+    {
+    case isa::avx2: return avx2::max(data, n);
+    case isa::sse2: return sse2::max(data, n);
+    default: break;
+    }
+#endif
+    return scalar::max(data, n);
+}
+
+/**
+ * @brief The sum of the elements.
+ *        The float elements are summed in double, the order of the additions
+ *        differs between the instruction sets.
+ */
+template<class T>
+typename sum_type<T>::type sum(const T* data, std::size_t n)
+{
+#ifdef SCL_SIMD_X86
+    switch(active_isa())
+    {
+    case isa::avx2: return avx2::sum(data, n);
+    case isa::sse2: return sse2::sum(data, n);
+    default: break;
+    }
+#endif
+    return scalar::sum(data, n);
+}
+
+/**
+ * @brief Checks whether the range holds the value.
+ */
+template<class T>
+bool contains(const T* data, std::size_t n, T value)
+{
+    return find(data, n, value) != n;
+}
+
+/**
+ * @brief The vector overloads work directly on the contiguous storage.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_iterator find(const vector<T, Allocator, GrowthPolicy>& vec, T value)
+{
+    return vec.cbegin() + static_cast<std::ptrdiff_t>(find(vec.data(), vec.size(), value));
+}
+
+template<class T, class Allocator, class GrowthPolicy>
+std::size_t count(const vector<T, Allocator, GrowthPolicy>& vec, T value)
+{
+    return count(vec.data(), vec.size(), value);
+}
+
+template<class T, class Allocator, class GrowthPolicy>
+T min(const vector<T, Allocator, GrowthPolicy>& vec)
+{
+    return min(vec.data(), vec.size());
+}
+
+template<class T, class Allocator, class GrowthPolicy>
+T max(const vector<T, Allocator, GrowthPolicy>& vec)
+{
+    return max(vec.data(), vec.size());
+}
+
+template<class T, class Allocator, class GrowthPolicy>
+typename sum_type<T>::type sum(const vector<T, Allocator, GrowthPolicy>& vec)
+{
+    return sum(vec.data(), vec.size());
+}
+
+template<class T, class Allocator, class GrowthPolicy>
+bool contains(const vector<T, Allocator, GrowthPolicy>& vec, T value)
+{
+    return contains(vec.data(), vec.size(), value);
+}
+
+}
+}
+
+#endif //SIMD_H
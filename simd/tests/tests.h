@@ -0,0 +1,189 @@
+#ifndef SIMD_TESTS_H
+#define SIMD_TESTS_H
+
+#include <iostream>
+#include <ctime>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include "vector.h"
+#include "simd.h"
+
+namespace simd_testing {
+const std::size_t max_size = 67;
+const std::size_t bench_elements = 50000000;
+const std::size_t bench_sizes[] = {16, 1024, 65536, 1048576, 16777216, 100000000};
+const int module = 1000;
+
+/**
+ * @brief get_time_sec - get time in seconds
+ * @return the time in seconds
+ */
+inline double get_time_sec()
+{
+    return static_cast<double>(clock())/ CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief get_new_time calculating the total time and setting the current time in seconds
+ * @param sum_time - summary time
+ * @param last_time - last time value
+ */
+void get_new_time(double &sum_time, double &last_time)
+{
+    sum_time += get_time_sec() - last_time;
+    last_time = get_time_sec();
+}
+
+/**
+ * @brief The supported instruction sets, the scalar is always first
+ */
+std::vector<scl::simd::isa> supported_isa()
+{
+    std::vector<scl::simd::isa> sets;
+    for(scl::simd::isa set : {scl::simd::isa::scalar, scl::simd::isa::sse2, scl::simd::isa::avx2})
+    {
+        if(scl::simd::is_supported(set)) sets.push_back(set);
+    }
+    return sets;
+}
+
+template<class T>
+T random_value()
+{
+    return static_cast<T>(std::rand() % module - (std::is_signed<T>::value ? module/2 : 0));
+}
+
+template<>
+std::uint64_t random_value<std::uint64_t>()
+{
+    // The high bit is set on the half of the values to check the unsigned compare
+    return (static_cast<std::uint64_t>(std::rand() & 1) << 63) | static_cast<std::uint64_t>(std::rand() % module);
+}
+
+/**
+ * @brief Compares the kernels of every instruction set to the scalar ones
+ *        on every size up to max_size, so all the tails are covered.
+ */
+template<class T>
+void check_kernels()
+{
+    std::vector<scl::simd::isa> sets = supported_isa();
+    for(std::size_t size=0; size<=max_size; ++size)
+    {
+        scl::vector<T> vec;
+        for(std::size_t i=0; i<size; ++i)
+        {
+            vec.push_back(random_value<T>());
+        }
+        const T* data = vec.data();
+        const T present = size ? data[size-1] : T(0);
+        const T absent = static_cast<T>(module*4);
+        for(scl::simd::isa set : sets)
+        {
+            scl::simd::set_isa(set);
+            ASSERT_EQ(scl::simd::find(data, size, present), scl::simd::scalar::find(data, size, present));
+            ASSERT_EQ(scl::simd::find(data, size, absent), size);
+            ASSERT_EQ(scl::simd::count(data, size, present), scl::simd::scalar::count(data, size, present));
+            ASSERT_EQ(scl::simd::count(vec, absent), 0U);
+            ASSERT_EQ(scl::simd::contains(vec, present), size != 0);
+            ASSERT_FALSE(scl::simd::contains(vec, absent));
+            ASSERT_TRUE(scl::simd::find(vec, absent) == vec.cend());
+            ASSERT_NEAR(static_cast<double>(scl::simd::sum(vec)),
+                        static_cast<double>(scl::simd::scalar::sum(data, size)), 1e-6);
+            if(size != 0)
+            {
+                ASSERT_EQ(scl::simd::min(vec), scl::simd::scalar::min(data, size));
+                ASSERT_EQ(scl::simd::max(vec), scl::simd::scalar::max(data, size));
+            }
+        }
+    }
+    scl::simd::set_isa(scl::simd::detect_isa());
+}
+
+/**
+ * @brief Times the kernels of every instruction set, each size is repeated
+ *        to process about bench_elements elements.
+ */
+template<class T>
+void bench_kernels(const char* name)
+{
+    std::vector<scl::simd::isa> sets = supported_isa();
+    const char* set_names[] = {"scalar", "sse2", "avx2"};
+    for(std::size_t size : bench_sizes)
+    {
+        scl::vector<T> vec(size);
+        for(std::size_t i=0; i<size; ++i)
+        {
+            vec[i] = static_cast<T>(i % module);
+        }
+        const std::size_t rounds = std::max<std::size_t>(1, bench_elements / size);
+        const T absent = static_cast<T>(module*4);
+        std::cout << name << " size " << size << ":";
+        std::size_t reference = 0;
+        for(scl::simd::isa set : sets)
+        {
+            scl::simd::set_isa(set);
+            double find_time = 0, count_time = 0, max_time = 0, sum_time = 0, last_time = get_time_sec();
+            std::size_t checksum = 0;
+            for(std::size_t r=0; r<rounds; ++r) checksum += scl::simd::find(vec.data(), size, absent);
+            get_new_time(find_time, last_time);
+            for(std::size_t r=0; r<rounds; ++r) checksum += scl::simd::count(vec.data(), size, T(1));
+            get_new_time(count_time, last_time);
+            for(std::size_t r=0; r<rounds; ++r) checksum += static_cast<std::size_t>(scl::simd::max(vec.data(), size));
+            get_new_time(max_time, last_time);
+            for(std::size_t r=0; r<rounds; ++r) checksum += static_cast<std::size_t>(scl::simd::sum(vec.data(), size));
+            get_new_time(sum_time, last_time);
+            std::cout << " | " << set_names[static_cast<int>(set)] << " find " << find_time << " count " << count_time
+                      << " max " << max_time << " sum " << sum_time << " s";
+            if(set == scl::simd::isa::scalar) reference = checksum;
+            ASSERT_EQ(checksum, reference);
+        }
+        std::cout << "\n";
+    }
+    scl::simd::set_isa(scl::simd::detect_isa());
+}
+
+TEST(CheckSimd, CheckInt32)
+{
+    check_kernels<std::int32_t>();
+}
+
+TEST(CheckSimd, CheckFloat)
+{
+    check_kernels<float>();
+}
+
+TEST(CheckSimd, CheckUint64)
+{
+    check_kernels<std::uint64_t>();
+}
+
+TEST(CheckSimd, CheckCountAcrossBlocks)
+{
+    //Arrange
+    const std::size_t size = (std::size_t(1) << 24) * 8 + 13;
+    std::vector<std::int32_t> data(size, 7);
+    //Act
+    //Assert
+    for(scl::simd::isa set : supported_isa())
+    {
+        scl::simd::set_isa(set);
+        ASSERT_EQ(scl::simd::count(data.data(), size, 7), size);
+    }
+    scl::simd::set_isa(scl::simd::detect_isa());
+}
+
+TEST(CompareSimd, Benchmark)
+{
+    std::cout << "active instruction set: " << static_cast<int>(scl::simd::active_isa()) << "\n";
+    bench_kernels<std::int32_t>("int32_t");
+    bench_kernels<float>("float");
+    bench_kernels<std::uint64_t>("uint64_t");
+}
+
+}
+
+#endif //SIMD_TESTS_H
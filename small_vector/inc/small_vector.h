@@ -0,0 +1,972 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <cassert>
+#include <utility>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include "vector.h"
+
+// Sequence containers library)
+namespace scl {
+
+/**
+ * Vector with the inline buffer
+ * @brief The first N elements are stored inside the object itself,
+ *  the heap storage is allocated by the Allocator only when the size exceeds N.
+ *  The interface is the same as scl::vector, the iterators are the ones of scl::vector
+ *  and the heap storage grows by the same GrowthPolicy.
+ *  Moving the small_vector with the inline elements moves the elements one by one,
+ *  moving the small_vector with the heap storage steals the storage.
+ */
+template<class T, std::size_t N, class Allocator = std::allocator<T>, class GrowthPolicy = growth_factor_1_5>
+class small_vector
+{
+    static_assert(N > 0, "small_vector error: the inline capacity must be greater than zero");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using inline_storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    Allocator m_alloc;
+    T* m_arr;
+    std::size_t m_size = 0;
+    std::size_t m_cap = N;
+    inline_storage m_buffer[N];
+
+    inline T* inline_data();
+    T* allocate(std::size_t n);
+    void deallocate(T* ptr, std::size_t n);
+    void replace_storage(T* new_arr, std::size_t new_cap);
+    void adopt_storage(T* new_arr, std::size_t new_cap);
+    void release();
+    void steal(small_vector<T, N, Allocator, GrowthPolicy>& other);
+    template<class... Args>
+    void realloc_insert(std::size_t index, Args&&... args);
+    template<class ForwardIt>
+    void range_insert(std::size_t index, ForwardIt first, std::size_t n);
+    template<class InputIt>
+    void range_insert(std::size_t index, InputIt first, InputIt last, std::input_iterator_tag);
+    template<class ForwardIt>
+    void range_insert(std::size_t index, ForwardIt first, ForwardIt last, std::forward_iterator_tag);
+
+public:
+    using iterator = typename vector<T, Allocator, GrowthPolicy>::iterator;
+    using const_iterator = typename vector<T, Allocator, GrowthPolicy>::const_iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    small_vector() noexcept;
+    explicit small_vector(const Allocator& alloc) noexcept;
+    explicit small_vector(std::size_t in, const Allocator& alloc = Allocator());
+    explicit small_vector(const small_vector<T, N, Allocator, GrowthPolicy>& other);
+    small_vector(small_vector<T, N, Allocator, GrowthPolicy>&& other)
+        noexcept(std::is_nothrow_move_constructible<T>::value);
+    ~small_vector();
+    small_vector<T, N, Allocator, GrowthPolicy>& operator=(const small_vector<T, N, Allocator, GrowthPolicy>& other);
+    small_vector<T, N, Allocator, GrowthPolicy>& operator=(small_vector<T, N, Allocator, GrowthPolicy>&& other);
+
+    Allocator get_allocator() const;
+
+    inline std::size_t capacity() const;
+    inline std::size_t size() const;
+    bool empty() const;
+    inline bool is_inline() const;
+
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    iterator end();
+    const_iterator end() const;
+    const_iterator cend() const;
+    reverse_iterator rbegin();
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator crbegin() const;
+    reverse_iterator rend();
+    const_reverse_iterator rend() const;
+    const_reverse_iterator crend() const;
+    T* data();
+    const T* data() const;
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+    void push_back(const T& data);
+    void push_back(T&& data);
+    template<class... Args>
+    T& emplace_back(Args&&... args);
+    template<class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+    iterator insert(const_iterator pos, std::size_t n, const T& value);
+    template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    void append(const T* data, std::size_t n);
+    void pop_back();
+
+    void reserve(std::size_t cap);
+    void resize(std::size_t size);
+
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    iterator unordered_erase(const_iterator pos);
+    template<class Pred>
+    std::size_t erase_if(Pred pred);
+    void clear();
+    void shrink_to_fit();
+
+    T& operator[](std::size_t index);
+    const T& operator[](std::size_t index) const;
+};
+
+/**
+ * @brief Default ctor, doesn't allocate
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+small_vector<T, N, Allocator, GrowthPolicy>::small_vector() noexcept
+{
+    m_arr = inline_data();
+}
+
+/**
+ * @brief Ctor with the allocator instance, doesn't allocate
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+small_vector<T, N, Allocator, GrowthPolicy>::small_vector(const Allocator& alloc) noexcept
+    :m_alloc(alloc)
+{
+    m_arr = inline_data();
+}
+
+/**
+ * @brief Ctor with set size parameters
+ *        If a ctor throws, the built elements and the heap storage are released.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+small_vector<T, N, Allocator, GrowthPolicy>::small_vector(std::size_t in, const Allocator& alloc)
+    :m_alloc(alloc)
+{
+    m_arr = inline_data();
+    try{
+        resize(in);
+    }
+    catch(...){
+        release();
+        throw;
+    }
+}
+
+/**
+ * @brief Copy ctor, the copy is inline if the elements fit into N
+ *        If a copy throws, the copied elements are destroyed and the heap storage is released.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+small_vector<T, N, Allocator, GrowthPolicy>::small_vector(const small_vector<T, N, Allocator, GrowthPolicy>& other)
+    :m_alloc(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+{
+    m_arr = inline_data();
+    reserve(other.m_size);
+    try{
+        detail::copy_construct_n(m_alloc, m_arr, static_cast<const T*>(other.m_arr), other.m_size);
+    }
+    catch(...){
+        release();
+        throw;
+    }
+    m_size = other.m_size;
+}
+
+/**
+ * @brief Move ctor, steals the heap storage or moves the inline elements.
+ *        Doesn't throw unless the move ctor of T throws for the inline elements.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+small_vector<T, N, Allocator, GrowthPolicy>::small_vector(small_vector<T, N, Allocator, GrowthPolicy>&& other)
+    noexcept(std::is_nothrow_move_constructible<T>::value)
+    :m_alloc(std::move(other.m_alloc))
+{
+    m_arr = inline_data();
+    steal(other);
+}
+
+/**
+ * @brief Dtor
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+small_vector<T, N, Allocator, GrowthPolicy>::~small_vector()
+{
+    detail::destroy(m_alloc, m_arr, m_arr+m_size);
+    if(!is_inline()){
+        deallocate(m_arr, m_cap);
+    }
+}
+
+/**
+ * @brief Assignment operator
+ *        The allocator is replaced if propagate_on_container_copy_assignment is set.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+small_vector<T, N, Allocator, GrowthPolicy>& small_vector<T, N, Allocator, GrowthPolicy>::operator=(const small_vector<T, N, Allocator, GrowthPolicy>& other)
+{
+    if(this == &other){
+        return *this;
+    }
+    clear();
+    if(alloc_traits::propagate_on_container_copy_assignment::value && m_alloc != other.m_alloc)
+    {
+        // Storage must be released by the allocator that obtained it
+        if(!is_inline()){
+            deallocate(m_arr, m_cap);
+            m_arr = inline_data();
+            m_cap = N;
+        }
+    }
+    if(alloc_traits::propagate_on_container_copy_assignment::value)
+    {
+        m_alloc = other.m_alloc;
+    }
+    reserve(other.m_size);
+    detail::copy_construct_n(m_alloc, m_arr, static_cast<const T*>(other.m_arr), other.m_size);
+    m_size = other.m_size;
+    return *this;
+}
+
+/**
+ * @brief Move assignment operator
+ *        The heap storage is stolen if the allocator propagates on move assignment or
+ *        both allocators are equal, otherwise the elements are moved one by one.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+small_vector<T, N, Allocator, GrowthPolicy>& small_vector<T, N, Allocator, GrowthPolicy>::operator=(small_vector<T, N, Allocator, GrowthPolicy>&& other)
+{
+    if(this == &other){
+        return *this;
+    }
+    clear();
+    if(alloc_traits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc)
+    {
+        if(!is_inline()){
+            deallocate(m_arr, m_cap);
+            m_arr = inline_data();
+            m_cap = N;
+        }
+        if(alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            m_alloc = std::move(other.m_alloc);
+        }
+        steal(other);
+        return *this;
+    }
+    reserve(other.m_size);
+    for(; m_size<other.m_size; ++m_size)
+    {
+        alloc_traits::construct(m_alloc, m_arr+m_size, std::move(other.m_arr[m_size]));
+    }
+    return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the container.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+Allocator small_vector<T, N, Allocator, GrowthPolicy>::get_allocator() const
+{
+    return m_alloc;
+}
+
+/**
+ * @brief The number of elements that the container has currently allocated space for.
+ * @return N while the elements are inline, the heap capacity otherwise.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+std::size_t small_vector<T, N, Allocator, GrowthPolicy>::capacity() const
+{
+    return m_cap;
+}
+
+/**
+ * @brief The number of elements.
+ * @return The number of elements in the container.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+std::size_t small_vector<T, N, Allocator, GrowthPolicy>::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief Checks whether the container is empty.
+ * @return True if is empty, false otherwise.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+bool small_vector<T, N, Allocator, GrowthPolicy>::empty() const
+{
+    return m_size == 0;
+}
+
+/**
+ * @brief Checks whether the elements are stored in the inline buffer.
+ * @return True if no heap storage is used, false otherwise.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+bool small_vector<T, N, Allocator, GrowthPolicy>::is_inline() const
+{
+    return m_arr == reinterpret_cast<const T*>(m_buffer);
+}
+
+/**
+* @brief Begin iterator.
+* @return An iterator to the first element.
+*/
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::iterator small_vector<T, N, Allocator, GrowthPolicy>::begin()
+{
+    return iterator(m_arr);
+}
+
+/**
+ * @brief Begin iterator of the constant container.
+ * @return An const iterator to the first element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::const_iterator small_vector<T, N, Allocator, GrowthPolicy>::begin() const
+{
+    return const_iterator(m_arr);
+}
+
+/**
+ * @brief Const begin iterator.
+ * @return An const iterator to the first element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::const_iterator small_vector<T, N, Allocator, GrowthPolicy>::cbegin() const
+{
+    return const_iterator(m_arr);
+}
+
+/**
+ * @brief End iterator.
+ * @return An iterator to one past the last element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::iterator small_vector<T, N, Allocator, GrowthPolicy>::end()
+{
+    return iterator(m_arr+m_size);
+}
+
+/**
+ * @brief End iterator of the constant container.
+ * @return An const iterator to one past the last element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::const_iterator small_vector<T, N, Allocator, GrowthPolicy>::end() const
+{
+    return const_iterator(m_arr+m_size);
+}
+
+/**
+ * @brief Const end iterator.
+ * @return An const iterator to one past the last element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::const_iterator small_vector<T, N, Allocator, GrowthPolicy>::cend() const
+{
+    return const_iterator(m_arr+m_size);
+}
+
+/**
+ * @brief Reverse begin iterator.
+ * @return A reverse iterator to the last element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::reverse_iterator small_vector<T, N, Allocator, GrowthPolicy>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+/**
+ * @brief Reverse begin iterator of the constant container.
+ * @return A const reverse iterator to the last element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::const_reverse_iterator small_vector<T, N, Allocator, GrowthPolicy>::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+/**
+ * @brief Const reverse begin iterator.
+ * @return A const reverse iterator to the last element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::const_reverse_iterator small_vector<T, N, Allocator, GrowthPolicy>::crbegin() const
+{
+    return const_reverse_iterator(cend());
+}
+
+/**
+ * @brief Reverse end iterator.
+ * @return A reverse iterator to one before the first element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::reverse_iterator small_vector<T, N, Allocator, GrowthPolicy>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+/**
+ * @brief Reverse end iterator of the constant container.
+ * @return A const reverse iterator to one before the first element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::const_reverse_iterator small_vector<T, N, Allocator, GrowthPolicy>::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+/**
+ * @brief Const reverse end iterator.
+ * @return A const reverse iterator to one before the first element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::const_reverse_iterator small_vector<T, N, Allocator, GrowthPolicy>::crend() const
+{
+    return const_reverse_iterator(cbegin());
+}
+
+/**
+ * @brief Direct access to the storage, inline or heap.
+ * @return Pointer to the first element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+T* small_vector<T, N, Allocator, GrowthPolicy>::data()
+{
+    return m_arr;
+}
+
+/**
+ * @brief Direct access to the storage of the constant container.
+ * @return Pointer to the first element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+const T* small_vector<T, N, Allocator, GrowthPolicy>::data() const
+{
+    return m_arr;
+}
+
+/**
+ * @brief Get a first element from the array.
+ * @return The first element from the array
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+T& small_vector<T, N, Allocator, GrowthPolicy>::front()
+{
+    return m_arr[0];
+}
+
+/**
+ * @brief Get a first element from the constant array.
+ * @return The first element from the array
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+const T& small_vector<T, N, Allocator, GrowthPolicy>::front() const
+{
+    return m_arr[0];
+}
+
+/**
+ * @brief Get a back element from the array.
+ * @return The back element from the array
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+T& small_vector<T, N, Allocator, GrowthPolicy>::back()
+{
+    return m_arr[m_size-1];
+}
+
+/**
+ * @brief Get a back element from the constant array.
+ * @return The back element from the array
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+const T& small_vector<T, N, Allocator, GrowthPolicy>::back() const
+{
+    return m_arr[m_size-1];
+}
+
+/**
+ * @brief Adds an element to the end.
+ *        If no space to add an element, then the elements are moved to the heap storage.
+ * @param The const reference to the element for add.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::push_back(const T& data)
+{
+    emplace_back(data);
+}
+
+/**
+ * @brief Adds an element to the end, the element is moved into the container.
+ * @param The rvalue reference to the element for add.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::push_back(T&& data)
+{
+    emplace_back(std::move(data));
+}
+
+/**
+ * @brief Constructs an element in place at the end.
+ * @param args Arguments forwarded to the constructor of the element.
+ * @return Reference to the inserted element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+template<class... Args>
+T& small_vector<T, N, Allocator, GrowthPolicy>::emplace_back(Args&&... args)
+{
+    if(m_size >= m_cap)
+    {
+        realloc_insert(m_size, std::forward<Args>(args)...);
+    }
+    else
+    {
+        alloc_traits::construct(m_alloc, m_arr+m_size, std::forward<Args>(args)...);
+        ++m_size;
+    }
+    return m_arr[m_size-1];
+}
+
+/**
+ * @brief Constructs an element in place before pos.
+ * @param pos Iterator before which the element will be constructed.
+ * @param args Arguments forwarded to the constructor of the element.
+ * @return Iterator pointing to the emplaced element.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+template<class... Args>
+typename small_vector<T, N, Allocator, GrowthPolicy>::iterator small_vector<T, N, Allocator, GrowthPolicy>::emplace(const_iterator pos, Args&&... args)
+{
+    std::size_t index = static_cast<std::size_t>(pos.base() - m_arr);
+    assert((index <= m_size) && "small_vector error: emplace position out of range");
+    if(m_size >= m_cap)
+    {
+        realloc_insert(index, std::forward<Args>(args)...);
+    }
+    else if(index == m_size)
+    {
+        alloc_traits::construct(m_alloc, m_arr+m_size, std::forward<Args>(args)...);
+        ++m_size;
+    }
+    else
+    {
+        // args may refer to the elements which will be shifted
+        T tmp(std::forward<Args>(args)...);
+        alloc_traits::construct(m_alloc, m_arr+m_size, std::move(m_arr[m_size-1]));
+        detail::move_storage(m_arr+index+1, m_arr+index, m_size-index-1);
+        m_arr[index] = std::move(tmp);
+        ++m_size;
+    }
+    return iterator(m_arr+index);
+}
+
+/**
+ * @brief Inserts n copies of value before pos.
+ *        The storage grows at most once.
+ * @param pos Iterator before which the elements will be inserted.
+ * @param n The number of the copies.
+ * @param value The value to copy, may refer to the element of the container.
+ * @return Iterator pointing to the first inserted element, or pos if n == 0.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::iterator small_vector<T, N, Allocator, GrowthPolicy>::insert(const_iterator pos, std::size_t n, const T& value)
+{
+    std::size_t index = static_cast<std::size_t>(pos.base() - m_arr);
+    assert((index <= m_size) && "small_vector error: insert position out of range");
+    if(n == 0){
+        return iterator(m_arr+index);
+    }
+    T tmp(value);
+    detail::fill_iterator<T> fill{&tmp};
+    range_insert(index, fill, n);
+    return iterator(m_arr+index);
+}
+
+/**
+ * @brief Inserts the elements from the range [first, last) before pos.
+ *        The storage grows at most once for the forward iterators.
+ *        The range must not refer to the elements of the container.
+ * @param pos Iterator before which the elements will be inserted.
+ * @return Iterator pointing to the first inserted element, or pos if first == last.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+template<class InputIt, class>
+typename small_vector<T, N, Allocator, GrowthPolicy>::iterator small_vector<T, N, Allocator, GrowthPolicy>::insert(const_iterator pos, InputIt first, InputIt last)
+{
+    std::size_t index = static_cast<std::size_t>(pos.base() - m_arr);
+    assert((index <= m_size) && "small_vector error: insert position out of range");
+    range_insert(index, first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    return iterator(m_arr+index);
+}
+
+/**
+ * @brief Appends n elements from the array data to the end.
+ *        The storage grows at most once, trivially copyable types are copied by memcpy.
+ *        The array must not refer to the elements of the container.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::append(const T* data, std::size_t n)
+{
+    range_insert(m_size, data, n);
+}
+
+/**
+ * @brief Removes the last element of the container.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::pop_back()
+{
+    --m_size;
+    alloc_traits::destroy(m_alloc, m_arr+m_size);
+}
+
+/**
+ * @brief Increases the capacity of the container to a value greater or equal to new_cap.
+ *        If new_cap is greater than the current capacity(), the heap storage is allocated,
+ *        otherwise the method does nothing.
+ * @param cap new capacity of the container.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::reserve(std::size_t cap)
+{
+    if(cap <= m_cap){
+        return;
+    }
+    replace_storage(allocate(cap), cap);
+}
+
+/**
+ * @brief Resize policy. Sets the size of the container to the specified value.
+ * @param size new container size.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::resize(std::size_t size)
+{
+    if(size < m_size){
+        detail::destroy(m_alloc, m_arr+size, m_arr+m_size);
+        m_size = size;
+        return;
+    }
+    reserve(size);
+    for(; m_size<size; ++m_size)
+    {
+        alloc_traits::construct(m_alloc, m_arr+m_size);
+    }
+}
+
+/**
+* @brief Erases an element at pos.
+* @param pos Iterator to the element to remove.
+* @return Iterator following the last removed element.
+*         If the iterator pos refers to the last element, the end() iterator is returned.
+*/
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::iterator small_vector<T, N, Allocator, GrowthPolicy>::erase(const_iterator pos)
+{
+    std::size_t index = static_cast<std::size_t>(pos.base() - m_arr);
+    assert((index < m_size) && "small_vector error: erase position out of range");
+    detail::move_storage(m_arr+index, m_arr+index+1, m_size-index-1);
+    m_size--;
+    alloc_traits::destroy(m_alloc, m_arr+m_size);
+    return iterator(m_arr+index);
+}
+
+/**
+* @brief Erases the elements in the range [first, last).
+*        The tail is shifted once, trivially copyable types use memmove.
+* @return Iterator following the last removed element.
+*/
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::iterator small_vector<T, N, Allocator, GrowthPolicy>::erase(const_iterator first, const_iterator last)
+{
+    std::size_t i = static_cast<std::size_t>(first.base() - m_arr);
+    std::size_t j = static_cast<std::size_t>(last.base() - m_arr);
+    assert((i <= j && j <= m_size) && "small_vector error: erase range out of range");
+    if(i == j){
+        return iterator(m_arr+i);
+    }
+    detail::move_storage(m_arr+i, m_arr+j, m_size-j);
+    detail::destroy(m_alloc, m_arr+m_size-(j-i), m_arr+m_size);
+    m_size -= j-i;
+    return iterator(m_arr+i);
+}
+
+/**
+* @brief Erases an element at pos in O(1), the order of the elements is not preserved.
+*        The back element is moved into pos.
+* @param pos Iterator to the element to remove.
+* @return Iterator to the element moved into pos, or end() if pos was the back element.
+*/
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+typename small_vector<T, N, Allocator, GrowthPolicy>::iterator small_vector<T, N, Allocator, GrowthPolicy>::unordered_erase(const_iterator pos)
+{
+    std::size_t index = static_cast<std::size_t>(pos.base() - m_arr);
+    assert((index < m_size) && "small_vector error: erase position out of range");
+    if(index != m_size-1){
+        m_arr[index] = std::move(m_arr[m_size-1]);
+    }
+    pop_back();
+    return iterator(m_arr+index);
+}
+
+/**
+* @brief Erases all elements satisfying the predicate in a single pass,
+*        see detail::remove_if(). The storage is kept, inline or heap.
+* @param pred Unary predicate returning true for the elements to remove.
+* @return The number of removed elements.
+*/
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+template<class Pred>
+std::size_t small_vector<T, N, Allocator, GrowthPolicy>::erase_if(Pred pred)
+{
+    std::size_t keep = detail::remove_if(m_alloc, m_arr, m_size, pred);
+    std::size_t removed = m_size-keep;
+    m_size = keep;
+    return removed;
+}
+
+/**
+ * @brief Remove elements from the container
+ *        The capacity is kept, the heap storage is not returned to the inline buffer.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::clear()
+{
+    detail::destroy(m_alloc, m_arr, m_arr+m_size);
+    m_size = 0;
+}
+
+/**
+ * @brief Reduces the capacity to the size. The elements return to the inline buffer
+ *        if they fit into N, otherwise they are relocated into the heap storage of exact size.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::shrink_to_fit()
+{
+    if(is_inline() || m_size == m_cap){
+        return;
+    }
+    if(m_size > N){
+        replace_storage(allocate(m_size), m_size);
+        return;
+    }
+    detail::relocate(m_alloc, inline_data(), m_arr, m_size);
+    deallocate(m_arr, m_cap);
+    m_arr = inline_data();
+    m_cap = N;
+}
+
+/**
+ * @brief Operator array subscripting.
+ * @param index The index of the element.
+ * @return A reference to the element at specified location index.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+T& small_vector<T, N, Allocator, GrowthPolicy>::operator[](std::size_t index)
+{
+    return m_arr[index];
+}
+
+/**
+ * @brief Constant operator array subscripting
+ * @param index The index of the element.
+ * @return A constant reference to the element at specified location index.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+const T& small_vector<T, N, Allocator, GrowthPolicy>::operator[](std::size_t index) const
+{
+    return m_arr[index];
+}
+
+/**
+ * @brief Pointer to the inline buffer.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+T* small_vector<T, N, Allocator, GrowthPolicy>::inline_data()
+{
+    return reinterpret_cast<T*>(m_buffer);
+}
+
+/**
+ * @brief Allocates the uninitialized heap storage for n elements using the allocator.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+T* small_vector<T, N, Allocator, GrowthPolicy>::allocate(std::size_t n)
+{
+    assert((n <= alloc_traits::max_size(m_alloc)) && "small_vector error: requested size is too large");
+    return alloc_traits::allocate(m_alloc, n);
+}
+
+/**
+ * @brief Returns the heap storage of n elements to the allocator.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::deallocate(T* ptr, std::size_t n)
+{
+    alloc_traits::deallocate(m_alloc, ptr, n);
+}
+
+/**
+ * @brief Relocates elements into the new_arr heap storage and releases the old heap storage.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::replace_storage(T* new_arr, std::size_t new_cap)
+{
+    try{
+        detail::relocate(m_alloc, new_arr, m_arr, m_size);
+    }
+    catch(...){
+        deallocate(new_arr, new_cap);
+        throw;
+    }
+    adopt_storage(new_arr, new_cap);
+}
+
+/**
+ * @brief Releases the old heap storage, its elements must be finished before,
+ *        and takes the new_arr heap storage filled by the elements.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::adopt_storage(T* new_arr, std::size_t new_cap)
+{
+    if(!is_inline()){
+        deallocate(m_arr, m_cap);
+    }
+    m_arr = new_arr;
+    m_cap = new_cap;
+}
+
+/**
+ * @brief Destroys the elements and returns the heap storage to the allocator,
+ *        the container is left empty and inline.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::release()
+{
+    detail::destroy(m_alloc, m_arr, m_arr+m_size);
+    if(!is_inline()){
+        deallocate(m_arr, m_cap);
+    }
+    m_arr = inline_data();
+    m_cap = N;
+    m_size = 0;
+}
+
+/**
+ * @brief Takes the elements of other, this must be empty and inline.
+ *        The heap storage is stolen, the inline elements are relocated one by one.
+ *        other is left empty and inline.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::steal(small_vector<T, N, Allocator, GrowthPolicy>& other)
+{
+    if(other.is_inline()){
+        detail::relocate(m_alloc, m_arr, other.m_arr, other.m_size);
+        m_size = other.m_size;
+        other.m_size = 0;
+        return;
+    }
+    m_arr = other.m_arr;
+    m_size = other.m_size;
+    m_cap = other.m_cap;
+    other.m_arr = other.inline_data();
+    other.m_size = 0;
+    other.m_cap = N;
+}
+
+/**
+ * @brief Grows the storage and constructs the new element at index in the new storage,
+ *        see detail::relocate_insert().
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+template<class... Args>
+void small_vector<T, N, Allocator, GrowthPolicy>::realloc_insert(std::size_t index, Args&&... args)
+{
+    std::size_t new_cap = GrowthPolicy::next_capacity(m_cap, m_size+1, sizeof(T));
+    T* new_arr = allocate(new_cap);
+    try{
+        detail::relocate_insert(m_alloc, new_arr, m_arr, m_size, index, std::forward<Args>(args)...);
+    }
+    catch(...){
+        deallocate(new_arr, new_cap);
+        throw;
+    }
+    adopt_storage(new_arr, new_cap);
+    ++m_size;
+}
+
+/**
+ * @brief Inserts n elements from first at index, the storage grows at most once,
+ *        see detail::relocate_range_insert() and detail::shift_insert().
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+template<class ForwardIt>
+void small_vector<T, N, Allocator, GrowthPolicy>::range_insert(std::size_t index, ForwardIt first, std::size_t n)
+{
+    if(n == 0){
+        return;
+    }
+    if(m_size+n > m_cap)
+    {
+        std::size_t new_cap = GrowthPolicy::next_capacity(m_cap, m_size+n, sizeof(T));
+        T* new_arr = allocate(new_cap);
+        try{
+            detail::relocate_range_insert(m_alloc, new_arr, m_arr, m_size, index, first, n);
+        }
+        catch(...){
+            deallocate(new_arr, new_cap);
+            throw;
+        }
+        adopt_storage(new_arr, new_cap);
+        m_size += n;
+        return;
+    }
+    detail::shift_insert(m_alloc, m_arr, m_size, index, first, n);
+    m_size += n;
+}
+
+/**
+ * @brief Inserts the single pass range, the elements are appended one by one
+ *        and then rotated into the place.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+template<class InputIt>
+void small_vector<T, N, Allocator, GrowthPolicy>::range_insert(std::size_t index, InputIt first, InputIt last, std::input_iterator_tag)
+{
+    std::size_t old_size = m_size;
+    for(; first != last; ++first)
+    {
+        emplace_back(*first);
+    }
+    std::rotate(m_arr+index, m_arr+old_size, m_arr+m_size);
+}
+
+/**
+ * @brief Inserts the multi pass range, the distance is computed once.
+ */
+template<class T, std::size_t N, class Allocator, class GrowthPolicy>
+template<class ForwardIt>
+void small_vector<T, N, Allocator, GrowthPolicy>::range_insert(std::size_t index, ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+{
+    range_insert(index, first, static_cast<std::size_t>(std::distance(first, last)));
+}
+
+}
+
+#endif //SMALL_VECTOR_H
@@ -0,0 +1,280 @@
+#ifndef SMALL_VECTOR_TESTS_H
+#define SMALL_VECTOR_TESTS_H
+
+#include <iostream>
+#include <ctime>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <iterator>
+#include <algorithm>
+#include "vector.h"
+#include "small_vector.h"
+
+namespace small_vector_testing {
+const std::size_t inline_size = 8;
+const std::size_t num_of_vectors = 200000;
+const int module = 1000000;
+
+/**
+ * @brief get_time_sec - get time in seconds
+ * @return the time in seconds
+ */
+inline double get_time_sec()
+{
+    return static_cast<double>(clock())/ CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief get_new_time calculating the total time and setting the current time in seconds
+ * @param sum_time - summary time
+ * @param last_time - last time value
+ */
+void get_new_time(double &sum_time, double &last_time)
+{
+    sum_time += get_time_sec() - last_time;
+    last_time = get_time_sec();
+}
+
+/**
+ * @brief Allocator counting the allocations of the instance group
+ */
+template<typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    std::size_t *m_allocs;
+
+    explicit CountingAllocator(std::size_t *allocs) noexcept:m_allocs(allocs){}
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept:m_allocs(other.m_allocs){}
+
+    T* allocate(std::size_t n)
+    {
+        ++*m_allocs;
+        return static_cast<T*>(::operator new(n*sizeof(T)));
+    }
+    void deallocate(T* ptr, std::size_t)
+    {
+        ::operator delete(ptr);
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const CountingAllocator<T>& lhs, const CountingAllocator<U>& rhs){return lhs.m_allocs == rhs.m_allocs;}
+template<typename T, typename U>
+bool operator!=(const CountingAllocator<T>& lhs, const CountingAllocator<U>& rhs){return !(lhs == rhs);}
+
+using counted_small_vector = scl::small_vector<int, inline_size, CountingAllocator<int>>;
+using counted_vector = scl::vector<int, CountingAllocator<int>>;
+
+class SmallVectorCheckFixture: public ::testing::Test
+{
+public:
+    std::size_t allocs = 0;
+    counted_small_vector *vec;
+
+    static void SetUpTestSuite() {std::cout << "Set Up Test Suite" << "\n";}
+    static void TearDownTestSuite() {std::cout << "Tear Down Test Suite" << "\n";}
+
+protected:
+
+    void SetUp() override
+    {
+        allocs = 0;
+        vec = new counted_small_vector(CountingAllocator<int>(&allocs));
+    }
+
+    void TearDown() override
+    {
+        delete vec;
+    }
+};
+
+TEST_F(SmallVectorCheckFixture, CheckInline)
+{
+    //Arrange
+    //Act
+    for(std::size_t i=0; i<inline_size; ++i)
+    {
+        vec->push_back(static_cast<int>(i));
+    }
+    //Assert
+    ASSERT_TRUE(vec->is_inline());
+    ASSERT_EQ(allocs, 0U);
+    ASSERT_EQ(vec->size(), inline_size);
+    ASSERT_EQ(vec->capacity(), inline_size);
+    ASSERT_EQ(vec->front(), 0);
+    ASSERT_EQ(vec->back(), static_cast<int>(inline_size-1));
+}
+
+TEST_F(SmallVectorCheckFixture, CheckSpill)
+{
+    //Arrange
+    //Act
+    for(std::size_t i=0; i<=inline_size; ++i)
+    {
+        vec->push_back(static_cast<int>(i));
+    }
+    //Assert
+    ASSERT_FALSE(vec->is_inline());
+    ASSERT_EQ(allocs, 1U);
+    ASSERT_EQ(vec->size(), inline_size+1);
+    for(std::size_t i=0; i<=inline_size; ++i)
+    {
+        ASSERT_EQ((*vec)[i], static_cast<int>(i));
+    }
+    vec->clear();
+    ASSERT_TRUE(vec->empty());
+    ASSERT_GT(vec->capacity(), inline_size);
+}
+
+TEST(CheckSmallVector, CheckCopyAndMove)
+{
+    //Arrange
+    scl::small_vector<std::string, 4> small, large;
+    for(std::size_t i=0; i<3; ++i)
+    {
+        small.emplace_back(std::to_string(i));
+    }
+    for(std::size_t i=0; i<100; ++i)
+    {
+        large.emplace_back(64, static_cast<char>('a' + i % 26));
+    }
+    large.emplace(large.begin(), "first");
+    const char* large_data = large[0].data();
+    //Act
+    scl::small_vector<std::string, 4> small_copy(small);
+    scl::small_vector<std::string, 4> small_moved(std::move(small));
+    scl::small_vector<std::string, 4> large_moved(std::move(large));
+    scl::small_vector<std::string, 4> assigned;
+    assigned = large_moved;
+    assigned = std::move(small_copy);
+    //Assert
+    ASSERT_TRUE(small.empty());
+    ASSERT_TRUE(small.is_inline());
+    ASSERT_TRUE(large.empty());
+    ASSERT_TRUE(large.is_inline());
+    ASSERT_TRUE(small_moved.is_inline());
+    ASSERT_EQ(small_moved[2], "2");
+    ASSERT_FALSE(large_moved.is_inline());
+    ASSERT_EQ(large_moved.size(), 101U);
+    ASSERT_EQ(large_moved[0].data(), large_data);
+    ASSERT_EQ(assigned.size(), 3U);
+    ASSERT_EQ(assigned[1], "1");
+}
+
+TEST(CheckSmallVector, CheckRangesAndShrink)
+{
+    //Arrange
+    scl::small_vector<std::string, 4> strs;
+    const std::string words[] = {"b", "c", "d"};
+    scl::small_vector<int, 4, std::allocator<int>, scl::growth_factor_2> ints;
+    const int values[] = {1, 2, 3, 4, 5};
+    //Act
+    strs.push_back("a");
+    strs.insert(strs.cend(), std::begin(words), std::end(words));
+    const bool full_inline = strs.is_inline();
+    strs.insert(strs.cbegin() + 1, 2, strs[0]);
+    strs.erase(strs.cbegin(), strs.cbegin() + 3);
+    ints.append(values, 4);
+    ints.push_back(5);
+    //Assert
+    ASSERT_TRUE(full_inline);
+    ASSERT_FALSE(strs.is_inline());
+    ASSERT_EQ(strs.size(), 3U);
+    ASSERT_EQ(strs.front(), "b");
+    ASSERT_EQ(strs.back(), "d");
+    strs.shrink_to_fit();
+    ASSERT_TRUE(strs.is_inline());
+    ASSERT_EQ(strs.capacity(), 4U);
+    const scl::small_vector<std::string, 4>& cstrs = strs;
+    ASSERT_TRUE(std::equal(cstrs.begin(), cstrs.end(), std::begin(words)));
+    ASSERT_EQ(cstrs.cend() - cstrs.cbegin(), 3);
+    ASSERT_EQ(ints.capacity(), 8U);
+    ASSERT_TRUE(std::equal(ints.cbegin(), ints.cend(), std::begin(values)));
+    ints.append(values, 5);
+    ints.shrink_to_fit();
+    ASSERT_FALSE(ints.is_inline());
+    ASSERT_EQ(ints.capacity(), 10U);
+    ASSERT_EQ(*ints.erase(ints.cbegin() + 4), 1);
+}
+
+TEST(CheckSmallVector, CheckEraseAndReverse)
+{
+    //Arrange
+    static_assert(std::is_nothrow_move_constructible<scl::small_vector<std::string, 4>>::value,
+                  "small_vector error: the move ctor must not throw");
+    scl::small_vector<std::string, 4> strs;
+    scl::small_vector<int, 4> ints;
+    for(int i=0; i<10; ++i)
+    {
+        strs.emplace_back(std::to_string(i));
+        ints.push_back(i);
+    }
+    //Act
+    auto it = strs.unordered_erase(strs.cbegin() + 2);
+    const std::size_t removed = ints.erase_if([](int value){return value % 3 == 0;});
+    strs.unordered_erase(strs.cend() - 1);
+    //Assert
+    ASSERT_EQ(*it, "9");
+    ASSERT_EQ(strs.size(), 8U);
+    ASSERT_EQ(strs.back(), "7");
+    ASSERT_EQ(removed, 4U);
+    const int kept[] = {8, 7, 5, 4, 2, 1};
+    ASSERT_TRUE(std::equal(ints.rbegin(), ints.rend(), std::begin(kept)));
+    const scl::small_vector<int, 4>& cints = ints;
+    ASSERT_TRUE(std::equal(cints.crbegin(), cints.crend(), std::begin(kept)));
+    ASSERT_EQ(*cints.rbegin(), 8);
+    ASSERT_EQ(cints.rend() - cints.rbegin(), 6);
+    ASSERT_EQ(ints.erase_if([](int value){return value > 100;}), 0U);
+    ASSERT_EQ(ints.erase_if([](int){return true;}), 6U);
+    ASSERT_TRUE(ints.empty());
+}
+
+TEST(CompareSmallVector, AllocationsAndThroughput)
+{
+    double small_time = 0, vector_time = 0, last_time = 0;
+    for(std::size_t size=1; size<=inline_size; ++size)
+    {
+        std::size_t small_allocs = 0, vector_allocs = 0;
+        CountingAllocator<int> small_alloc(&small_allocs), vector_alloc(&vector_allocs);
+        long small_sum = 0, vector_sum = 0;
+
+        last_time = get_time_sec();
+        for(std::size_t n=0; n<num_of_vectors; ++n)
+        {
+            counted_small_vector vec(small_alloc);
+            for(std::size_t i=0; i<size; ++i)
+            {
+                vec.push_back(static_cast<int>(i));
+            }
+            small_sum += vec.back();
+        }
+        get_new_time(small_time, last_time);
+
+        for(std::size_t n=0; n<num_of_vectors; ++n)
+        {
+            counted_vector vec(vector_alloc);
+            for(std::size_t i=0; i<size; ++i)
+            {
+                vec.push_back(static_cast<int>(i));
+            }
+            vector_sum += vec.back();
+        }
+        get_new_time(vector_time, last_time);
+
+        std::cout << "size " << size << ": allocations per vector small_vector "
+                  << static_cast<double>(small_allocs)/num_of_vectors << ", scl::vector "
+                  << static_cast<double>(vector_allocs)/num_of_vectors << "\n";
+        ASSERT_EQ(small_allocs, 0U);
+        ASSERT_GE(vector_allocs, num_of_vectors);
+        ASSERT_EQ(small_sum, vector_sum);
+    }
+    std::cout << "small_vector: " << small_time << " s, scl::vector: " << vector_time << " s\n";
+}
+
+}
+
+#endif //SMALL_VECTOR_TESTS_H
@@ -0,0 +1,837 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cassert>
+#include <new>
+#include <tuple>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include "vector.h"
+
+// Sequence containers library)
+namespace scl {
+
+namespace detail {
+/**
+ * @brief The compile time sequence of the column indexes, std::index_sequence is C++14
+ */
+template<std::size_t... Is>
+struct index_sequence
+{};
+
+template<std::size_t N, std::size_t... Is>
+struct make_index_sequence : make_index_sequence<N-1, N-1, Is...>
+{};
+
+template<std::size_t... Is>
+struct make_index_sequence<0, Is...>
+{
+    using type = index_sequence<Is...>;
+};
+
+template<bool... Bs>
+struct all_of : std::true_type
+{};
+
+template<bool B, bool... Bs>
+struct all_of<B, Bs...> : std::integral_constant<bool, B && all_of<Bs...>::value>
+{};
+
+template<std::size_t... Sizes>
+struct sum_of : std::integral_constant<std::size_t, 0>
+{};
+
+template<std::size_t S, std::size_t... Sizes>
+struct sum_of<S, Sizes...> : std::integral_constant<std::size_t, S + sum_of<Sizes...>::value>
+{};
+}
+
+/**
+ * @brief The contiguous view of one column, the data pointer and the size.
+ *        The view is invalidated by the growth of the container.
+ */
+template<class T>
+class column_span
+{
+private:
+    T* m_data;
+    std::size_t m_size;
+
+public:
+    using value_type = typename std::remove_cv<T>::type;
+    using iterator = T*;
+
+    column_span() noexcept:m_data(nullptr), m_size(0){}
+    column_span(T* data, std::size_t size) noexcept:m_data(data), m_size(size){}
+
+    inline T* data() const {return m_data;}
+    inline std::size_t size() const {return m_size;}
+    inline bool empty() const {return m_size == 0;}
+    inline iterator begin() const {return m_data;}
+    inline iterator end() const {return m_data + m_size;}
+    inline T& operator[](std::size_t index) const {return m_data[index];}
+};
+
+/**
+ * Structure of arrays
+ * @brief The rows of Ts... are stored column by column, every field in its own
+ *  contiguous array, so the scan of one field reads only the cache lines of this field.
+ *  All the columns share the size and the capacity, the capacity grows by GrowthPolicy
+ *  like in scl::vector, the elem_size of the policy is the size of the whole row.
+ *  The row is accessed by the proxy reference std::tuple<Ts&...>.
+ *  The columns are allocated by the Allocator rebound to the type of every column,
+ *  the value type of the Allocator itself doesn't matter.
+ *  The columns must be trivially relocatable or nothrow move constructible,
+ *  so the relocation of the columns never throws.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+class basic_soa_vector
+{
+    static_assert(sizeof...(Ts) > 0, "Soa vector error: no columns");
+    static_assert(detail::all_of<(is_trivially_relocatable<Ts>::value || std::is_nothrow_move_constructible<Ts>::value)...>::value,
+                  "Soa vector error: the columns must be nothrow move constructible");
+
+public:
+    template<std::size_t I>
+    using column_type = typename std::tuple_element<I, std::tuple<Ts...>>::type;
+
+    using value_type = std::tuple<Ts...>;
+    using allocator_type = Allocator;
+    using reference = std::tuple<Ts&...>;
+    using const_reference = std::tuple<const Ts&...>;
+
+    static constexpr std::size_t columns = sizeof...(Ts);
+
+private:
+    using indexes = typename detail::make_index_sequence<sizeof...(Ts)>::type;
+    template<std::size_t I>
+    using column_index = std::integral_constant<std::size_t, I>;
+    using columns_end = column_index<sizeof...(Ts)>;
+    template<class U>
+    using column_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+    template<class U>
+    using column_traits = std::allocator_traits<column_alloc<U>>;
+
+    Allocator m_alloc;
+    std::tuple<Ts*...> m_columns;
+    std::size_t m_size = 0;
+    std::size_t m_cap = 0;
+
+    template<class U>
+    U* allocate(std::size_t n);
+    template<class U>
+    void deallocate(U* ptr, std::size_t n);
+    template<class U>
+    void destroy(U* first, U* last);
+    template<class U>
+    void transfer(U* dest, U* from, std::size_t n);
+
+    template<std::size_t I>
+    void allocate_columns(std::tuple<Ts*...>& fresh, std::size_t n, column_index<I>);
+    void allocate_columns(std::tuple<Ts*...>&, std::size_t, columns_end){}
+    template<std::size_t I>
+    void release_columns(std::tuple<Ts*...>& cols, std::size_t size, std::size_t cap, column_index<I>);
+    void release_columns(std::tuple<Ts*...>&, std::size_t, std::size_t, columns_end){}
+    template<std::size_t I>
+    void relocate_columns(std::tuple<Ts*...>& fresh, column_index<I>);
+    void relocate_columns(std::tuple<Ts*...>&, columns_end){}
+    template<std::size_t I>
+    void destroy_rows(std::size_t first, std::size_t last, column_index<I>);
+    void destroy_rows(std::size_t, std::size_t, columns_end){}
+    template<std::size_t I, class Tuple>
+    void construct_row(std::size_t index, Tuple& args, column_index<I>);
+    template<class Tuple>
+    void construct_row(std::size_t, Tuple&, columns_end){}
+    template<std::size_t I>
+    void construct_default_row(std::size_t index, column_index<I>);
+    void construct_default_row(std::size_t, columns_end){}
+
+    template<std::size_t... Is>
+    reference row(std::size_t index, detail::index_sequence<Is...>);
+    template<std::size_t... Is>
+    const_reference row(std::size_t index, detail::index_sequence<Is...>) const;
+
+    void replace_storage(std::size_t new_cap);
+    template<class Tuple>
+    void append_row(Tuple&& args);
+
+public:
+
+    /**
+     * @brief The row iterator, dereferencing gives the proxy reference.
+     */
+    template<class Owner, class Ref>
+    class basic_iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::tuple<Ts...>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Ref;
+
+        basic_iterator() noexcept:m_owner(nullptr), m_index(0){}
+        basic_iterator(Owner* owner, std::size_t index) noexcept:m_owner(owner), m_index(index){}
+
+        inline reference operator*() const {return (*m_owner)[m_index];}
+        basic_iterator& operator++(){++m_index; return *this;}//++i
+        basic_iterator operator++(int){basic_iterator it = *this; ++m_index; return it;}//i++
+        inline std::size_t index() const {return m_index;}
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_index == rhs.m_index;}
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_index != rhs.m_index;}
+
+    private:
+        Owner* m_owner;
+        std::size_t m_index;
+    };
+
+    using iterator = basic_iterator<basic_soa_vector, reference>;
+    using const_iterator = basic_iterator<const basic_soa_vector, const_reference>;
+
+    basic_soa_vector() noexcept;
+    explicit basic_soa_vector(const Allocator& alloc) noexcept;
+    explicit basic_soa_vector(std::size_t size, const Allocator& alloc = Allocator());
+    basic_soa_vector(const basic_soa_vector& other);
+    basic_soa_vector(basic_soa_vector&& other) noexcept;
+    ~basic_soa_vector();
+    basic_soa_vector& operator=(const basic_soa_vector& other);
+    basic_soa_vector& operator=(basic_soa_vector&& other) noexcept;
+
+    Allocator get_allocator() const;
+
+    inline std::size_t size() const;
+    inline std::size_t capacity() const;
+    bool empty() const;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    template<std::size_t I>
+    column_type<I>* data();
+    template<std::size_t I>
+    const column_type<I>* data() const;
+    template<std::size_t I>
+    column_span<column_type<I>> column();
+    template<std::size_t I>
+    column_span<const column_type<I>> column() const;
+
+    reference operator[](std::size_t index);
+    const_reference operator[](std::size_t index) const;
+    reference front();
+    reference back();
+
+    void push_back(const Ts&... values);
+    template<class... Us>
+    void emplace_back(Us&&... values);
+    void pop_back();
+
+    void reserve(std::size_t cap);
+    void resize(std::size_t size);
+    void clear();
+    void shrink_to_fit();
+    void swap(basic_soa_vector& other) noexcept;
+};
+
+/**
+ * @brief soa_vector - the structure of arrays with the default allocator and growth of scl::vector
+ */
+template<class... Ts>
+using soa_vector = basic_soa_vector<std::allocator<char>, growth_factor_1_5, Ts...>;
+
+/**
+ * @brief aligned_soa_vector - every column is aligned by the cache line, e.g. for the SIMD kernels
+ */
+template<class... Ts>
+using aligned_soa_vector = basic_soa_vector<aligned_allocator<char, CACHE_LINE_SIZE>, growth_factor_1_5, Ts...>;
+
+template<class Allocator, class GrowthPolicy, class... Ts>
+constexpr std::size_t basic_soa_vector<Allocator, GrowthPolicy, Ts...>::columns;
+
+/**
+ * @brief Default ctor, no storage is allocated
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+basic_soa_vector<Allocator, GrowthPolicy, Ts...>::basic_soa_vector() noexcept
+    :m_columns()
+{}
+
+/**
+ * @brief Ctor with the allocator instance, no storage is allocated
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+basic_soa_vector<Allocator, GrowthPolicy, Ts...>::basic_soa_vector(const Allocator& alloc) noexcept
+    :m_alloc(alloc)
+    ,m_columns()
+{}
+
+/**
+ * @brief Ctor with size default constructed rows
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+basic_soa_vector<Allocator, GrowthPolicy, Ts...>::basic_soa_vector(std::size_t size, const Allocator& alloc)
+    :m_alloc(alloc)
+    ,m_columns()
+{
+    resize(size);
+}
+
+/**
+ * @brief Copy ctor, the storage is allocated once for the size of other
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+basic_soa_vector<Allocator, GrowthPolicy, Ts...>::basic_soa_vector(const basic_soa_vector& other)
+    :m_alloc(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.m_alloc))
+    ,m_columns()
+{
+    reserve(other.m_size);
+    try{
+        for(std::size_t i=0; i<other.m_size; ++i)
+        {
+            append_row(other[i]);
+        }
+    }
+    catch(...){
+        release_columns(m_columns, m_size, m_cap, column_index<0>());
+        throw;
+    }
+}
+
+/**
+ * @brief Move ctor, steals the columns and the allocator of other, which is left without storage
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+basic_soa_vector<Allocator, GrowthPolicy, Ts...>::basic_soa_vector(basic_soa_vector&& other) noexcept
+    :m_alloc(std::move(other.m_alloc))
+    ,m_columns(other.m_columns)
+    ,m_size(other.m_size)
+    ,m_cap(other.m_cap)
+{
+    other.m_columns = std::tuple<Ts*...>();
+    other.m_size = 0;
+    other.m_cap = 0;
+}
+
+/**
+ * @brief Dtor
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+basic_soa_vector<Allocator, GrowthPolicy, Ts...>::~basic_soa_vector()
+{
+    release_columns(m_columns, m_size, m_cap, column_index<0>());
+}
+
+/**
+ * @brief Copy assignment operator, copy and swap
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+basic_soa_vector<Allocator, GrowthPolicy, Ts...>& basic_soa_vector<Allocator, GrowthPolicy, Ts...>::operator=(const basic_soa_vector& other)
+{
+    if(this != &other){
+        basic_soa_vector tmp(other);
+        swap(tmp);
+    }
+    return *this;
+}
+
+/**
+ * @brief Move assignment operator
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+basic_soa_vector<Allocator, GrowthPolicy, Ts...>& basic_soa_vector<Allocator, GrowthPolicy, Ts...>::operator=(basic_soa_vector&& other) noexcept
+{
+    if(this != &other){
+        basic_soa_vector tmp(std::move(other));
+        swap(tmp);
+    }
+    return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the container.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+Allocator basic_soa_vector<Allocator, GrowthPolicy, Ts...>::get_allocator() const
+{
+    return m_alloc;
+}
+
+/**
+ * @brief The number of rows.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+std::size_t basic_soa_vector<Allocator, GrowthPolicy, Ts...>::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief The number of rows that fit into the columns.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+std::size_t basic_soa_vector<Allocator, GrowthPolicy, Ts...>::capacity() const
+{
+    return m_cap;
+}
+
+/**
+ * @brief Checks whether the container is empty.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+bool basic_soa_vector<Allocator, GrowthPolicy, Ts...>::empty() const
+{
+    return m_size == 0;
+}
+
+/**
+ * @brief Begin row iterator.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::iterator basic_soa_vector<Allocator, GrowthPolicy, Ts...>::begin()
+{
+    return iterator(this, 0);
+}
+
+/**
+ * @brief End row iterator.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::iterator basic_soa_vector<Allocator, GrowthPolicy, Ts...>::end()
+{
+    return iterator(this, m_size);
+}
+
+/**
+ * @brief Const begin row iterator.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::const_iterator basic_soa_vector<Allocator, GrowthPolicy, Ts...>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+/**
+ * @brief Const end row iterator.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::const_iterator basic_soa_vector<Allocator, GrowthPolicy, Ts...>::end() const
+{
+    return const_iterator(this, m_size);
+}
+
+/**
+ * @brief Const begin row iterator.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::const_iterator basic_soa_vector<Allocator, GrowthPolicy, Ts...>::cbegin() const
+{
+    return const_iterator(this, 0);
+}
+
+/**
+ * @brief Const end row iterator.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::const_iterator basic_soa_vector<Allocator, GrowthPolicy, Ts...>::cend() const
+{
+    return const_iterator(this, m_size);
+}
+
+/**
+ * @brief Pointer to the contiguous array of the column I.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t I>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::template column_type<I>* basic_soa_vector<Allocator, GrowthPolicy, Ts...>::data()
+{
+    return std::get<I>(m_columns);
+}
+
+/**
+ * @brief Const pointer to the contiguous array of the column I.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t I>
+const typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::template column_type<I>* basic_soa_vector<Allocator, GrowthPolicy, Ts...>::data() const
+{
+    return std::get<I>(m_columns);
+}
+
+/**
+ * @brief The span of the column I, e.g. for the SIMD kernels.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t I>
+column_span<typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::template column_type<I>> basic_soa_vector<Allocator, GrowthPolicy, Ts...>::column()
+{
+    return column_span<column_type<I>>(std::get<I>(m_columns), m_size);
+}
+
+/**
+ * @brief The const span of the column I.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t I>
+column_span<const typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::template column_type<I>> basic_soa_vector<Allocator, GrowthPolicy, Ts...>::column() const
+{
+    return column_span<const column_type<I>>(std::get<I>(m_columns), m_size);
+}
+
+/**
+ * @brief The row at index.
+ * @return The proxy reference, the tuple of the references to the fields.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::reference basic_soa_vector<Allocator, GrowthPolicy, Ts...>::operator[](std::size_t index)
+{
+    assert((index < m_size) && "Soa vector error: index out of range");
+    return row(index, indexes());
+}
+
+/**
+ * @brief The const row at index.
+ * @return The tuple of the const references to the fields.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::const_reference basic_soa_vector<Allocator, GrowthPolicy, Ts...>::operator[](std::size_t index) const
+{
+    assert((index < m_size) && "Soa vector error: index out of range");
+    return row(index, indexes());
+}
+
+/**
+ * @brief The first row.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::reference basic_soa_vector<Allocator, GrowthPolicy, Ts...>::front()
+{
+    return (*this)[0];
+}
+
+/**
+ * @brief The last row.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::reference basic_soa_vector<Allocator, GrowthPolicy, Ts...>::back()
+{
+    return (*this)[m_size-1];
+}
+
+/**
+ * @brief Appends the row, copies of the values are stored to the columns.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::push_back(const Ts&... values)
+{
+    append_row(std::forward_as_tuple(values...));
+}
+
+/**
+ * @brief Appends the row, every field is constructed from the matching argument.
+ *        The arguments may refer to the rows of the container.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<class... Us>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::emplace_back(Us&&... values)
+{
+    static_assert(sizeof...(Us) == sizeof...(Ts), "Soa vector error: one argument per column is expected");
+    append_row(std::forward_as_tuple(std::forward<Us>(values)...));
+}
+
+/**
+ * @brief Removes the last row.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::pop_back()
+{
+    assert((m_size > 0) && "Soa vector error: pop_back() on empty container");
+    destroy_rows(m_size-1, m_size, column_index<0>());
+    --m_size;
+}
+
+/**
+ * @brief Increases the capacity of all the columns to cap rows at least.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::reserve(std::size_t cap)
+{
+    if(cap > m_cap){
+        replace_storage(cap);
+    }
+}
+
+/**
+ * @brief Sets the number of rows, the new rows are default constructed.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::resize(std::size_t size)
+{
+    if(size < m_size){
+        destroy_rows(size, m_size, column_index<0>());
+        m_size = size;
+        return;
+    }
+    reserve(size);
+    for(; m_size<size; ++m_size)
+    {
+        construct_default_row(m_size, column_index<0>());
+    }
+}
+
+/**
+ * @brief Destroys all the rows, the capacity is kept.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::clear()
+{
+    destroy_rows(0, m_size, column_index<0>());
+    m_size = 0;
+}
+
+/**
+ * @brief Reduces the capacity to the size, the empty container releases the columns.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::shrink_to_fit()
+{
+    if(m_size == m_cap){
+        return;
+    }
+    if(m_size == 0){
+        release_columns(m_columns, 0, m_cap, column_index<0>());
+        m_columns = std::tuple<Ts*...>();
+        m_cap = 0;
+        return;
+    }
+    replace_storage(m_size);
+}
+
+/**
+ * @brief Exchanges the columns with other, the allocators go with the columns.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::swap(basic_soa_vector& other) noexcept
+{
+    std::swap(m_alloc, other.m_alloc);
+    std::swap(m_columns, other.m_columns);
+    std::swap(m_size, other.m_size);
+    std::swap(m_cap, other.m_cap);
+}
+
+/**
+ * @brief Allocates the uninitialized array of n elements of the column
+ *        by the allocator rebound to the column type.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<class U>
+U* basic_soa_vector<Allocator, GrowthPolicy, Ts...>::allocate(std::size_t n)
+{
+    column_alloc<U> alloc(m_alloc);
+    return n ? column_traits<U>::allocate(alloc, n) : nullptr;
+}
+
+/**
+ * @brief Returns the array of the column obtained from allocate().
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<class U>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::deallocate(U* ptr, std::size_t n)
+{
+    if(ptr != nullptr){
+        column_alloc<U> alloc(m_alloc);
+        column_traits<U>::deallocate(alloc, ptr, n);
+    }
+}
+
+/**
+ * @brief Calls the destructors for the range [first, last).
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<class U>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::destroy(U* first, U* last)
+{
+    column_alloc<U> alloc(m_alloc);
+    detail::destroy(alloc, first, last);
+}
+
+/**
+ * @brief Moves n elements of the column into the uninitialized dest, never throws,
+ *        see detail::relocate(). Trivially relocatable types are copied with memcpy
+ *        and not destroyed, others are move constructed and destroyed.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<class U>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::transfer(U* dest, U* from, std::size_t n)
+{
+    column_alloc<U> alloc(m_alloc);
+    detail::relocate(alloc, dest, from, n);
+}
+
+/**
+ * @brief Allocates the columns I... of fresh, on failure the allocated ones are released.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t I>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::allocate_columns(std::tuple<Ts*...>& fresh, std::size_t n, column_index<I>)
+{
+    std::get<I>(fresh) = allocate<column_type<I>>(n);
+    try{
+        allocate_columns(fresh, n, column_index<I+1>());
+    }
+    catch(...){
+        deallocate(std::get<I>(fresh), n);
+        throw;
+    }
+}
+
+/**
+ * @brief Destroys size elements of the columns I... and deallocates them.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t I>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::release_columns(std::tuple<Ts*...>& cols, std::size_t size, std::size_t cap, column_index<I>)
+{
+    destroy(std::get<I>(cols), std::get<I>(cols)+size);
+    deallocate(std::get<I>(cols), cap);
+    release_columns(cols, size, cap, column_index<I+1>());
+}
+
+/**
+ * @brief Moves the rows of the columns I... into fresh and deallocates the old ones.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t I>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::relocate_columns(std::tuple<Ts*...>& fresh, column_index<I>)
+{
+    transfer(std::get<I>(fresh), std::get<I>(m_columns), m_size);
+    deallocate(std::get<I>(m_columns), m_cap);
+    relocate_columns(fresh, column_index<I+1>());
+}
+
+/**
+ * @brief Destroys the rows [first, last) of the columns I...
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t I>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::destroy_rows(std::size_t first, std::size_t last, column_index<I>)
+{
+    destroy(std::get<I>(m_columns)+first, std::get<I>(m_columns)+last);
+    destroy_rows(first, last, column_index<I+1>());
+}
+
+/**
+ * @brief Constructs the fields I... of the row at index from args,
+ *        if a ctor throws, the already constructed fields are destroyed.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t I, class Tuple>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::construct_row(std::size_t index, Tuple& args, column_index<I>)
+{
+    using U = column_type<I>;
+    using Arg = typename std::tuple_element<I, Tuple>::type;
+    U* field = std::get<I>(m_columns)+index;
+    column_alloc<U> alloc(m_alloc);
+    column_traits<U>::construct(alloc, field, std::forward<Arg>(std::get<I>(args)));
+    try{
+        construct_row(index, args, column_index<I+1>());
+    }
+    catch(...){
+        column_traits<U>::destroy(alloc, field);
+        throw;
+    }
+}
+
+/**
+ * @brief Default constructs the fields I... of the row at index.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t I>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::construct_default_row(std::size_t index, column_index<I>)
+{
+    using U = column_type<I>;
+    U* field = std::get<I>(m_columns)+index;
+    column_alloc<U> alloc(m_alloc);
+    column_traits<U>::construct(alloc, field);
+    try{
+        construct_default_row(index, column_index<I+1>());
+    }
+    catch(...){
+        column_traits<U>::destroy(alloc, field);
+        throw;
+    }
+}
+
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t... Is>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::reference basic_soa_vector<Allocator, GrowthPolicy, Ts...>::row(std::size_t index, detail::index_sequence<Is...>)
+{
+    return reference(std::get<Is>(m_columns)[index]...);
+}
+
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<std::size_t... Is>
+typename basic_soa_vector<Allocator, GrowthPolicy, Ts...>::const_reference basic_soa_vector<Allocator, GrowthPolicy, Ts...>::row(std::size_t index, detail::index_sequence<Is...>) const
+{
+    return const_reference(std::get<Is>(m_columns)[index]...);
+}
+
+/**
+ * @brief Moves the rows into the new columns of new_cap rows.
+ *        Only the allocation can throw, it happens before any row is moved.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::replace_storage(std::size_t new_cap)
+{
+    std::tuple<Ts*...> fresh;
+    allocate_columns(fresh, new_cap, column_index<0>());
+    relocate_columns(fresh, column_index<0>());
+    m_columns = fresh;
+    m_cap = new_cap;
+}
+
+/**
+ * @brief Appends the row constructed from the tuple of the arguments.
+ *        If the columns are full, the new row is constructed in the new columns
+ *        before the old rows are moved, so the arguments may refer to the rows.
+ */
+template<class Allocator, class GrowthPolicy, class... Ts>
+template<class Tuple>
+void basic_soa_vector<Allocator, GrowthPolicy, Ts...>::append_row(Tuple&& args)
+{
+    if(m_size < m_cap){
+        construct_row(m_size, args, column_index<0>());
+        ++m_size;
+        return;
+    }
+    const std::size_t row_size = detail::sum_of<sizeof(Ts)...>::value;
+    const std::size_t new_cap = GrowthPolicy::next_capacity(m_cap, m_size+1, row_size);
+    std::tuple<Ts*...> fresh;
+    allocate_columns(fresh, new_cap, column_index<0>());
+    std::tuple<Ts*...> old = m_columns;
+    m_columns = fresh;
+    try{
+        construct_row(m_size, args, column_index<0>());
+    }
+    catch(...){
+        m_columns = old;
+        release_columns(fresh, 0, new_cap, column_index<0>());
+        throw;
+    }
+    m_columns = old;
+    relocate_columns(fresh, column_index<0>());
+    m_columns = fresh;
+    m_cap = new_cap;
+    ++m_size;
+}
+
+}
+
+#endif //SOA_VECTOR_H
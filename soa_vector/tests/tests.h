@@ -0,0 +1,287 @@
+#ifndef SOA_VECTOR_TESTS_H
+#define SOA_VECTOR_TESTS_H
+
+#include <iostream>
+#include <ctime>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <array>
+#include <string>
+#include <numeric>
+#include <stdexcept>
+#include "vector.h"
+#include "soa_vector.h"
+
+namespace soa_vector_testing {
+const std::size_t num_of_elements = 100000;
+const std::size_t bench_elements = 4000000;
+const std::size_t bench_passes = 20;
+const int module = 1000;
+
+/**
+ * @brief get_time_sec - get time in seconds
+ * @return the time in seconds
+ */
+inline double get_time_sec()
+{
+    return static_cast<double>(clock())/ CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief get_new_time calculating the total time and setting the current time in seconds
+ * @param sum_time - summary time
+ * @param last_time - last time value
+ */
+void get_new_time(double &sum_time, double &last_time)
+{
+    sum_time += get_time_sec() - last_time;
+    last_time = get_time_sec();
+}
+
+/**
+ * @brief The row of the array of structures, only m_price is scanned by the benchmark
+ */
+struct Record
+{
+    std::int64_t m_id;
+    double m_price;
+    double m_volume;
+    std::int32_t m_flags;
+    char m_name[36];
+};
+
+/**
+ * @brief The column which throws on the copy construction of the marked value
+ */
+struct Throwing
+{
+    int m_value = 0;
+    Throwing() = default;
+    explicit Throwing(int value):m_value(value){}
+    Throwing(const Throwing& other):m_value(other.m_value){if(m_value < 0) throw std::runtime_error("copy");}
+    Throwing(Throwing&&) noexcept = default;
+};
+
+/**
+ * @brief Allocator counting the allocated elements of the instance group, rebound per column
+ */
+template<typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    std::size_t *m_allocs;
+    std::size_t *m_live;
+
+    CountingAllocator(std::size_t *allocs, std::size_t *live) noexcept:m_allocs(allocs), m_live(live){}
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept:m_allocs(other.m_allocs), m_live(other.m_live){}
+
+    T* allocate(std::size_t n)
+    {
+        ++*m_allocs;
+        *m_live += n*sizeof(T);
+        return static_cast<T*>(::operator new(n*sizeof(T)));
+    }
+    void deallocate(T* ptr, std::size_t n)
+    {
+        *m_live -= n*sizeof(T);
+        ::operator delete(ptr);
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const CountingAllocator<T>& lhs, const CountingAllocator<U>& rhs){return lhs.m_allocs == rhs.m_allocs;}
+template<typename T, typename U>
+bool operator!=(const CountingAllocator<T>& lhs, const CountingAllocator<U>& rhs){return !(lhs == rhs);}
+
+TEST(CheckSoaVector, PushAndRows)
+{
+    //Arrange
+    scl::soa_vector<int, double, std::string> soa;
+    //Act
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        soa.push_back(static_cast<int>(i), i / 2.0, std::to_string(i));
+    }
+    std::get<0>(soa[7]) = -7;
+    std::get<2>(soa.back()) += "!";
+    //Assert
+    ASSERT_EQ(soa.size(), num_of_elements);
+    ASSERT_GE(soa.capacity(), num_of_elements);
+    ASSERT_EQ(std::get<0>(soa[7]), -7);
+    ASSERT_EQ(std::get<2>(soa.back()), std::to_string(num_of_elements-1) + "!");
+    for(std::size_t i=8; i<num_of_elements-1; ++i)
+    {
+        ASSERT_EQ(std::get<0>(soa[i]), static_cast<int>(i));
+        ASSERT_EQ(std::get<1>(soa[i]), i / 2.0);
+        ASSERT_EQ(std::get<2>(soa[i]), std::to_string(i));
+    }
+    std::size_t rows = 0;
+    for(auto row : soa)
+    {
+        std::get<1>(row) += 1.0;
+        ++rows;
+    }
+    ASSERT_EQ(rows, num_of_elements);
+    ASSERT_EQ(std::get<1>(soa.front()), 1.0);
+}
+
+TEST(CheckSoaVector, Columns)
+{
+    //Arrange
+    scl::soa_vector<std::int64_t, float> soa;
+    const scl::soa_vector<std::int64_t, float>& const_soa = soa;
+    std::int64_t expected = 0;
+    //Act
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        std::int64_t k = std::rand() % module;
+        expected += k;
+        soa.emplace_back(k, 0.5f);
+    }
+    scl::column_span<std::int64_t> keys = soa.column<0>();
+    scl::column_span<const float> weights = const_soa.column<1>();
+    //Assert
+    ASSERT_EQ(keys.size(), num_of_elements);
+    ASSERT_EQ(keys.data(), soa.data<0>());
+    ASSERT_EQ(weights.data(), const_soa.data<1>());
+    ASSERT_EQ(std::accumulate(keys.begin(), keys.end(), std::int64_t(0)), expected);
+    ASSERT_EQ(std::accumulate(weights.begin(), weights.end(), 0.0), num_of_elements * 0.5);
+    keys[0] = 42;
+    ASSERT_EQ(std::get<0>(const_soa[0]), 42);
+}
+
+TEST(CheckSoaVector, CopyMoveAndResize)
+{
+    //Arrange
+    scl::soa_vector<int, std::string> soa;
+    for(int i=0; i<100; ++i)
+    {
+        soa.push_back(i, std::string(40, 'a' + i % 26));
+    }
+    //Act
+    scl::soa_vector<int, std::string> copy(soa);
+    scl::soa_vector<int, std::string> moved(std::move(soa));
+    copy.resize(150);
+    copy.pop_back();
+    scl::soa_vector<int, std::string> assigned;
+    assigned = copy;
+    moved.emplace_back(std::get<0>(moved[0]), std::get<1>(moved[0]));
+    //Assert
+    ASSERT_TRUE(soa.empty());
+    ASSERT_EQ(soa.capacity(), 0U);
+    ASSERT_EQ(moved.size(), 101U);
+    ASSERT_EQ(std::get<1>(moved.back()), std::string(40, 'a'));
+    ASSERT_EQ(copy.size(), 149U);
+    ASSERT_EQ(std::get<0>(copy[120]), 0);
+    ASSERT_TRUE(std::get<1>(copy[120]).empty());
+    ASSERT_EQ(std::get<1>(assigned[99]), std::get<1>(moved[99]));
+    assigned.resize(10);
+    assigned.shrink_to_fit();
+    ASSERT_EQ(assigned.capacity(), 10U);
+    assigned.clear();
+    ASSERT_TRUE(assigned.empty());
+}
+
+TEST(CheckSoaVector, ExceptionSafety)
+{
+    //Arrange
+    scl::soa_vector<std::string, Throwing> soa;
+    for(int i=0; i<4; ++i)
+    {
+        soa.push_back(std::to_string(i), Throwing(i));
+    }
+    const std::size_t cap = soa.capacity();
+    while(soa.size() < cap)
+    {
+        soa.push_back("fill", Throwing(0));
+    }
+    //Act
+    //Assert
+    ASSERT_THROW(soa.push_back("bad", Throwing(-1)), std::runtime_error);
+    ASSERT_EQ(soa.size(), cap);
+    ASSERT_EQ(soa.capacity(), cap);
+    ASSERT_EQ(std::get<0>(soa[3]), "3");
+    soa.pop_back();
+    ASSERT_THROW(soa.push_back("bad", Throwing(-2)), std::runtime_error);
+    ASSERT_EQ(soa.size(), cap-1);
+}
+
+TEST(CheckSoaVector, Allocator)
+{
+    //Arrange
+    std::size_t allocs = 0, live = 0;
+    using counted_soa = scl::basic_soa_vector<CountingAllocator<char>, scl::growth_factor_2, int, double, std::string>;
+    const std::size_t row_size = sizeof(int) + sizeof(double) + sizeof(std::string);
+    scl::aligned_soa_vector<float, double, char> aligned;
+    //Act
+    {
+        counted_soa soa(CountingAllocator<char>(&allocs, &live));
+        soa.reserve(10);
+        const std::size_t reserved = allocs;
+        for(int i=0; i<20; ++i)
+        {
+            soa.emplace_back(i, i * 0.5, std::to_string(i));
+        }
+        counted_soa copy(soa);
+        //Assert
+        ASSERT_EQ(reserved, 3U);
+        ASSERT_EQ(allocs, 9U);
+        ASSERT_EQ(live, (soa.capacity() + copy.capacity()) * row_size);
+        ASSERT_TRUE(copy.get_allocator() == soa.get_allocator());
+        ASSERT_EQ(std::get<2>(copy[19]), "19");
+    }
+    ASSERT_EQ(live, 0U);
+    for(int i=0; i<100; ++i)
+    {
+        aligned.emplace_back(1.0f, 2.0, 'c');
+    }
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned.data<0>()) % CACHE_LINE_SIZE, 0U);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned.data<1>()) % CACHE_LINE_SIZE, 0U);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned.data<2>()) % CACHE_LINE_SIZE, 0U);
+}
+
+TEST(CompareSoaVector, ColumnScan)
+{
+    scl::vector<Record> aos;
+    scl::soa_vector<std::int64_t, double, double, std::int32_t, std::array<char, 36>> soa;
+    aos.reserve(bench_elements);
+    soa.reserve(bench_elements);
+    for(std::size_t i=0; i<bench_elements; ++i)
+    {
+        Record record = {};
+        record.m_id = static_cast<std::int64_t>(i);
+        record.m_price = std::rand() % module;
+        aos.push_back(record);
+        soa.push_back(record.m_id, record.m_price, record.m_volume, record.m_flags, std::array<char, 36>());
+    }
+    double aos_time = 0, soa_time = 0, last_time = get_time_sec();
+    double aos_sum = 0, soa_sum = 0;
+    for(std::size_t pass=0; pass<bench_passes; ++pass)
+    {
+        const Record* rows = aos.data();
+        for(std::size_t i=0; i<bench_elements; ++i)
+        {
+            aos_sum += rows[i].m_price;
+        }
+    }
+    get_new_time(aos_time, last_time);
+    for(std::size_t pass=0; pass<bench_passes; ++pass)
+    {
+        scl::column_span<const double> prices = static_cast<const decltype(soa)&>(soa).column<1>();
+        for(std::size_t i=0; i<prices.size(); ++i)
+        {
+            soa_sum += prices[i];
+        }
+    }
+    get_new_time(soa_time, last_time);
+    std::cout << "scan of one field, " << bench_elements << " rows of " << sizeof(Record) << " B, "
+              << bench_passes << " passes: AoS " << aos_time << " s, SoA " << soa_time << " s\n";
+    ASSERT_EQ(aos_sum, soa_sum);
+}
+
+}
+
+#endif //SOA_VECTOR_TESTS_H
@@ -0,0 +1,281 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include "aligned_allocator.h"
+
+/**
+ * @brief SPSC_RING_MIN_CAPACITY - the smallest capacity of the ring, the power of two
+ */
+constexpr std::size_t SPSC_RING_MIN_CAPACITY = 2U;
+static_assert((SPSC_RING_MIN_CAPACITY & (SPSC_RING_MIN_CAPACITY - 1)) == 0, "SPSC ring error: the minimal capacity must be the power of two");
+
+// Sequence containers library)
+namespace scl {
+
+/**
+ * Single producer single consumer ring
+ * @brief The bounded lock-free queue of one producer thread and one consumer thread.
+ *        The layout is the ring of scl::deque: the positions m_head and m_tail run freely,
+ *        the element of the position pos is at pos & m_mask of the array of the power of two size,
+ *        so the size is m_tail - m_head with no wrap-around checks.
+ *        The producer owns m_tail, the consumer owns m_head, each of them is on its own
+ *        cache line with the cached copy of the opposite position. The opposite position
+ *        is loaded with acquire only when the cached copy shows too few slots,
+ *        the own position is published with release after the elements are constructed
+ *        or destroyed, so no read-modify-write is ever done.
+ *        try_push_n/try_pop_n move the batch of the elements with one publication.
+ *        Only size(), empty() and capacity() may be called by both threads,
+ *        size() is the snapshot.
+ *        The object is over-aligned, it is not allocated by new before C++17.
+ */
+template<class T, class Allocator = std::allocator<T>>
+class spsc_ring
+{
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    alignas(CACHE_LINE_SIZE) Allocator m_alloc;
+    T* m_buffer;
+    std::size_t m_mask;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail;
+    std::size_t m_head_cache;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head;
+    std::size_t m_tail_cache;
+
+    static std::size_t s_ceil_pow2(std::size_t n);
+
+    T* element(std::size_t pos) const;
+    std::size_t free_slots(std::size_t tail, std::size_t wanted);
+    std::size_t ready_slots(std::size_t head, std::size_t wanted);
+
+public:
+    explicit spsc_ring(std::size_t capacity, const Allocator& alloc = Allocator());
+    ~spsc_ring();
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+
+    std::size_t capacity() const noexcept;
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    bool try_push(const T& val);
+    bool try_push(T&& val);
+    template<class... Args>
+    bool try_emplace(Args&&... args);
+    std::size_t try_push_n(const T* first, std::size_t n);
+
+    bool try_pop(T& val);
+    std::size_t try_pop_n(T* first, std::size_t n);
+};
+
+/**
+ * @brief The smallest power of two not less than n and SPSC_RING_MIN_CAPACITY.
+ */
+template<class T, class Allocator>
+std::size_t spsc_ring<T, Allocator>::s_ceil_pow2(std::size_t n)
+{
+    std::size_t power = SPSC_RING_MIN_CAPACITY;
+    while(power < n)
+    {
+        power *= 2;
+    }
+    return power;
+}
+
+/**
+ * @brief Constructor, the capacity is rounded up to the power of two.
+ */
+template<class T, class Allocator>
+spsc_ring<T, Allocator>::spsc_ring(std::size_t capacity, const Allocator& alloc)
+    :m_alloc(alloc)
+    ,m_buffer(nullptr)
+    ,m_mask(s_ceil_pow2(capacity) - 1)
+    ,m_tail(0)
+    ,m_head_cache(0)
+    ,m_head(0)
+    ,m_tail_cache(0)
+{
+    m_buffer = alloc_traits::allocate(m_alloc, m_mask + 1);
+}
+
+/**
+ * @brief Destructor, the elements left in the ring are destroyed. Neither thread may use the ring.
+ */
+template<class T, class Allocator>
+spsc_ring<T, Allocator>::~spsc_ring()
+{
+    const std::size_t tail = m_tail.load(std::memory_order_acquire);
+    for(std::size_t pos = m_head.load(std::memory_order_relaxed); pos != tail; ++pos)
+    {
+        alloc_traits::destroy(m_alloc, element(pos));
+    }
+    alloc_traits::deallocate(m_alloc, m_buffer, m_mask + 1);
+}
+
+template<class T, class Allocator>
+T* spsc_ring<T, Allocator>::element(std::size_t pos) const
+{
+    return m_buffer + (pos & m_mask);
+}
+
+/**
+ * @brief The producer side: the number of the free slots after tail,
+ *        the consumer position is loaded only when the cached one shows less than wanted.
+ */
+template<class T, class Allocator>
+std::size_t spsc_ring<T, Allocator>::free_slots(std::size_t tail, std::size_t wanted)
+{
+    std::size_t free = capacity() - (tail - m_head_cache);
+    if(free < wanted){
+        m_head_cache = m_head.load(std::memory_order_acquire);
+        free = capacity() - (tail - m_head_cache);
+    }
+    return free;
+}
+
+/**
+ * @brief The consumer side: the number of the elements from head,
+ *        the producer position is loaded only when the cached one shows less than wanted.
+ */
+template<class T, class Allocator>
+std::size_t spsc_ring<T, Allocator>::ready_slots(std::size_t head, std::size_t wanted)
+{
+    std::size_t ready = m_tail_cache - head;
+    if(ready < wanted){
+        m_tail_cache = m_tail.load(std::memory_order_acquire);
+        ready = m_tail_cache - head;
+    }
+    return ready;
+}
+
+template<class T, class Allocator>
+std::size_t spsc_ring<T, Allocator>::capacity() const noexcept
+{
+    return m_mask + 1;
+}
+
+template<class T, class Allocator>
+std::size_t spsc_ring<T, Allocator>::size() const noexcept
+{
+    const std::size_t head = m_head.load(std::memory_order_acquire);
+    return m_tail.load(std::memory_order_acquire) - head;
+}
+
+template<class T, class Allocator>
+bool spsc_ring<T, Allocator>::empty() const noexcept
+{
+    return size() == 0;
+}
+
+/**
+ * @brief The producer side: inserts the copy of val, false if the ring is full.
+ */
+template<class T, class Allocator>
+bool spsc_ring<T, Allocator>::try_push(const T& val)
+{
+    return try_emplace(val);
+}
+
+/**
+ * @brief The producer side: inserts val by move, false if the ring is full.
+ */
+template<class T, class Allocator>
+bool spsc_ring<T, Allocator>::try_push(T&& val)
+{
+    return try_emplace(std::move(val));
+}
+
+/**
+ * @brief The producer side: constructs the element in place from args, false if the ring is full.
+ */
+template<class T, class Allocator>
+template<class... Args>
+bool spsc_ring<T, Allocator>::try_emplace(Args&&... args)
+{
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if(free_slots(tail, 1) == 0){
+        return false;
+    }
+    alloc_traits::construct(m_alloc, element(tail), std::forward<Args>(args)...);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief The producer side: inserts the copies of up to n elements from first,
+ *        they are published at once. Returns the number of the inserted elements.
+ *        If the copy throws, the elements copied before are published.
+ */
+template<class T, class Allocator>
+std::size_t spsc_ring<T, Allocator>::try_push_n(const T* first, std::size_t n)
+{
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    const std::size_t count = std::min(n, free_slots(tail, n));
+    std::size_t pos = tail;
+    try{
+        for(; pos != tail + count; ++pos, ++first)
+        {
+            alloc_traits::construct(m_alloc, element(pos), *first);
+        }
+    }
+    catch(...){
+        m_tail.store(pos, std::memory_order_release);
+        throw;
+    }
+    m_tail.store(pos, std::memory_order_release);
+    return count;
+}
+
+/**
+ * @brief The consumer side: moves the first element to val and removes it, false if the ring is empty.
+ */
+template<class T, class Allocator>
+bool spsc_ring<T, Allocator>::try_pop(T& val)
+{
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if(ready_slots(head, 1) == 0){
+        return false;
+    }
+    T* item = element(head);
+    val = std::move(*item);
+    alloc_traits::destroy(m_alloc, item);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief The consumer side: moves up to n first elements to the array from first and removes them,
+ *        the slots are released at once. Returns the number of the removed elements.
+ */
+template<class T, class Allocator>
+std::size_t spsc_ring<T, Allocator>::try_pop_n(T* first, std::size_t n)
+{
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    const std::size_t count = std::min(n, ready_slots(head, n));
+    std::size_t pos = head;
+    try{
+        for(; pos != head + count; ++pos, ++first)
+        {
+            T* item = element(pos);
+            *first = std::move(*item);
+            alloc_traits::destroy(m_alloc, item);
+        }
+    }
+    catch(...){
+        m_head.store(pos, std::memory_order_release);
+        throw;
+    }
+    m_head.store(pos, std::memory_order_release);
+    return count;
+}
+
+}
+
+#endif //SPSC_RING_H
@@ -0,0 +1,232 @@
+#ifndef SPSC_RING_TESTS_H
+#define SPSC_RING_TESTS_H
+
+#include <iostream>
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include "spsc_ring.h"
+#include "test_utils.h"
+
+namespace spsc_ring_testing {
+const std::size_t num_of_elements = 100000;
+const std::size_t ring_capacity = 1024;
+const std::size_t transfer_elements = 10000000;
+const std::size_t transfer_batch = 64;
+const std::size_t ping_pong_rounds = 100000;
+
+using scl_testing::get_wall_time_sec;
+using scl_testing::locked_deque;
+
+/**
+ * @brief Moves count numbers from the producer thread to the consumer thread,
+ *        by one if batch is 1 or by try_push_n/try_pop_n of batch elements.
+ *        The thread yields when the queue is full or empty. Returns the sum of the received numbers.
+ */
+template<class Queue>
+std::uint64_t transfer(Queue& queue, std::size_t count, std::size_t batch, double& time)
+{
+    std::uint64_t sum = 0;
+    const double start = get_wall_time_sec();
+    std::thread producer([&queue, count, batch]
+    {
+        std::vector<std::uint64_t> items(batch);
+        for(std::size_t sent=0; sent<count;)
+        {
+            if(batch == 1){
+                if(queue.try_push(sent)){
+                    ++sent;
+                    continue;
+                }
+            }
+            else{
+                const std::size_t n = std::min(batch, count - sent);
+                for(std::size_t i=0; i<n; ++i)
+                {
+                    items[i] = sent + i;
+                }
+                std::size_t pushed = 0;
+                while(pushed != n)
+                {
+                    const std::size_t done = queue.try_push_n(items.data() + pushed, n - pushed);
+                    pushed += done;
+                    if(done == 0){
+                        std::this_thread::yield();
+                    }
+                }
+                sent += n;
+                continue;
+            }
+            std::this_thread::yield();
+        }
+    });
+    std::vector<std::uint64_t> items(batch);
+    for(std::size_t received=0; received<count;)
+    {
+        std::size_t done = 0;
+        if(batch == 1){
+            done = queue.try_pop(items[0]) ? 1 : 0;
+        }
+        else{
+            done = queue.try_pop_n(items.data(), batch);
+        }
+        for(std::size_t i=0; i<done; ++i)
+        {
+            sum += items[i];
+        }
+        received += done;
+        if(done == 0){
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    time = get_wall_time_sec() - start;
+    return sum;
+}
+
+/**
+ * @brief The mean round trip of one number sent through ping and echoed back through pong
+ *        by the other thread, in microseconds.
+ */
+template<class Queue>
+double round_trip_us(Queue& ping, Queue& pong, std::size_t rounds)
+{
+    std::thread echo([&ping, &pong, rounds]
+    {
+        std::uint64_t val = 0;
+        for(std::size_t i=0; i<rounds; ++i)
+        {
+            while(!ping.try_pop(val))
+            {
+                std::this_thread::yield();
+            }
+            pong.try_push(val);
+        }
+    });
+    const double start = get_wall_time_sec();
+    std::uint64_t val = 0;
+    for(std::size_t i=0; i<rounds; ++i)
+    {
+        ping.try_push(i);
+        while(!pong.try_pop(val))
+        {
+            std::this_thread::yield();
+        }
+    }
+    const double time = get_wall_time_sec() - start;
+    echo.join();
+    return time / rounds * 1e6;
+}
+
+TEST(CheckSpscRing, SingleThreadWrapAround)
+{
+    //Arrange
+    scl::spsc_ring<std::string> ring(100);
+    std::string val;
+    //Act
+    std::size_t pushed = 0;
+    while(ring.try_push(std::to_string(pushed)))
+    {
+        ++pushed;
+    }
+    //Assert
+    ASSERT_EQ(ring.capacity(), 128U);
+    ASSERT_EQ(pushed, 128U);
+    ASSERT_EQ(ring.size(), 128U);
+    ASSERT_FALSE(ring.try_emplace("full"));
+    std::size_t popped = 0;
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        ASSERT_TRUE(ring.try_pop(val));
+        ASSERT_EQ(val, std::to_string(popped++));
+        ASSERT_TRUE(ring.try_emplace(std::to_string(pushed++)));
+    }
+    const std::vector<std::string> batch(50, "batch");
+    std::vector<std::string> out(200);
+    ASSERT_EQ(ring.try_push_n(batch.data(), batch.size()), 0U);
+    ASSERT_EQ(ring.try_pop_n(out.data(), 30), 30U);
+    ASSERT_EQ(out[29], std::to_string(popped + 29));
+    ASSERT_EQ(ring.try_push_n(batch.data(), batch.size()), 30U);
+    ASSERT_EQ(ring.try_pop_n(out.data(), out.size()), 128U);
+    ASSERT_EQ(out[0], std::to_string(popped + 30));
+    ASSERT_EQ(out[127], "batch");
+    ASSERT_TRUE(ring.empty());
+    ASSERT_FALSE(ring.try_pop(val));
+    ring.try_push("left for the destructor");
+}
+
+TEST(CheckSpscRing, CrossThreadOrder)
+{
+    //Arrange
+    scl::spsc_ring<std::uint64_t> ring(ring_capacity);
+    std::vector<std::uint64_t> received;
+    //Act
+    std::thread producer([&ring]
+    {
+        std::uint64_t items[7];
+        for(std::uint64_t next=0; next<num_of_elements;)
+        {
+            if(next % 3 == 0){
+                const std::size_t n = std::min<std::size_t>(7, num_of_elements - next);
+                for(std::size_t i=0; i<n; ++i)
+                {
+                    items[i] = next + i;
+                }
+                next += ring.try_push_n(items, n);
+            }
+            else if(ring.try_push(next)){
+                ++next;
+            }
+            std::this_thread::yield();
+        }
+    });
+    std::uint64_t items[5];
+    while(received.size() < num_of_elements)
+    {
+        const std::size_t n = received.size() % 2 == 0 ? ring.try_pop_n(items, 5) : (ring.try_pop(items[0]) ? 1 : 0);
+        received.insert(received.end(), items, items + n);
+        if(n == 0){
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    //Assert
+    ASSERT_TRUE(ring.empty());
+    for(std::size_t i=0; i<received.size(); ++i)
+    {
+        ASSERT_EQ(received[i], i);
+    }
+}
+
+TEST(CompareSpscRing, ThroughputAndLatency)
+{
+    const std::uint64_t expected = static_cast<std::uint64_t>(transfer_elements) * (transfer_elements - 1) / 2;
+    double ring_single = 0, ring_batch = 0, locked_single = 0, locked_batch = 0;
+    {
+        scl::spsc_ring<std::uint64_t> ring(ring_capacity);
+        ASSERT_EQ(transfer(ring, transfer_elements, 1, ring_single), expected);
+        ASSERT_EQ(transfer(ring, transfer_elements, transfer_batch, ring_batch), expected);
+    }
+    {
+        locked_deque<std::uint64_t> locked;
+        ASSERT_EQ(transfer(locked, transfer_elements, 1, locked_single), expected);
+        ASSERT_EQ(transfer(locked, transfer_elements, transfer_batch, locked_batch), expected);
+    }
+    scl::spsc_ring<std::uint64_t> ping(ring_capacity), pong(ring_capacity);
+    const double ring_trip = round_trip_us(ping, pong, ping_pong_rounds);
+    locked_deque<std::uint64_t> locked_ping, locked_pong;
+    const double locked_trip = round_trip_us(locked_ping, locked_pong, ping_pong_rounds);
+    std::cout << transfer_elements << " elements between two threads, by one / by " << transfer_batch << ":\n"
+              << "spsc_ring " << ring_single << " / " << ring_batch << " s, mutex scl::deque "
+              << locked_single << " / " << locked_batch << " s\n"
+              << "round trip of " << ping_pong_rounds << ": spsc_ring " << ring_trip << " us, mutex scl::deque "
+              << locked_trip << " us, hardware threads " << std::thread::hardware_concurrency() << "\n";
+}
+
+}
+
+#endif //SPSC_RING_TESTS_H
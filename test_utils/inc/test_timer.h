@@ -0,0 +1,20 @@
+#ifndef TEST_TIMER_H
+#define TEST_TIMER_H
+#include <chrono>
+
+// The helpers shared by the tests of the containers
+namespace scl_testing {
+
+/**
+ * @brief get_wall_time_sec - get the wall clock time in seconds,
+ *        clock() sums the time of all the threads
+ * @return the time in seconds
+ */
+inline double get_wall_time_sec()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+#endif //TEST_TIMER_H
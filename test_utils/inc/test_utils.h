@@ -0,0 +1,88 @@
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include "deque.h"
+#include "test_timer.h"
+
+// The helpers of the queue benchmarks, the tests without the queues include test_timer.h only
+namespace scl_testing {
+
+/**
+ * @brief The unbounded queue of scl::deque under the mutex with the interface of the lock-free queues,
+ *        the baseline of the benchmarks. pop() waits on the condition variable while the queue is empty.
+ */
+template<class T>
+class locked_deque
+{
+public:
+    bool try_push(const T& val)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_deque.push_back(val);
+        }
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    std::size_t try_push_n(const T* first, std::size_t n)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for(std::size_t i=0; i<n; ++i)
+            {
+                m_deque.push_back(first[i]);
+            }
+        }
+        m_not_empty.notify_all();
+        return n;
+    }
+
+    void push(const T& val)
+    {
+        try_push(val);
+    }
+
+    bool try_pop(T& val)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_deque.empty()){
+            return false;
+        }
+        val = m_deque.front();
+        m_deque.pop_front();
+        return true;
+    }
+
+    std::size_t try_pop_n(T* first, std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::size_t count = std::min(n, m_deque.size());
+        for(std::size_t i=0; i<count; ++i)
+        {
+            first[i] = m_deque.front();
+            m_deque.pop_front();
+        }
+        return count;
+    }
+
+    void pop(T& val)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_empty.wait(lock, [this]{return !m_deque.empty();});
+        val = m_deque.front();
+        m_deque.pop_front();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    scl::deque<T> m_deque;
+};
+
+}
+
+#endif //TEST_UTILS_H
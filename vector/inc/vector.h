@@ -1,10 +1,26 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <new>
 #include <limits>
 #include <cassert>
+#include <utility>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+
+#include "aligned_allocator.h"
+#include "vector_storage.h"
+
+#ifdef SCL_INSTRUMENT
+#include "instrument.h"
+#else
+#define SCL_INSTRUMENT_EVENT(event) ((void)0)
+#endif
 
 /**
  * @brief MAX_VECTOR_SIZE - returns the largest finite value of the size_t type
@@ -16,153 +32,424 @@ constexpr std::size_t DEFAULT_CAPACITE_SIZE = 4U;
 // Sequence containers library)
 namespace scl {
 
+/**
+ * Growth policies of the vector
+ * @brief The policy computes the capacity of the new storage, when the storage is full.
+ *        next_capacity(cap, required, elem_size) returns the value not less than required,
+ *        cap is the current capacity, elem_size is the size of the element in bytes.
+ */
+struct growth_factor_1_5
+{
+    static std::size_t next_capacity(std::size_t cap, std::size_t required, std::size_t /*elem_size*/)
+    {
+        std::size_t next = cap+(cap/2)+1;
+        return next < required ? required : next;
+    }
+};
+
+struct growth_factor_2
+{
+    static std::size_t next_capacity(std::size_t cap, std::size_t required, std::size_t /*elem_size*/)
+    {
+        std::size_t next = cap ? cap*2 : 1;
+        return next < required ? required : next;
+    }
+};
+
+/**
+ * @brief The capacity from the Base policy is rounded up so the storage
+ *        fills the whole pages of PageSize bytes. Small storages are not rounded.
+ */
+template<std::size_t PageSize = 4096U, class Base = growth_factor_1_5>
+struct page_growth
+{
+    static std::size_t next_capacity(std::size_t cap, std::size_t required, std::size_t elem_size)
+    {
+        std::size_t next = Base::next_capacity(cap, required, elem_size);
+        if(next*elem_size < PageSize/2){
+            return next;
+        }
+        std::size_t bytes = (next*elem_size + PageSize-1) / PageSize * PageSize;
+        return bytes / elem_size;
+    }
+};
+
+using huge_page_growth = page_growth<2U*1024U*1024U>;
+
 /**
  * Very basic implementation std`s vector
  * @brief This implementation conditionally "useful" vector.
  *  It is controversially, maybe, the main useful methods - push_back, erase, operator[],
  *  besides the ctor, dtor.
  *  And anothers resize, clear, reserve etc.
+ *  The storage is allocated uninitialized, elements are constructed in place
+ *  and only the [0, size) range holds live objects.
+ *  The memory is obtained from the Allocator (std::allocator by default),
+ *  see https://en.cppreference.com/w/cpp/named_req/Allocator
+ *  The propagate_on_container_* traits of the allocator are respected.
+ *  The GrowthPolicy computes the new capacity when the storage is full.
  *
  */
-template<class T>
+template<class T, class Allocator = std::allocator<T>, class GrowthPolicy = growth_factor_1_5>
 class vector
 {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
 private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    Allocator m_alloc;
     T* m_arr = nullptr;
     std::size_t m_size = 0;
     std::size_t m_cap = DEFAULT_CAPACITE_SIZE;
-    
-    inline void move_storage(T* dest, T* from, std::size_t n);
-    inline void swap(vector<T>& other);
+#ifdef SCL_INSTRUMENT
+    instrument<vector<T, Allocator, GrowthPolicy>> m_stats;
+#endif
+
+    T* allocate(std::size_t n);
+    void deallocate(T* ptr, std::size_t n);
+    void replace_storage(T* new_arr, std::size_t new_cap);
+    void adopt_storage(T* new_arr, std::size_t new_cap);
+    void release();
+    template<class... Args>
+    void realloc_insert(std::size_t index, Args&&... args);
+    template<class ForwardIt>
+    void range_insert(std::size_t index, ForwardIt first, std::size_t n);
+    template<class InputIt>
+    void range_insert(std::size_t index, InputIt first, InputIt last, std::input_iterator_tag);
+    template<class ForwardIt>
+    void range_insert(std::size_t index, ForwardIt first, ForwardIt last, std::forward_iterator_tag);
+    inline void swap(vector<T, Allocator, GrowthPolicy>& other);
 
 public:
 
-    class iterator
+    /**
+     * @brief Contiguous random access iterator, U is T for the iterator
+     *        and const T for the const_iterator. Every operation is a plain
+     *        pointer operation, so the standard algorithms run at pointer speed.
+     */
+    template<class U>
+    class basic_iterator
     {
     public:
-        iterator() noexcept {}
-        explicit iterator(T* ptr):m_ptr(ptr){}
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename std::remove_cv<U>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = U*;
+        using reference = U&;
+
+        basic_iterator() noexcept:m_ptr(nullptr){}
+        explicit basic_iterator(U* ptr) noexcept:m_ptr(ptr){}
+        template<class V, class = typename std::enable_if<std::is_convertible<V*, U*>::value>::type>
+        basic_iterator(const basic_iterator<V>& other) noexcept:m_ptr(other.base()){}
+
+        inline U* base() const noexcept {return m_ptr;}
 
-        inline iterator& operator=(const iterator& other){m_ptr = other.m_ptr; return *this;}
+        inline reference operator*() const {return *m_ptr;}
+        inline pointer operator->() const {return m_ptr;}
+        inline reference operator[](difference_type n) const {return m_ptr[n];}
 
-        iterator& operator++(){++m_ptr; return *this;}//++i
-        iterator& operator--(){--m_ptr; return *this;}//--i
-        iterator operator++(int junk){iterator it = *this; ++m_ptr; return it;}//i++
-        iterator operator--(int junk){iterator it = *this; --m_ptr; return it;}//i--
-        inline T& operator*(){return *m_ptr;}
-        inline T* operator->(){return m_ptr;}
-        bool operator==(const iterator& other){return m_ptr == other.m_ptr;}
-        bool operator!=(const iterator& other){return m_ptr != other.m_ptr;}
-        friend vector<T>::iterator vector<T>::erase(iterator& pos);
+        basic_iterator& operator++(){++m_ptr; return *this;}//++i
+        basic_iterator& operator--(){--m_ptr; return *this;}//--i
+        basic_iterator operator++(int){basic_iterator it = *this; ++m_ptr; return it;}//i++
+        basic_iterator operator--(int){basic_iterator it = *this; --m_ptr; return it;}//i--
+        basic_iterator& operator+=(difference_type n){m_ptr += n; return *this;}
+        basic_iterator& operator-=(difference_type n){m_ptr -= n; return *this;}
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n){return it += n;}
+        friend basic_iterator operator+(difference_type n, basic_iterator it){return it += n;}
+        friend basic_iterator operator-(basic_iterator it, difference_type n){return it -= n;}
+        friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr - rhs.m_ptr;}
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr == rhs.m_ptr;}
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr != rhs.m_ptr;}
+        friend bool operator<(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr < rhs.m_ptr;}
+        friend bool operator>(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr > rhs.m_ptr;}
+        friend bool operator<=(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr <= rhs.m_ptr;}
+        friend bool operator>=(const basic_iterator& lhs, const basic_iterator& rhs){return lhs.m_ptr >= rhs.m_ptr;}
 
     private:
-        T* m_ptr;
+        U* m_ptr;
     };
 
+    using iterator = basic_iterator<T>;
+    using const_iterator = basic_iterator<const T>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
     vector() noexcept;
-    explicit vector(std::size_t in);
-    explicit vector(const vector<T> &other);
+    explicit vector(const Allocator& alloc);
+    explicit vector(std::size_t in, const Allocator& alloc = Allocator());
+    template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    vector(InputIt first, InputIt last, const Allocator& alloc = Allocator());
+    explicit vector(const vector<T, Allocator, GrowthPolicy> &other);
+    vector(vector<T, Allocator, GrowthPolicy>&& other) noexcept;
     ~vector();
-    vector<T>& operator=(const vector<T>& other);
+    vector<T, Allocator, GrowthPolicy>& operator=(const vector<T, Allocator, GrowthPolicy>& other);
+    vector<T, Allocator, GrowthPolicy>& operator=(vector<T, Allocator, GrowthPolicy>&& other)
+        noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value);
+
+    Allocator get_allocator() const;
 
     inline std::size_t capacity() const;
     inline std::size_t size() const;
     bool empty() const;
 
     iterator begin();
-    iterator cbegin() const;
+    const_iterator begin() const;
+    const_iterator cbegin() const;
     iterator end();
-    iterator cend() const;
+    const_iterator end() const;
+    const_iterator cend() const;
+    reverse_iterator rbegin();
+    const_reverse_iterator crbegin() const;
+    reverse_iterator rend();
+    const_reverse_iterator crend() const;
+    T* data();
+    const T* data() const;
+    T* aligned_data();
+    const T* aligned_data() const;
     T& front();
+    const T& front() const;
     T& back();
+    const T& back() const;
     void push_back(const T& data);
+    void push_back(T&& data);
+    template<class... Args>
+    T& emplace_back(Args&&... args);
+    template<class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+    iterator insert(const_iterator pos, std::size_t n, const T& value);
+    template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    void append(const T* data, std::size_t n);
     void pop_back();
 
     void reserve(std::size_t cap);
     void resize(std::size_t size);
+    void resize_uninitialized(std::size_t size);
 
-    iterator erase(iterator &pos);
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    iterator unordered_erase(const_iterator pos);
+    template<class Pred>
+    std::size_t erase_if(Pred pred);
     void clear();
+    void shrink_to_fit();
 
     T& operator[](std::size_t index);
     const T& operator[](std::size_t index) const;
+
+#ifdef SCL_INSTRUMENT
+    container_stats stats() const;
+    static container_stats total_stats();
+#endif
 };
 
+/**
+ * @brief aligned_vector - the storage is aligned by Alignment bytes after every reallocation
+ */
+template<class T, std::size_t Alignment = CACHE_LINE_SIZE, class GrowthPolicy = growth_factor_1_5>
+using aligned_vector = vector<T, aligned_allocator<T, Alignment>, GrowthPolicy>;
+
 /**
  * @brief Default ctor
  */
-template<class T>
-vector<T>::vector() noexcept
+template<class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector() noexcept
 {
-    m_arr = new T[m_cap];
+    m_arr = allocate(m_cap);
 }
 
 /**
- * @brief Ctor with set size parameters
+ * @brief Ctor with the allocator instance
  */
-template<class T>
-vector<T>::vector(std::size_t in)
+template<class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(const Allocator& alloc)
+    :m_alloc(alloc)
 {
-    m_size = in;
-    m_cap = in+in/2+1;
-    m_arr = new (std::nothrow) T[m_cap];
-    assert((m_arr == NULL) && "Vector error: unable to allocate memory in default constructor" );
+    m_arr = allocate(m_cap);
 }
 
 /**
- * @brief Copy ctor
+ * @brief Ctor with set size parameters, the storage holds exactly in elements,
+ *        the GrowthPolicy takes over from the first push_back.
+ *        If a ctor throws, the built elements and the storage are released.
  */
-template<class T>
-vector<T>::vector(const vector<T>& other)
-    :m_size(other.m_size)
-    ,m_cap(other.m_cap)
+template<class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(std::size_t in, const Allocator& alloc)
+    :m_alloc(alloc)
+    ,m_cap(in)
 {
-    m_arr = new (std::nothrow) T[m_cap];
-    if(m_arr != NULL){
-        for(std::size_t i=0; i<m_size; ++i)
+    m_arr = allocate(m_cap);
+    try{
+        for(; m_size<in; ++m_size)
         {
-            m_arr[i] = other.m_arr[i];
+            alloc_traits::construct(m_alloc, m_arr+m_size);
         }
     }
-    else
-    {
-        assert(m_arr && "Vector error: unable to allocate memory in default constructor");
+    catch(...){
+        release();
+        throw;
+    }
+}
+
+/**
+ * @brief Ctor from the range [first, last).
+ *        The storage is allocated once if the distance of the range is known.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+template<class InputIt, class>
+vector<T, Allocator, GrowthPolicy>::vector(InputIt first, InputIt last, const Allocator& alloc)
+    :m_alloc(alloc)
+    ,m_cap(0)
+{
+    try{
+        range_insert(0, first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    }
+    catch(...){
+        release();
+        throw;
+    }
+}
+
+/**
+ * @brief Copy ctor
+ *        If a copy throws, the copied elements are destroyed and the storage is released.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(const vector<T, Allocator, GrowthPolicy>& other)
+    :m_alloc(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    ,m_cap(other.m_cap)
+{
+    m_arr = allocate(m_cap);
+    try{
+        SCL_INSTRUMENT_EVENT(on_copy(other.m_size*sizeof(T)));
+        detail::copy_construct_n(m_alloc, m_arr, static_cast<const T*>(other.m_arr), other.m_size);
+    }
+    catch(...){
+        deallocate(m_arr, m_cap);
+        throw;
     }
+    m_size = other.m_size;
+}
+
+/**
+ * @brief Move ctor, steals the storage of other, which is left empty without storage.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(vector<T, Allocator, GrowthPolicy>&& other) noexcept
+    :m_alloc(std::move(other.m_alloc))
+    ,m_arr(other.m_arr)
+    ,m_size(other.m_size)
+    ,m_cap(other.m_cap)
+{
+    other.m_arr = nullptr;
+    other.m_size = 0;
+    other.m_cap = 0;
 }
 
 /**
  * @brief Dtor
  */
-template<class T>
-vector<T>::~vector()
+template<class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::~vector()
 {
-    delete[] m_arr;
+    if(m_arr != nullptr) SCL_INSTRUMENT_EVENT(on_release((m_cap-m_size)*sizeof(T)));
+    detail::destroy(m_alloc, m_arr, m_arr+m_size);
+    deallocate(m_arr, m_cap);
 }
 
 /**
  * @brief Assignment operator CASI
+ *        The allocator is replaced if propagate_on_container_copy_assignment is set.
  */
-template<class T>
-vector<T>& vector<T>::operator=(const vector<T>& other)
+template<class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>& vector<T, Allocator, GrowthPolicy>::operator=(const vector<T, Allocator, GrowthPolicy>& other)
 {
     if(this == &other){
         return *this;
     }
-    if(other.m_arr){
-        swap(vector<T>(other));
+    if(alloc_traits::propagate_on_container_copy_assignment::value && m_alloc != other.m_alloc)
+    {
+        // Storage must be released by the allocator that obtained it
+        release();
+    }
+    if(alloc_traits::propagate_on_container_copy_assignment::value)
+    {
+        m_alloc = other.m_alloc;
+    }
+    detail::destroy(m_alloc, m_arr, m_arr+m_size);
+    m_size = 0;
+    reserve(other.m_size);
+    SCL_INSTRUMENT_EVENT(on_copy(other.m_size*sizeof(T)));
+    if(std::is_trivially_copyable<T>::value){
+        if(other.m_size) std::memcpy(static_cast<void*>(m_arr), other.m_arr, other.m_size*sizeof(T));
+        m_size = other.m_size;
     }
     else{
-        m_arr = nullptr;
+        for(; m_size<other.m_size; ++m_size)
+        {
+            alloc_traits::construct(m_alloc, m_arr+m_size, other.m_arr[m_size]);
+        }
+    }
+    return *this;
+}
+
+/**
+ * @brief Move assignment operator
+ *        The storage is stolen if the allocator propagates on move assignment or
+ *        both allocators are equal, otherwise the elements are moved one by one.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>& vector<T, Allocator, GrowthPolicy>::operator=(vector<T, Allocator, GrowthPolicy>&& other)
+    noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value)
+{
+    if(this == &other){
+        return *this;
+    }
+    if(alloc_traits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc)
+    {
+        release();
+        if(alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            m_alloc = std::move(other.m_alloc);
+        }
+        m_arr = other.m_arr;
+        m_size = other.m_size;
+        m_cap = other.m_cap;
+        other.m_arr = nullptr;
+        other.m_size = 0;
+        other.m_cap = 0;
+        return *this;
+    }
+    detail::destroy(m_alloc, m_arr, m_arr+m_size);
+    m_size = 0;
+    reserve(other.m_size);
+    for(; m_size<other.m_size; ++m_size)
+    {
+        alloc_traits::construct(m_alloc, m_arr+m_size, std::move(other.m_arr[m_size]));
     }
     return *this;
 }
 
+/**
+ * @brief Returns the allocator associated with the container.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+Allocator vector<T, Allocator, GrowthPolicy>::get_allocator() const
+{
+    return m_alloc;
+}
+
 /**
  * @brief The number of elements that the container has currently allocated space for.
  * @return The number of elements that can be held in currently allocated storage.
  */
-template<class T>
-std::size_t vector<T>::capacity() const
+template<class T, class Allocator, class GrowthPolicy>
+std::size_t vector<T, Allocator, GrowthPolicy>::capacity() const
 {
     return m_cap;
 }
@@ -171,8 +458,8 @@ std::size_t vector<T>::capacity() const
  * @brief The number of elements.
  * @return The number of elements in the container.
  */
-template<class T>
-std::size_t vector<T>::size() const
+template<class T, class Allocator, class GrowthPolicy>
+std::size_t vector<T, Allocator, GrowthPolicy>::size() const
 {
     return m_size;
 }
@@ -181,8 +468,8 @@ std::size_t vector<T>::size() const
  * @brief Checks whether the container is empty.
  * @return True if is empty, false otherwise.
  */
-template<class T>
-bool vector<T>::empty() const
+template<class T, class Allocator, class GrowthPolicy>
+bool vector<T, Allocator, GrowthPolicy>::empty() const
 {
     return m_size == 0;
 }
@@ -191,8 +478,8 @@ bool vector<T>::empty() const
 * @brief Begin iterator.
 * @return An iterator to the first element.
 */
-template<class T>
-typename vector<T>::iterator vector<T>::begin()
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::begin()
 {
     return iterator(m_arr);
 }
@@ -201,18 +488,29 @@ typename vector<T>::iterator vector<T>::begin()
  * @brief Const begin iterator.
  * @return An const iterator to the first element.
  */
-template<class T>
-typename vector<T>::iterator vector<T>::cbegin() const
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_iterator vector<T, Allocator, GrowthPolicy>::begin() const
 {
-    return iterator(m_arr);
+    return const_iterator(m_arr);
+}
+
+/**
+ * @brief Const begin iterator.
+ * @return An const iterator to the first element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_iterator vector<T, Allocator, GrowthPolicy>::cbegin() const
+{
+    return const_iterator(m_arr);
 }
 
+
 /**
  * @brief End iterator.
  * @return An iterator to one past the last element.
  */
-template<class T>
-typename vector<T>::iterator vector<T>::end()
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::end()
 {
     return iterator(m_arr+m_size);
 }
@@ -221,166 +519,460 @@ typename vector<T>::iterator vector<T>::end()
  * @brief Const end iterator.
  * @return An const iterator to one past the last element.
  */
-template<class T>
-typename vector<T>::iterator vector<T>::cend() const
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_iterator vector<T, Allocator, GrowthPolicy>::end() const
 {
-    return iterator(m_arr+m_size);
+    return const_iterator(m_arr+m_size);
+}
+
+/**
+ * @brief Const end iterator.
+ * @return An const iterator to one past the last element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_iterator vector<T, Allocator, GrowthPolicy>::cend() const
+{
+    return const_iterator(m_arr+m_size);
+}
+
+/**
+ * @brief Reverse begin iterator.
+ * @return A reverse iterator to the last element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::reverse_iterator vector<T, Allocator, GrowthPolicy>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+/**
+ * @brief Const reverse begin iterator.
+ * @return A const reverse iterator to the last element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_reverse_iterator vector<T, Allocator, GrowthPolicy>::crbegin() const
+{
+    return const_reverse_iterator(cend());
+}
+
+/**
+ * @brief Reverse end iterator.
+ * @return A reverse iterator to one before the first element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::reverse_iterator vector<T, Allocator, GrowthPolicy>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+/**
+ * @brief Const reverse end iterator.
+ * @return A const reverse iterator to one before the first element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_reverse_iterator vector<T, Allocator, GrowthPolicy>::crend() const
+{
+    return const_reverse_iterator(cbegin());
+}
+
+/**
+ * @brief Direct access to the underlying contiguous storage.
+ * @return Pointer to the first element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+T* vector<T, Allocator, GrowthPolicy>::data()
+{
+    return m_arr;
+}
+
+/**
+ * @brief Direct access to the underlying contiguous storage.
+ * @return Const pointer to the first element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+const T* vector<T, Allocator, GrowthPolicy>::data() const
+{
+    return m_arr;
+}
+
+/**
+ * @brief The storage pointer annotated with the alignment of the Allocator,
+ *        e.g. aligned_vector gives the aligned loads in the loops over it.
+ * @return Pointer to the first element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+T* vector<T, Allocator, GrowthPolicy>::aligned_data()
+{
+    return assume_aligned<allocator_alignment<Allocator>::value>(m_arr);
+}
+
+/**
+ * @brief The const storage pointer annotated with the alignment of the Allocator.
+ * @return Const pointer to the first element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+const T* vector<T, Allocator, GrowthPolicy>::aligned_data() const
+{
+    return assume_aligned<allocator_alignment<Allocator>::value>(m_arr);
 }
 
+
 /**
  * @brief Get a first element from the array.
  * @return The first element from the array
  */
-template<class T>
-T& vector<T>::front()
+template<class T, class Allocator, class GrowthPolicy>
+T& vector<T, Allocator, GrowthPolicy>::front()
 {
     return m_arr[0];
 };
 
+/**
+ * @brief Get a first element from the const array.
+ * @return The const first element from the array
+ */
+template<class T, class Allocator, class GrowthPolicy>
+const T& vector<T, Allocator, GrowthPolicy>::front() const
+{
+    return m_arr[0];
+}
+
 /**
  * @brief Get a back element from the array.
  * @return The back element from the array
  */
-template<class T>
-T& vector<T>::back()
+template<class T, class Allocator, class GrowthPolicy>
+T& vector<T, Allocator, GrowthPolicy>::back()
+{
+    return m_arr[m_size-1];
+}
+
+/**
+ * @brief Get a back element from the const array.
+ * @return The const back element from the array
+ */
+template<class T, class Allocator, class GrowthPolicy>
+const T& vector<T, Allocator, GrowthPolicy>::back() const
 {
     return m_arr[m_size-1];
 }
 
 /**
  * @brief Adds an element to the end.
- *        If no space to add an element, then the capacity of the vector is increased.
+ *        If no space to add an element, then the capacity of the vector is increased
+ *        by the GrowthPolicy.
  * @param The const reference to the element for add.
  */
-template<class T>
-void vector<T>::push_back(const T& data)
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::push_back(const T& data)
+{
+    emplace_back(data);
+}
+
+/**
+ * @brief Adds an element to the end, the element is moved into the container.
+ * @param The rvalue reference to the element for add.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::push_back(T&& data)
+{
+    emplace_back(std::move(data));
+}
+
+/**
+ * @brief Constructs an element in place at the end.
+ *        If no space to add an element, then the capacity of the vector is increased.
+ * @param args Arguments forwarded to the constructor of the element.
+ * @return Reference to the inserted element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+template<class... Args>
+T& vector<T, Allocator, GrowthPolicy>::emplace_back(Args&&... args)
+{
+    if(m_size >= m_cap)
+    {
+        realloc_insert(m_size, std::forward<Args>(args)...);
+    }
+    else
+    {
+        alloc_traits::construct(m_alloc, m_arr+m_size, std::forward<Args>(args)...);
+        ++m_size;
+    }
+    return m_arr[m_size-1];
+}
+
+/**
+ * @brief Constructs an element in place before pos.
+ *        The elements after pos are shifted one position to the end.
+ * @param pos Iterator before which the element will be constructed.
+ * @param args Arguments forwarded to the constructor of the element.
+ * @return Iterator pointing to the emplaced element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+template<class... Args>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::emplace(const_iterator pos, Args&&... args)
 {
+    std::size_t index = static_cast<std::size_t>(pos.base() - m_arr);
+    assert((index <= m_size) && "Vector error: emplace position out of range");
     if(m_size >= m_cap)
     {
-        reserve(m_cap+(m_cap/2)+1);
+        realloc_insert(index, std::forward<Args>(args)...);
+    }
+    else if(index == m_size)
+    {
+        alloc_traits::construct(m_alloc, m_arr+m_size, std::forward<Args>(args)...);
+        ++m_size;
+    }
+    else
+    {
+        // args may refer to the elements which will be shifted
+        T tmp(std::forward<Args>(args)...);
+        alloc_traits::construct(m_alloc, m_arr+m_size, std::move(m_arr[m_size-1]));
+        SCL_INSTRUMENT_EVENT(on_move((m_size-index-1)*sizeof(T)));
+        detail::move_storage(m_arr+index+1, m_arr+index, m_size-index-1);
+        m_arr[index] = std::move(tmp);
+        ++m_size;
     }
-    m_arr[m_size++] = data;
+    return iterator(m_arr+index);
+}
+
+/**
+ * @brief Inserts n copies of value before pos.
+ *        The storage grows at most once.
+ * @param pos Iterator before which the elements will be inserted.
+ * @param n The number of the copies.
+ * @param value The value to copy, may refer to the element of the vector.
+ * @return Iterator pointing to the first inserted element, or pos if n == 0.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::insert(const_iterator pos, std::size_t n, const T& value)
+{
+    std::size_t index = static_cast<std::size_t>(pos.base() - m_arr);
+    assert((index <= m_size) && "Vector error: insert position out of range");
+    if(n == 0){
+        return iterator(m_arr+index);
+    }
+    T tmp(value);
+    detail::fill_iterator<T> fill{&tmp};
+    range_insert(index, fill, n);
+    return iterator(m_arr+index);
+}
+
+/**
+ * @brief Inserts the elements from the range [first, last) before pos.
+ *        The storage grows at most once for the forward iterators.
+ *        The range must not refer to the elements of the vector.
+ * @param pos Iterator before which the elements will be inserted.
+ * @return Iterator pointing to the first inserted element, or pos if first == last.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+template<class InputIt, class>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::insert(const_iterator pos, InputIt first, InputIt last)
+{
+    std::size_t index = static_cast<std::size_t>(pos.base() - m_arr);
+    assert((index <= m_size) && "Vector error: insert position out of range");
+    range_insert(index, first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    return iterator(m_arr+index);
+}
+
+/**
+ * @brief Appends n elements from the array data to the end.
+ *        The storage grows at most once, trivially copyable types are copied by memcpy.
+ *        The array must not refer to the elements of the vector.
+ * @param data Pointer to the first element to append.
+ * @param n The number of elements.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::append(const T* data, std::size_t n)
+{
+    range_insert(m_size, data, n);
 }
 
 /**
  * @brief Removes the last element of the container.
  */
-template<class T>
-void vector<T>::pop_back()
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::pop_back()
 {
     --m_size;
-    m_arr[m_size].~T();
+    alloc_traits::destroy(m_alloc, m_arr+m_size);
 }
 
 /**
  * @brief Increases the capacity of the container to a value greater or equal to new_cap.
  *        If new_cap is greater than the current capacity(), new storage is allocated,
  *        otherwise the method does nothing.
+ *        The elements are relocated into the uninitialized storage, see detail::relocate().
  *        see https://stackoverflow.com/questions/43728706
  * @param cap new capacity of the container.
  */
-template<class T>
-void vector<T>::reserve(std::size_t cap)
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::reserve(std::size_t cap)
 {
     if(m_arr == nullptr){
         m_size = 0;
         m_cap = 0;
     }
-    T* new_arr = new (std::nothrow) T[cap];
-    assert(new_arr && "cannot allocate memory - new_arr");
-    std::size_t l_size = cap < m_size ? cap : m_size;
-
-    for(std::size_t indx=0; indx<l_size; ++indx)
-    {
-        new_arr[indx] = m_arr[indx];
+    if(cap <= m_cap && m_arr != nullptr){
+        return;
     }
-    m_cap = cap;
-    delete[] m_arr;
-    m_arr = new_arr;
+    replace_storage(allocate(cap), cap);
 }
 
 /**
  * @brief Resize policy. Sets the size of the container to the specified value.
  * @param size new container size.
  */
-template<class T>
-void vector<T>::resize(std::size_t size)
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::resize(std::size_t size)
 {
+    if(size < m_size){
+        detail::destroy(m_alloc, m_arr+size, m_arr+m_size);
+        m_size = size;
+        return;
+    }
     reserve(size);
+    for(; m_size<size; ++m_size)
+    {
+        alloc_traits::construct(m_alloc, m_arr+m_size);
+    }
+}
+
+/**
+ * @brief Sets the size without the initialization of the new elements,
+ *        e.g. for the buffer about to be filled by read(). The new elements
+ *        hold the indeterminate values until they are written.
+ *        The storage grows by the GrowthPolicy like push_back(), so the repeated
+ *        growth by small steps is amortized O(1), call reserve() before for the exact size.
+ *        Only for the trivially copyable types, whose objects need no construction.
+ * @param size new container size.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::resize_uninitialized(std::size_t size)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Vector error: resize_uninitialized() needs a trivially copyable type");
+    if(size > m_cap || (m_arr == nullptr && size > 0)){
+        reserve(GrowthPolicy::next_capacity(m_arr != nullptr ? m_cap : 0, size, sizeof(T)));
+    }
     m_size = size;
 }
 
 /**
 * @brief Erases an element at pos.
+*        The position is computed from the iterator pointer, only the tail is shifted.
 *        see https://codereview.stackexchange.com/questions/154008
 * @param pos Iterator to the element to remove.
 * @return Iterator following the last removed element.
 *         If the iterator pos refers to the last element, the end() iterator is returned.
 */
-template<class T>
-typename vector<T>::iterator vector<T>::erase(iterator& pos)
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::erase(const_iterator pos)
 {
-    std::size_t i=0;
-    auto it = (*this).begin();
+    std::size_t i = static_cast<std::size_t>(pos.base() - m_arr);
+    assert((i < m_size) && "Vector error: erase position out of range");
 
-    for(it; it != pos; it++, i++);
+    SCL_INSTRUMENT_EVENT(on_move((m_size-i-1)*sizeof(T)));
+    detail::move_storage(m_arr+i, m_arr+i+1, m_size-i-1);
+    m_size--;
+    alloc_traits::destroy(m_alloc, m_arr+m_size);
+    return iterator(m_arr+i);
+}
 
-    for(auto it = pos++; it != (*this).end(); it++, i++){
-        m_arr[i] = m_arr[i+1];
+/**
+* @brief Erases the elements in the range [first, last).
+*        The tail is shifted once, trivially copyable types use memmove.
+* @param first Iterator to the first element to remove.
+* @param last Iterator following the last element to remove.
+* @return Iterator following the last removed element.
+*/
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::erase(const_iterator first, const_iterator last)
+{
+    std::size_t i = static_cast<std::size_t>(first.base() - m_arr);
+    std::size_t j = static_cast<std::size_t>(last.base() - m_arr);
+    assert((i <= j && j <= m_size) && "Vector error: erase range out of range");
+    if(i == j){
+        return iterator(m_arr+i);
     }
 
-    m_size--;
-    return pos;
-
-    //TODO
-    //https://codereview.stackexchange.com/questions/231112
-    /*
-     * std::move(position + 1, end(), position);
-     * --end_position;
-     * std::allocator_traits<Alloc>::destroy(allocator, end_position);
-     * return position;
-     */
+    SCL_INSTRUMENT_EVENT(on_move((m_size-j)*sizeof(T)));
+    detail::move_storage(m_arr+i, m_arr+j, m_size-j);
+    detail::destroy(m_alloc, m_arr+m_size-(j-i), m_arr+m_size);
+    m_size -= j-i;
+    return iterator(m_arr+i);
+}
 
-    /* http://www.cplusplus.com/forum/beginner/70325/
-     * template<class T>
-     * void Vec<T>::erase( iterator i )// iterator is of type T*
-     * {
-     *  // avail : points to one past the end of the last intialized object in the memory block created by allocator:allocate
-     *  // data : points to the first storage in the memory block created by allocator::allocate
-     *  	if(i < avail && i >= data){
-     *      for(iterator it = i; it != avail -1; ++it)
-     *  		{
-     *  			iterator after = it +1;
-                    *it = *after;
-                }
-            alloc.destroy(avail-1);
-            --avail;
-            }
-       }
-     */
+/**
+* @brief Erases an element at pos in O(1), the order of the elements is not preserved.
+*        The back element is moved into pos.
+* @param pos Iterator to the element to remove.
+* @return Iterator to the element moved into pos, or end() if pos was the back element.
+*/
+template<class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::unordered_erase(const_iterator pos)
+{
+    std::size_t i = static_cast<std::size_t>(pos.base() - m_arr);
+    assert((i < m_size) && "Vector error: erase position out of range");
+    if(i != m_size-1){
+        m_arr[i] = std::move(m_arr[m_size-1]);
+    }
+    pop_back();
+    return iterator(m_arr+i);
+}
+
+/**
+* @brief Erases all elements satisfying the predicate in a single pass.
+*        The order of the remaining elements is preserved, each survivor is moved once.
+* @param pred Unary predicate returning true for the elements to remove.
+* @return The number of removed elements.
+*/
+template<class T, class Allocator, class GrowthPolicy>
+template<class Pred>
+std::size_t vector<T, Allocator, GrowthPolicy>::erase_if(Pred pred)
+{
+    std::size_t keep = detail::remove_if(m_alloc, m_arr, m_size, pred);
+    std::size_t removed = m_size-keep;
+    m_size = keep;
+    return removed;
 }
 
 /**
  * @brief Remove elements from the container
- *        The capacity and size of the vector resets.
+ *        The size of the vector resets, the capacity is kept,
+ *        use shrink_to_fit() to release the storage.
  */
-template<class T>
-void vector<T>::clear()
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::clear()
 {
-    delete[] m_arr;
-    m_arr = nullptr;
-    m_cap=0;
+    detail::destroy(m_alloc, m_arr, m_arr+m_size);
     m_size=0;
 }
 
+/**
+ * @brief Reduces the capacity to the size, the elements are relocated
+ *        into the storage of exact size. The empty vector releases the storage.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::shrink_to_fit()
+{
+    if(m_size == m_cap){
+        return;
+    }
+    if(m_size == 0){
+        release();
+        return;
+    }
+    replace_storage(allocate(m_size), m_size);
+}
+
 /**
  * @brief Operator array subscripting.
  * @param index The index of the element.
  * @return A reference to the element at specified location index.
  *         With bounds checking.
  */
-template<class T>
-T& vector<T>::operator[](std::size_t index)
+template<class T, class Allocator, class GrowthPolicy>
+T& vector<T, Allocator, GrowthPolicy>::operator[](std::size_t index)
 {
     //assert((index>=0 && index<m_size) && "index out of range - m_arr[index]");
     return m_arr[index];
@@ -392,48 +984,212 @@ T& vector<T>::operator[](std::size_t index)
  * @return A constant reference to the element at specified location index.
  *         With bounds checking.
  */
-template<class T>
-const T& vector<T>::operator[](std::size_t index) const
+template<class T, class Allocator, class GrowthPolicy>
+const T& vector<T, Allocator, GrowthPolicy>::operator[](std::size_t index) const
 {
     //assert((index>=0 && index<m_size) && "index out of range - m_arr[index]");
     return m_arr[index];
 }
 
+#ifdef SCL_INSTRUMENT
 /**
- * @brief move_storage -
- * @param dest
- * @param from
- * @param n
+ * @brief The storage counters of the instance, see container_stats.
  */
-template<class T>
-void vector<T>::move_storage(T* dest, T* from, std::size_t n)
+template<class T, class Allocator, class GrowthPolicy>
+container_stats vector<T, Allocator, GrowthPolicy>::stats() const
 {
-    if(dest<from){
-        T *tmp_dest=dest, *tmp_from=from;
-        for(size_t i=0; i<n; i++){
-            *tmp_dest++ = std::move(*tmp_from++);
-        }
+    return m_stats.stats(m_arr != nullptr ? (m_cap-m_size)*sizeof(T) : 0);
+}
+
+/**
+ * @brief The storage counters of all the vectors of this type.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+container_stats vector<T, Allocator, GrowthPolicy>::total_stats()
+{
+    return instrument<vector<T, Allocator, GrowthPolicy>>::total();
+}
+#endif
+
+/**
+ * @brief Allocates the uninitialized storage for n elements using the allocator.
+ * @param n The number of elements.
+ * @return Pointer to the raw storage, no one element is constructed.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+T* vector<T, Allocator, GrowthPolicy>::allocate(std::size_t n)
+{
+    if(n == 0){
+        return nullptr;
     }
-    else if(dest>from){
-        T *tmp_dest=dest+n-1, *tmp_from=from+n-1;
-        for(size_t i=n; i>0; i--){
-            *tmp_dest-- = std::move(*tmp_from--);
-        }
+    assert((n <= alloc_traits::max_size(m_alloc)) && "Vector error: requested size is too large");
+    SCL_INSTRUMENT_EVENT(on_allocate(n*sizeof(T)));
+    return alloc_traits::allocate(m_alloc, n);
+}
+
+/**
+ * @brief Returns the storage of n elements obtained from allocate() to the allocator,
+ *        elements must be destroyed before.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::deallocate(T* ptr, std::size_t n)
+{
+    if(ptr != nullptr){
+        alloc_traits::deallocate(m_alloc, ptr, n);
     }
-    else
+}
+
+/**
+ * @brief Relocates elements into the new_arr storage and releases the old one.
+ * @param new_arr Uninitialized storage for new_cap elements.
+ * @param new_cap Capacity of the new_arr.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::replace_storage(T* new_arr, std::size_t new_cap)
+{
+    SCL_INSTRUMENT_EVENT(on_move(m_size*sizeof(T)));
+    try{
+        detail::relocate(m_alloc, new_arr, m_arr, m_size);
+    }
+    catch(...){
+        deallocate(new_arr, new_cap);
+        throw;
+    }
+    adopt_storage(new_arr, new_cap);
+}
+
+/**
+ * @brief Releases the old storage, its elements must be finished before,
+ *        and takes the new_arr storage filled by the elements.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::adopt_storage(T* new_arr, std::size_t new_cap)
+{
+    if(m_arr != nullptr) SCL_INSTRUMENT_EVENT(on_reallocate((m_cap-m_size)*sizeof(T)));
+    deallocate(m_arr, m_cap);
+    m_arr = new_arr;
+    m_cap = new_cap;
+}
+
+/**
+ * @brief Destroys the elements and returns the storage to the allocator,
+ *        the vector is left without storage.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::release()
+{
+    if(m_arr != nullptr) SCL_INSTRUMENT_EVENT(on_release((m_cap-m_size)*sizeof(T)));
+    detail::destroy(m_alloc, m_arr, m_arr+m_size);
+    deallocate(m_arr, m_cap);
+    m_arr = nullptr;
+    m_cap = 0;
+    m_size = 0;
+}
+
+/**
+ * @brief Grows the storage and constructs the new element at index in the new storage.
+ *        The new element is constructed before the old elements are moved,
+ *        so args may refer to the elements of the vector, see detail::relocate_insert().
+ * @param index Position of the new element, elements after it are shifted.
+ * @param args Arguments forwarded to the constructor of the element.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+template<class... Args>
+void vector<T, Allocator, GrowthPolicy>::realloc_insert(std::size_t index, Args&&... args)
+{
+    std::size_t new_cap = GrowthPolicy::next_capacity(m_cap, m_size+1, sizeof(T));
+    T* new_arr = allocate(new_cap);
+    SCL_INSTRUMENT_EVENT(on_move(m_size*sizeof(T)));
+    try{
+        detail::relocate_insert(m_alloc, new_arr, m_arr, m_size, index, std::forward<Args>(args)...);
+    }
+    catch(...){
+        deallocate(new_arr, new_cap);
+        throw;
+    }
+    adopt_storage(new_arr, new_cap);
+    ++m_size;
+}
+
+/**
+ * @brief Inserts n elements from first at index, the storage grows at most once.
+ *        If the storage is full, the inserted elements are constructed in the new
+ *        storage before the old elements are moved. Otherwise the tail is shifted,
+ *        see detail::shift_insert().
+ * @param index Position of the first inserted element.
+ * @param first Iterator to the first element to insert.
+ * @param n The number of elements.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+template<class ForwardIt>
+void vector<T, Allocator, GrowthPolicy>::range_insert(std::size_t index, ForwardIt first, std::size_t n)
+{
+    if(n == 0){
         return;
+    }
+    SCL_INSTRUMENT_EVENT(on_copy(n*sizeof(T)));
+    if(m_size+n > m_cap || m_arr == nullptr)
+    {
+        std::size_t new_cap = GrowthPolicy::next_capacity(m_cap, m_size+n, sizeof(T));
+        T* new_arr = allocate(new_cap);
+        SCL_INSTRUMENT_EVENT(on_move(m_size*sizeof(T)));
+        try{
+            detail::relocate_range_insert(m_alloc, new_arr, m_arr, m_size, index, first, n);
+        }
+        catch(...){
+            deallocate(new_arr, new_cap);
+            throw;
+        }
+        adopt_storage(new_arr, new_cap);
+        m_size += n;
+        return;
+    }
+    SCL_INSTRUMENT_EVENT(on_move((m_size-index)*sizeof(T)));
+    detail::shift_insert(m_alloc, m_arr, m_size, index, first, n);
+    m_size += n;
+}
+
+/**
+ * @brief Inserts the single pass range, the elements are appended one by one
+ *        and then rotated into the place.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+template<class InputIt>
+void vector<T, Allocator, GrowthPolicy>::range_insert(std::size_t index, InputIt first, InputIt last, std::input_iterator_tag)
+{
+    std::size_t old_size = m_size;
+    for(; first != last; ++first)
+    {
+        emplace_back(*first);
+    }
+    std::rotate(m_arr+index, m_arr+old_size, m_arr+m_size);
+}
+
+/**
+ * @brief Inserts the multi pass range, the distance is computed once.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+template<class ForwardIt>
+void vector<T, Allocator, GrowthPolicy>::range_insert(std::size_t index, ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+{
+    range_insert(index, first, static_cast<std::size_t>(std::distance(first, last)));
 }
 
 /**
  * @brief Deep swap two array use std::swap
+ *        The allocators are swapped if propagate_on_container_swap is set.
  */
-template<class T>
-void vector<T>::swap(vector<T>& other)
+template<class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::swap(vector<T, Allocator, GrowthPolicy>& other)
 {
+    if(alloc_traits::propagate_on_container_swap::value){
+        std::swap(m_alloc, other.m_alloc);
+    }
     std::swap(m_size, other.m_size);
     std::swap(m_cap, other.m_cap);
     std::swap(m_arr, other.m_arr);
 }
+
 }
 
 #endif //VECTOR_H
@@ -0,0 +1,389 @@
+#ifndef VECTOR_SNAPSHOT_H
+#define VECTOR_SNAPSHOT_H
+#include <cstdint>
+#include <cstdio>
+#include <cerrno>
+#include <string>
+#include <cassert>
+#include <utility>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "vector.h"
+#include "mmap_header.h"
+
+// Sequence containers library)
+namespace scl {
+
+namespace detail {
+/**
+ * @brief Throws std::system_error with the errno value.
+ */
+inline void throw_errno(const char* what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+/**
+ * @brief Writes all the bytes, the short writes are continued.
+ */
+inline void write_all(int fd, const void* buf, std::size_t bytes)
+{
+    const char* ptr = static_cast<const char*>(buf);
+    while(bytes != 0)
+    {
+        ssize_t written = ::write(fd, ptr, bytes);
+        if(written < 0){
+            if(errno == EINTR) continue;
+            throw_errno("Vector error: unable to write the snapshot");
+        }
+        ptr += written;
+        bytes -= static_cast<std::size_t>(written);
+    }
+}
+
+/**
+ * @brief Reads all the bytes, the short reads are continued.
+ */
+inline void read_all(int fd, void* buf, std::size_t bytes)
+{
+    char* ptr = static_cast<char*>(buf);
+    while(bytes != 0)
+    {
+        ssize_t count = ::read(fd, ptr, bytes);
+        if(count < 0){
+            if(errno == EINTR) continue;
+            throw_errno("Vector error: unable to read the snapshot");
+        }
+        if(count == 0){
+            throw std::runtime_error("Vector error: the snapshot is truncated");
+        }
+        ptr += count;
+        bytes -= static_cast<std::size_t>(count);
+    }
+}
+
+/**
+ * @brief Checks the header against the element type and the file size.
+ */
+inline void check_snapshot(const mmap_header& hdr, std::size_t elem_size, std::size_t file_size)
+{
+    if(hdr.m_magic != MMAP_VECTOR_MAGIC || hdr.m_version != MMAP_VECTOR_VERSION || hdr.m_elem_size != elem_size){
+        throw std::runtime_error("Vector error: the snapshot header doesn't match");
+    }
+    if(hdr.m_size > (file_size - MMAP_HEADER_SIZE) / elem_size){
+        throw std::runtime_error("Vector error: the snapshot is truncated");
+    }
+}
+
+/**
+ * @brief Closes the descriptor at the end of the scope.
+ *        close() reports the error, the destructor is for the error paths only.
+ */
+struct fd_guard
+{
+    int m_fd;
+    ~fd_guard(){if(m_fd >= 0) ::close(m_fd);}
+
+    void close()
+    {
+        const int fd = m_fd;
+        m_fd = -1;
+        if(::close(fd) != 0){
+            throw_errno("Vector error: unable to close the snapshot");
+        }
+    }
+};
+}
+
+/**
+ * @brief Writes the snapshot of the vector: mmap_header and the elements in one bulk write,
+ *        so the file is opened by mmap_vector as well. The snapshot is written to path.tmp,
+ *        synced and renamed over path, so the crash leaves the previous snapshot intact
+ *        and the mapping of it by snapshot_view stays valid.
+ *        Only the trivially copyable types are supported.
+ * @param vec The vector to write.
+ * @param path The path of the file.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void save(const vector<T, Allocator, GrowthPolicy>& vec, const std::string& path)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Vector error: snapshot of not trivially copyable type");
+    const std::string tmp_path = path + ".tmp";
+    try{
+        detail::fd_guard file{::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+        if(file.m_fd < 0){
+            detail::throw_errno("Vector error: unable to open the snapshot");
+        }
+        mmap_header hdr = {};
+        hdr.m_magic = MMAP_VECTOR_MAGIC;
+        hdr.m_version = MMAP_VECTOR_VERSION;
+        hdr.m_elem_size = static_cast<std::uint32_t>(sizeof(T));
+        hdr.m_size = vec.size();
+        detail::write_all(file.m_fd, &hdr, sizeof(hdr));
+        detail::write_all(file.m_fd, vec.data(), vec.size()*sizeof(T));
+        if(::fsync(file.m_fd) != 0){
+            detail::throw_errno("Vector error: unable to sync the snapshot");
+        }
+        file.close();
+        if(::rename(tmp_path.c_str(), path.c_str()) != 0){
+            detail::throw_errno("Vector error: unable to replace the snapshot");
+        }
+    }
+    catch(...){
+        ::unlink(tmp_path.c_str());
+        throw;
+    }
+}
+
+/**
+ * @brief Replaces the content of vec by the snapshot written by save() or by mmap_vector,
+ *        the storage is allocated once and filled by one bulk read.
+ *        For the zero-copy access use snapshot_view.
+ * @param vec The vector to fill.
+ * @param path The path of the file.
+ */
+template<class T, class Allocator, class GrowthPolicy>
+void load(vector<T, Allocator, GrowthPolicy>& vec, const std::string& path)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Vector error: snapshot of not trivially copyable type");
+    detail::fd_guard file{::open(path.c_str(), O_RDONLY)};
+    if(file.m_fd < 0){
+        detail::throw_errno("Vector error: unable to open the snapshot");
+    }
+    struct stat st;
+    if(::fstat(file.m_fd, &st) != 0){
+        detail::throw_errno("Vector error: unable to stat the snapshot");
+    }
+    const std::size_t file_size = static_cast<std::size_t>(st.st_size);
+    if(file_size < MMAP_HEADER_SIZE){
+        throw std::runtime_error("Vector error: the snapshot is too small");
+    }
+    mmap_header hdr;
+    detail::read_all(file.m_fd, &hdr, sizeof(hdr));
+    detail::check_snapshot(hdr, sizeof(T), file_size);
+
+    const std::size_t size = static_cast<std::size_t>(hdr.m_size);
+    vec.clear();
+    vec.reserve(size);
+    vec.resize_uninitialized(size);
+    detail::read_all(file.m_fd, vec.data(), size*sizeof(T));
+}
+
+/**
+ * Read-only view of the vector snapshot
+ * @brief The snapshot file written by save() or by mmap_vector is mapped as is, nothing is copied,
+ *        the pages are read on the first access. The view owns the mapping.
+ */
+template<class T>
+class snapshot_view
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Vector error: snapshot of not trivially copyable type");
+    static_assert(alignof(T) <= MMAP_HEADER_SIZE, "Vector error: T alignment is too large");
+
+private:
+    char* m_base = nullptr;
+    std::size_t m_length = 0;
+    std::size_t m_size = 0;
+
+    void unmap();
+
+public:
+    using value_type = T;
+    using const_iterator = const T*;
+
+    snapshot_view() noexcept;
+    explicit snapshot_view(const std::string& path);
+    snapshot_view(const snapshot_view<T>& other) = delete;
+    snapshot_view(snapshot_view<T>&& other) noexcept;
+    ~snapshot_view();
+    snapshot_view<T>& operator=(const snapshot_view<T>& other) = delete;
+    snapshot_view<T>& operator=(snapshot_view<T>&& other) noexcept;
+
+    inline std::size_t size() const;
+    bool empty() const;
+    const T* data() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    const T& front() const;
+    const T& back() const;
+    const T& operator[](std::size_t index) const;
+};
+
+/**
+ * @brief Default ctor, the empty view
+ */
+template<class T>
+snapshot_view<T>::snapshot_view() noexcept
+{}
+
+/**
+ * @brief Maps the snapshot file for reading and checks the header.
+ * @param path The path of the file.
+ */
+template<class T>
+snapshot_view<T>::snapshot_view(const std::string& path)
+{
+    detail::fd_guard file{::open(path.c_str(), O_RDONLY)};
+    if(file.m_fd < 0){
+        detail::throw_errno("Vector error: unable to open the snapshot");
+    }
+    struct stat st;
+    if(::fstat(file.m_fd, &st) != 0){
+        detail::throw_errno("Vector error: unable to stat the snapshot");
+    }
+    const std::size_t file_size = static_cast<std::size_t>(st.st_size);
+    if(file_size < MMAP_HEADER_SIZE){
+        throw std::runtime_error("Vector error: the snapshot is too small");
+    }
+    // The mapping stays valid after the descriptor is closed
+    void* addr = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, file.m_fd, 0);
+    if(addr == MAP_FAILED){
+        detail::throw_errno("Vector error: mmap of the snapshot failed");
+    }
+    m_base = static_cast<char*>(addr);
+    m_length = file_size;
+    try{
+        const mmap_header* hdr = reinterpret_cast<const mmap_header*>(m_base);
+        detail::check_snapshot(*hdr, sizeof(T), file_size);
+        m_size = static_cast<std::size_t>(hdr->m_size);
+    }
+    catch(...){
+        unmap();
+        throw;
+    }
+}
+
+/**
+ * @brief Move ctor, takes the mapping of other
+ */
+template<class T>
+snapshot_view<T>::snapshot_view(snapshot_view<T>&& other) noexcept
+    :m_base(other.m_base)
+    ,m_length(other.m_length)
+    ,m_size(other.m_size)
+{
+    other.m_base = nullptr;
+    other.m_length = 0;
+    other.m_size = 0;
+}
+
+/**
+ * @brief Dtor, unmaps the file
+ */
+template<class T>
+snapshot_view<T>::~snapshot_view()
+{
+    unmap();
+}
+
+/**
+ * @brief Move assignment operator
+ */
+template<class T>
+snapshot_view<T>& snapshot_view<T>::operator=(snapshot_view<T>&& other) noexcept
+{
+    if(this != &other){
+        unmap();
+        std::swap(m_base, other.m_base);
+        std::swap(m_length, other.m_length);
+        std::swap(m_size, other.m_size);
+    }
+    return *this;
+}
+
+/**
+ * @brief The number of elements in the snapshot.
+ */
+template<class T>
+std::size_t snapshot_view<T>::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief Checks whether the snapshot is empty.
+ */
+template<class T>
+bool snapshot_view<T>::empty() const
+{
+    return m_size == 0;
+}
+
+/**
+ * @brief Pointer to the elements, they start after the header.
+ */
+template<class T>
+const T* snapshot_view<T>::data() const
+{
+    return m_base ? reinterpret_cast<const T*>(m_base + MMAP_HEADER_SIZE) : nullptr;
+}
+
+/**
+ * @brief Begin iterator, the plain pointer to the mapped elements.
+ */
+template<class T>
+typename snapshot_view<T>::const_iterator snapshot_view<T>::begin() const
+{
+    return data();
+}
+
+/**
+ * @brief End iterator.
+ */
+template<class T>
+typename snapshot_view<T>::const_iterator snapshot_view<T>::end() const
+{
+    return data() + m_size;
+}
+
+/**
+ * @brief Get a first element from the snapshot.
+ */
+template<class T>
+const T& snapshot_view<T>::front() const
+{
+    return data()[0];
+}
+
+/**
+ * @brief Get a back element from the snapshot.
+ */
+template<class T>
+const T& snapshot_view<T>::back() const
+{
+    return data()[m_size-1];
+}
+
+/**
+ * @brief Constant operator array subscripting
+ */
+template<class T>
+const T& snapshot_view<T>::operator[](std::size_t index) const
+{
+    assert((index < m_size) && "Vector error: snapshot index out of range");
+    return data()[index];
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+template<class T>
+void snapshot_view<T>::unmap()
+{
+    if(m_base != nullptr){
+        ::munmap(m_base, m_length);
+        m_base = nullptr;
+        m_length = 0;
+        m_size = 0;
+    }
+}
+}
+
+#endif //VECTOR_SNAPSHOT_H
@@ -0,0 +1,303 @@
+#ifndef VECTOR_STORAGE_H
+#define VECTOR_STORAGE_H
+#include <cstring>
+#include <utility>
+#include <memory>
+#include <type_traits>
+
+// Sequence containers library)
+namespace scl {
+
+/**
+ * @brief is_trivially_relocatable - the type can be moved to a new address
+ *        by a plain memcpy, after which the source is not destroyed.
+ *        By default it is true for trivially copyable types, specialize
+ *        it for own types (e.g. the pointer owning handles).
+ */
+template<class T>
+struct is_trivially_relocatable
+        : std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+{};
+
+/**
+ * The element algorithms of the contiguous storage shared by scl::vector and scl::small_vector.
+ * @brief The functions work on the raw storage and the elements only, the container
+ *        keeps the ownership of the storage: it allocates the new storage before the call
+ *        and deallocates it if the call throws. Every function leaves no live element
+ *        in the storage it failed to fill.
+ */
+namespace detail {
+
+/**
+ * @brief fill_iterator - repeats the same value, used to share the range insert code
+ */
+template<class T>
+struct fill_iterator
+{
+    const T* m_value;
+    const T& operator*() const {return *m_value;}
+    fill_iterator& operator++(){return *this;}
+};
+
+/**
+ * @brief Calls the destructors for the range [first, last).
+ */
+template<class Allocator, class T>
+void destroy(Allocator& alloc, T* first, T* last)
+{
+    if(std::is_trivially_destructible<T>::value){
+        return;
+    }
+    for(; first != last; ++first)
+    {
+        std::allocator_traits<Allocator>::destroy(alloc, first);
+    }
+}
+
+/**
+ * @brief Constructs n elements in the uninitialized dest storage from the live
+ *        elements at from, the source is left untouched. Trivially relocatable types
+ *        are copied with memcpy, others are moved with std::move_if_noexcept, so the
+ *        copy ctor is used only for types with the throwing move ctor.
+ *        If a ctor throws, the already constructed elements of dest are destroyed.
+ * @param dest Uninitialized storage.
+ * @param from Storage with n constructed elements, doesn't overlap with dest.
+ * @param n The number of elements.
+ */
+template<class Allocator, class T>
+void transfer(Allocator& alloc, T* dest, T* from, std::size_t n)
+{
+    if(is_trivially_relocatable<T>::value){
+        if(n) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(from), n*sizeof(T));
+        return;
+    }
+    std::size_t i = 0;
+    try{
+        for(; i<n; ++i)
+        {
+            std::allocator_traits<Allocator>::construct(alloc, dest+i, std::move_if_noexcept(from[i]));
+        }
+    }
+    catch(...){
+        destroy(alloc, dest, dest+i);
+        throw;
+    }
+}
+
+/**
+ * @brief Moves n elements from the live storage into the uninitialized dest storage,
+ *        see transfer(). The source elements are finished, the memcpy'ed ones
+ *        must not be destroyed, others are destroyed.
+ */
+template<class Allocator, class T>
+void relocate(Allocator& alloc, T* dest, T* from, std::size_t n)
+{
+    transfer(alloc, dest, from, n);
+    if(!is_trivially_relocatable<T>::value){
+        destroy(alloc, from, from+n);
+    }
+}
+
+/**
+ * @brief Copy constructs n elements in the uninitialized dest storage from first.
+ *        If a ctor throws, the already constructed elements are destroyed.
+ */
+template<class Allocator, class T, class ForwardIt>
+void copy_construct_n(Allocator& alloc, T* dest, ForwardIt first, std::size_t n, std::false_type)
+{
+    std::size_t i = 0;
+    try{
+        for(; i<n; ++i, ++first)
+        {
+            std::allocator_traits<Allocator>::construct(alloc, dest+i, *first);
+        }
+    }
+    catch(...){
+        destroy(alloc, dest, dest+i);
+        throw;
+    }
+}
+
+/**
+ * @brief Copy constructs n trivially copyable elements with memcpy.
+ */
+template<class Allocator, class T>
+void copy_construct_n(Allocator&, T* dest, const T* first, std::size_t n, std::true_type)
+{
+    if(n) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n*sizeof(T));
+}
+
+/**
+ * @brief Selects the memcpy for the pointer ranges of the trivially copyable types.
+ */
+template<class Allocator, class T, class ForwardIt>
+void copy_construct_n(Allocator& alloc, T* dest, ForwardIt first, std::size_t n)
+{
+    using pointee = typename std::remove_cv<typename std::remove_pointer<ForwardIt>::type>::type;
+    copy_construct_n(alloc, dest, first, n, std::integral_constant<bool,
+                     std::is_trivially_copyable<T>::value &&
+                     std::is_pointer<ForwardIt>::value &&
+                     std::is_same<pointee, T>::value>());
+}
+
+/**
+ * @brief move_storage - moves n live elements inside the storage,
+ *        the ranges can overlap. Trivially copyable types use memmove.
+ */
+template<class T>
+void move_storage(T* dest, T* from, std::size_t n)
+{
+    if(std::is_trivially_copyable<T>::value){
+        if(n && dest != from) std::memmove(static_cast<void*>(dest), static_cast<const void*>(from), n*sizeof(T));
+        return;
+    }
+    if(dest<from){
+        for(std::size_t i=0; i<n; i++){
+            *dest++ = std::move(*from++);
+        }
+    }
+    else if(dest>from){
+        dest += n;
+        from += n;
+        for(std::size_t i=n; i>0; i--){
+            *--dest = std::move(*--from);
+        }
+    }
+}
+
+/**
+ * @brief Fills the new storage for the insertion of one element at index: the new element
+ *        is constructed before the old elements are moved, so args may refer to them.
+ *        On success the size elements of arr are finished, the caller releases arr.
+ * @param new_arr Uninitialized storage for at least size+1 elements.
+ * @param arr Storage with size constructed elements.
+ * @param index Position of the new element, elements after it are shifted.
+ * @param args Arguments forwarded to the constructor of the element.
+ */
+template<class Allocator, class T, class... Args>
+void relocate_insert(Allocator& alloc, T* new_arr, T* arr, std::size_t size, std::size_t index, Args&&... args)
+{
+    std::allocator_traits<Allocator>::construct(alloc, new_arr+index, std::forward<Args>(args)...);
+    try{
+        transfer(alloc, new_arr, arr, index);
+    }
+    catch(...){
+        std::allocator_traits<Allocator>::destroy(alloc, new_arr+index);
+        throw;
+    }
+    try{
+        transfer(alloc, new_arr+index+1, arr+index, size-index);
+    }
+    catch(...){
+        destroy(alloc, new_arr, new_arr+index+1);
+        throw;
+    }
+    if(!is_trivially_relocatable<T>::value){
+        destroy(alloc, arr, arr+size);
+    }
+}
+
+/**
+ * @brief Fills the new storage for the insertion of n elements from first at index,
+ *        the inserted elements are constructed before the old elements are moved.
+ *        On success the size elements of arr are finished, the caller releases arr.
+ * @param new_arr Uninitialized storage for at least size+n elements.
+ * @param arr Storage with size constructed elements.
+ */
+template<class Allocator, class T, class ForwardIt>
+void relocate_range_insert(Allocator& alloc, T* new_arr, T* arr, std::size_t size, std::size_t index, ForwardIt first, std::size_t n)
+{
+    copy_construct_n(alloc, new_arr+index, first, n);
+    try{
+        transfer(alloc, new_arr, arr, index);
+    }
+    catch(...){
+        destroy(alloc, new_arr+index, new_arr+index+n);
+        throw;
+    }
+    try{
+        transfer(alloc, new_arr+index+n, arr+index, size-index);
+    }
+    catch(...){
+        destroy(alloc, new_arr, new_arr+index+n);
+        throw;
+    }
+    if(!is_trivially_relocatable<T>::value){
+        destroy(alloc, arr, arr+size);
+    }
+}
+
+/**
+ * @brief Inserts n elements from first at index into the storage with enough capacity,
+ *        the tail is shifted: trivially copyable types with one memmove,
+ *        others like std::vector does.
+ * @param arr Storage with size constructed elements and the capacity for size+n.
+ */
+template<class Allocator, class T, class ForwardIt>
+void shift_insert(Allocator& alloc, T* arr, std::size_t size, std::size_t index, ForwardIt first, std::size_t n)
+{
+    T* pos = arr+index;
+    std::size_t elems_after = size-index;
+    if(std::is_trivially_copyable<T>::value){
+        move_storage(pos+n, pos, elems_after);
+        copy_construct_n(alloc, pos, first, n);
+    }
+    else if(elems_after > n){
+        T* old_end = arr+size;
+        for(std::size_t i=0; i<n; ++i)
+        {
+            std::allocator_traits<Allocator>::construct(alloc, old_end+i, std::move(*(old_end-n+i)));
+        }
+        move_storage(pos+n, pos, elems_after-n);
+        for(std::size_t i=0; i<n; ++i, ++first)
+        {
+            pos[i] = *first;
+        }
+    }
+    else{
+        ForwardIt mid = first;
+        for(std::size_t i=0; i<elems_after; ++i)
+        {
+            ++mid;
+        }
+        copy_construct_n(alloc, arr+size, mid, n-elems_after);
+        T* tail = arr+size+(n-elems_after);
+        for(std::size_t i=0; i<elems_after; ++i)
+        {
+            std::allocator_traits<Allocator>::construct(alloc, tail+i, std::move(pos[i]));
+        }
+        for(std::size_t i=0; i<elems_after; ++i, ++first)
+        {
+            pos[i] = *first;
+        }
+    }
+}
+
+/**
+ * @brief Removes the elements satisfying the predicate in a single pass.
+ *        The order of the remaining elements is preserved, each survivor is moved once.
+ * @return The new size, the elements after it are destroyed.
+ */
+template<class Allocator, class T, class Pred>
+std::size_t remove_if(Allocator& alloc, T* arr, std::size_t size, Pred& pred)
+{
+    std::size_t keep = 0;
+    while(keep < size && !pred(arr[keep]))
+    {
+        ++keep;
+    }
+    for(std::size_t i=keep+1; i<size; ++i)
+    {
+        if(!pred(arr[i])){
+            arr[keep++] = std::move(arr[i]);
+        }
+    }
+    if(keep < size){
+        destroy(alloc, arr+keep, arr+size);
+    }
+    return keep;
+}
+}
+}
+
+#endif //VECTOR_STORAGE_H
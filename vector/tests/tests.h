@@ -6,7 +6,15 @@
 #include <gtest/gtest.h>
 
 #include <vector>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <iterator>
+#include <fstream>
+#include <cstdio>
 #include "vector.h"
+#include "vector_snapshot.h"
+#include "mmap_vector.h"
 
 namespace vector_testing {
 const std::size_t num_of_elements = 100001;
@@ -42,6 +50,93 @@ void do_nothing(const T &elem)
     return;
 }
 
+/**
+ * @brief Record without default ctor, owns the heap buffer
+ */
+struct NoDefaultRecord
+{
+    explicit NoDefaultRecord(int id):m_id(id), m_name(std::to_string(id)){}
+    int m_id;
+    std::string m_name;
+};
+
+/**
+ * @brief The element counting the live objects, the copy and the default ctor
+ *        throw when countdown runs out
+ */
+struct ThrowingRecord
+{
+    static int live;
+    static int countdown;
+    int m_value = 0;
+
+    ThrowingRecord(){tick(); ++live;}
+    ThrowingRecord(const ThrowingRecord& other):m_value(other.m_value){tick(); ++live;}
+    ~ThrowingRecord(){--live;}
+    static void tick()
+    {
+        if(countdown > 0 && --countdown == 0){
+            throw std::runtime_error("ctor");
+        }
+    }
+};
+int ThrowingRecord::live = 0;
+int ThrowingRecord::countdown = 0;
+
+/**
+ * @brief Allocator counting the allocations of the instance group
+ */
+template<typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    std::size_t *m_allocs;
+
+    explicit CountingAllocator(std::size_t *allocs) noexcept:m_allocs(allocs){}
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept:m_allocs(other.m_allocs){}
+
+    T* allocate(std::size_t n)
+    {
+        ++*m_allocs;
+        return static_cast<T*>(::operator new(n*sizeof(T)));
+    }
+    void deallocate(T* ptr, std::size_t)
+    {
+        ::operator delete(ptr);
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const CountingAllocator<T>& lhs, const CountingAllocator<U>& rhs){return lhs.m_allocs == rhs.m_allocs;}
+template<typename T, typename U>
+bool operator!=(const CountingAllocator<T>& lhs, const CountingAllocator<U>& rhs){return !(lhs == rhs);}
+
+/**
+ * @brief Trivially copyable record for the snapshots
+ */
+struct SnapshotRecord
+{
+    std::int64_t m_key;
+    double m_value;
+};
+
+/**
+ * @brief temp_path - the unique path in /tmp
+ * @return the path of the file, the file doesn't exist
+ */
+inline std::string temp_path()
+{
+    char name[] = "/tmp/scl_vector_XXXXXX";
+    int fd = ::mkstemp(name);
+    ::close(fd);
+    ::unlink(name);
+    return std::string(name);
+}
+
 /**
  * @brief container filling
  */
@@ -54,6 +149,30 @@ void fill(scl::vector<T> *vec)
     }
 }
 
+/**
+ * @brief Steady-state refill workload, the vector is cleared and filled again
+ * @param allocs - the number of allocations
+ * @return the time in seconds
+ */
+template<typename Policy>
+double refill(std::size_t &allocs, std::size_t &capacity)
+{
+    const std::size_t cycles = 50;
+    CountingAllocator<int> alloc(&allocs);
+    scl::vector<int, CountingAllocator<int>, Policy> refill_vec(alloc);
+    double start_time = get_time_sec();
+    for(std::size_t c=0; c<cycles; ++c)
+    {
+        refill_vec.clear();
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            refill_vec.push_back(static_cast<int>(i));
+        }
+    }
+    capacity = refill_vec.capacity();
+    return get_time_sec() - start_time;
+}
+
 class VectorCheckFixture: public ::testing::Test
 {
 public:
@@ -191,6 +310,572 @@ TEST_F(VectorCompareFixture, IteratorOperation)
         ASSERT_EQ(*iter, *iter_std);
     }
 }
+TEST_F(VectorCheckFixture, CheckNoDefaultConstructible)
+{
+    //Arrange
+    scl::vector<NoDefaultRecord> records;
+    //Act
+    for(int i=0; i<static_cast<int>(num_of_elements); ++i)
+    {
+        records.push_back(NoDefaultRecord(i));
+    }
+    records.push_back(records.front());
+    //Assert
+    ASSERT_EQ(records.size(), num_of_elements+1);
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        ASSERT_EQ(records[i].m_id, static_cast<int>(i));
+        ASSERT_EQ(records[i].m_name, std::to_string(i));
+    }
+    ASSERT_EQ(records.back().m_name, "0");
+    records.pop_back();
+    ASSERT_EQ(records.back().m_id, static_cast<int>(num_of_elements-1));
+}
+
+TEST_F(VectorCheckFixture, CheckAllocator)
+{
+    //Arrange
+    std::size_t first_allocs = 0, second_allocs = 0;
+    CountingAllocator<int> first_alloc(&first_allocs), second_alloc(&second_allocs);
+    scl::vector<int, CountingAllocator<int>> first(first_alloc);
+    scl::vector<int, CountingAllocator<int>> second(second_alloc);
+    //Act
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        first.push_back(static_cast<int>(i));
+    }
+    std::size_t grow_allocs = first_allocs;
+    second = first;
+    //Assert
+    ASSERT_GT(grow_allocs, 1U);
+    ASSERT_EQ(second.get_allocator(), first_alloc);
+    ASSERT_EQ(second_allocs, 1U);
+    ASSERT_EQ(first_allocs, grow_allocs+1);
+    ASSERT_EQ(second.size(), num_of_elements);
+    ASSERT_EQ(second.back(), static_cast<int>(num_of_elements-1));
+}
+
+TEST_F(VectorCheckFixture, CheckEmplaceAndMove)
+{
+    //Arrange
+    scl::vector<std::string> strs;
+    std::string payload(64, 'a');
+    const char* payload_data = payload.data();
+    //Act
+    strs.push_back(std::move(payload));
+    strs.emplace_back(3, 'c');
+    strs.emplace(strs.begin(), "first");
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        strs.emplace_back(std::to_string(i));
+    }
+    auto it = strs.emplace(strs.begin(), strs[2]);
+    scl::vector<std::string> moved(std::move(strs));
+    scl::vector<std::string> assigned;
+    assigned = std::move(moved);
+    //Assert
+    ASSERT_EQ(*it, "ccc");
+    ASSERT_EQ(assigned.size(), num_of_elements+4);
+    ASSERT_EQ(assigned[0], "ccc");
+    ASSERT_EQ(assigned[1], "first");
+    ASSERT_EQ(assigned[2].data(), payload_data);
+    ASSERT_EQ(assigned[3], "ccc");
+    ASSERT_EQ(assigned.back(), std::to_string(num_of_elements-1));
+    ASSERT_TRUE(strs.empty());
+    ASSERT_TRUE(moved.empty());
+    moved.push_back("reuse");
+    ASSERT_EQ(moved.front(), "reuse");
+}
+
+TEST_F(VectorCompareFixture, RangeInsert)
+{
+    //Arrange
+    std::vector<std::string> source;
+    for(std::size_t i=0; i<num_of_elements/10; ++i)
+    {
+        source.push_back(std::to_string(std::rand() % module));
+    }
+    std::vector<std::string> expected(source.begin(), source.end());
+    //Act
+    scl::vector<std::string> strs(source.begin(), source.end());
+    strs.insert(strs.begin(), 3, std::string("fill"));
+    expected.insert(expected.begin(), 3, std::string("fill"));
+    strs.insert(strs.begin(), source.begin(), source.begin()+5);
+    expected.insert(expected.begin(), source.begin(), source.begin()+5);
+    strs.insert(strs.end(), source.begin(), source.end());
+    expected.insert(expected.end(), source.begin(), source.end());
+    strs.append(source.data(), 2);
+    expected.insert(expected.end(), source.begin(), source.begin()+2);
+    std::istringstream stream("one two three");
+    strs.insert(strs.begin(), std::istream_iterator<std::string>(stream), std::istream_iterator<std::string>());
+    expected.insert(expected.begin(), {"one", "two", "three"});
+    //Assert
+    ASSERT_EQ(strs.size(), expected.size());
+    for(std::size_t i=0; i<expected.size(); ++i)
+    {
+        ASSERT_EQ(strs[i], expected[i]);
+    }
+}
+
+TEST_F(VectorCompareFixture, AppendSingleGrowth)
+{
+    //Arrange
+    std::size_t allocs = 0;
+    CountingAllocator<int> alloc(&allocs);
+    scl::vector<int, CountingAllocator<int>> batch_vec(alloc);
+    std::vector<int> batch;
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        batch.push_back(static_cast<int>(std::rand() % module));
+    }
+    //Act
+    batch_vec.append(batch.data(), batch.size());
+    std::size_t append_allocs = allocs;
+    batch_vec.insert(batch_vec.begin(), batch.begin(), batch.end());
+    vec->insert(vec->begin(), 10, 7);
+    vec->insert(vec->end(), batch.data(), batch.data()+batch.size());
+    vec_std->insert(vec_std->begin(), 10, 7);
+    vec_std->insert(vec_std->end(), batch.begin(), batch.end());
+    //Assert
+    ASSERT_EQ(append_allocs, 2U);
+    ASSERT_EQ(allocs, 3U);
+    ASSERT_EQ(batch_vec.size(), 2*num_of_elements);
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        ASSERT_EQ(batch_vec[i], batch[i]);
+        ASSERT_EQ(batch_vec[i+num_of_elements], batch[i]);
+    }
+    ASSERT_EQ(vec->size(), vec_std->size());
+    for(std::size_t i=0; i<vec_std->size(); ++i)
+    {
+        ASSERT_EQ((*vec)[i], (*vec_std)[i]);
+    }
+}
+
+TEST_F(VectorCompareFixture, EraseOperations)
+{
+    //Arrange
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        int k = static_cast<int>(std::rand() % module);
+        vec->push_back(k);
+        vec_std->push_back(k);
+    }
+    auto is_odd = [](int k){return k % 2 != 0;};
+    //Act
+    auto first = vec->begin(), last = vec->begin();
+    for(std::size_t i=0; i<10; ++i, ++last);
+    auto it = vec->erase(first, last);
+    vec_std->erase(vec_std->begin(), vec_std->begin()+10);
+    std::size_t removed = vec->erase_if(is_odd);
+    std::size_t std_size = vec_std->size();
+    vec_std->erase(std::remove_if(vec_std->begin(), vec_std->end(), is_odd), vec_std->end());
+    //Assert
+    ASSERT_TRUE(it == vec->begin());
+    ASSERT_EQ(removed, std_size - vec_std->size());
+    ASSERT_EQ(vec->size(), vec_std->size());
+    for(std::size_t i=0; i<vec_std->size(); ++i)
+    {
+        ASSERT_EQ((*vec)[i], (*vec_std)[i]);
+    }
+    int back = vec->back();
+    it = vec->unordered_erase(vec->begin());
+    ASSERT_EQ(*it, back);
+    ASSERT_EQ(vec->size(), vec_std->size()-1);
+}
+
+TEST_F(VectorCheckFixture, CheckEraseBackTime)
+{
+    //Arrange
+    fill(vec);
+    last_time = get_time_sec();
+    //Act
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        auto it = vec->end();
+        --it;
+        vec->erase(it);
+    }
+    get_new_time(sum_time, last_time);
+    //Assert
+    ASSERT_TRUE(vec->empty());
+    ASSERT_LE(sum_time/num_of_elements, o1_time);
+}
+
+TEST_F(VectorCheckFixture, CheckClearAndShrink)
+{
+    //Arrange
+    fill(vec);
+    std::size_t cap = vec->capacity();
+    //Act
+    vec->clear();
+    //Assert
+    ASSERT_TRUE(vec->empty());
+    ASSERT_EQ(vec->capacity(), cap);
+    vec->push_back(1);
+    vec->shrink_to_fit();
+    ASSERT_EQ(vec->capacity(), 1U);
+    ASSERT_EQ(vec->front(), 1);
+    vec->pop_back();
+    vec->shrink_to_fit();
+    ASSERT_EQ(vec->capacity(), 0U);
+    vec->push_back(2);
+    ASSERT_EQ(vec->back(), 2);
+}
+
+TEST(CheckResize, Uninitialized)
+{
+    //Arrange
+    scl::vector<int> vec;
+    vec.push_back(1);
+    vec.push_back(2);
+    //Act
+    vec.resize_uninitialized(num_of_elements);
+    for(std::size_t i=2; i<num_of_elements; ++i)
+    {
+        vec[i] = static_cast<int>(i);
+    }
+    //Assert
+    ASSERT_EQ(vec.size(), num_of_elements);
+    ASSERT_GE(vec.capacity(), num_of_elements);
+    ASSERT_EQ(vec[0], 1);
+    ASSERT_EQ(vec[1], 2);
+    ASSERT_EQ(vec.back(), static_cast<int>(num_of_elements-1));
+    vec.resize_uninitialized(1);
+    ASSERT_EQ(vec.size(), 1U);
+    ASSERT_EQ(vec.back(), 1);
+}
+
+TEST(CheckResize, UninitializedGrowth)
+{
+    //Arrange
+    std::size_t allocs = 0;
+    scl::vector<int, CountingAllocator<int>, scl::growth_factor_2> vec(0, CountingAllocator<int>(&allocs));
+    //Act
+    for(std::size_t size=1; size<=1024; ++size)
+    {
+        vec.resize_uninitialized(size);
+        vec[size-1] = static_cast<int>(size);
+    }
+    //Assert
+    ASSERT_EQ(vec.size(), 1024U);
+    ASSERT_EQ(vec.capacity(), 1024U);
+    ASSERT_EQ(allocs, 11U);
+    for(std::size_t i=0; i<vec.size(); ++i)
+    {
+        ASSERT_EQ(vec[i], static_cast<int>(i+1));
+    }
+    vec.resize_uninitialized(1500);
+    ASSERT_EQ(vec.capacity(), 2048U);
+}
+
+TEST(CheckCtor, ThrowingElements)
+{
+    //Arrange
+    std::size_t allocs = 0;
+    CountingAllocator<ThrowingRecord> alloc(&allocs);
+    using counted = scl::vector<ThrowingRecord, CountingAllocator<ThrowingRecord>>;
+    std::vector<ThrowingRecord> source(10);
+    //Act
+    ThrowingRecord::countdown = 5;
+    ASSERT_THROW(counted sized(10, alloc), std::runtime_error);
+    counted full(5, alloc);
+    ThrowingRecord::countdown = 3;
+    ASSERT_THROW(counted copy(full), std::runtime_error);
+    ThrowingRecord::countdown = 4;
+    ASSERT_THROW(counted ranged(source.begin(), source.end(), alloc), std::runtime_error);
+    ThrowingRecord::countdown = 0;
+    //Assert
+    ASSERT_EQ(ThrowingRecord::live, 15);
+    counted copy(full);
+    ASSERT_EQ(copy.size(), 5U);
+    ASSERT_EQ(ThrowingRecord::live, 20);
+}
+
+TEST(CheckGrowthPolicy, SizedCtor)
+{
+    //Arrange
+    scl::vector<int> vec(100);
+    scl::vector<int, std::allocator<int>, scl::growth_factor_2> doubling(100);
+    scl::vector<int> empty(0);
+    //Act
+    vec.push_back(1);
+    doubling.push_back(1);
+    empty.push_back(1);
+    //Assert
+    ASSERT_EQ(vec.capacity(), scl::growth_factor_1_5::next_capacity(100, 101, sizeof(int)));
+    ASSERT_EQ(doubling.capacity(), 200U);
+    ASSERT_EQ(empty.capacity(), 1U);
+    ASSERT_EQ(vec[99], 0);
+    ASSERT_EQ(vec.back(), 1);
+}
+
+TEST(CompareGrowthPolicy, Refill)
+{
+    std::size_t allocs_1_5 = 0, allocs_2 = 0, allocs_page = 0, allocs_huge = 0;
+    std::size_t cap_1_5 = 0, cap_2 = 0, cap_page = 0, cap_huge = 0;
+    double time_1_5 = refill<scl::growth_factor_1_5>(allocs_1_5, cap_1_5);
+    double time_2 = refill<scl::growth_factor_2>(allocs_2, cap_2);
+    double time_page = refill<scl::page_growth<>>(allocs_page, cap_page);
+    double time_huge = refill<scl::huge_page_growth>(allocs_huge, cap_huge);
+    std::cout << "refill 1.5x: " << allocs_1_5 << " allocations, " << time_1_5 << " s\n"
+              << "refill 2x: " << allocs_2 << " allocations, " << time_2 << " s\n"
+              << "refill page: " << allocs_page << " allocations, " << time_page << " s\n"
+              << "refill huge page: " << allocs_huge << " allocations, " << time_huge << " s\n";
+    ASSERT_LT(allocs_2, allocs_1_5);
+    ASSERT_EQ(cap_page*sizeof(int) % 4096, 0U);
+    ASSERT_GE(cap_huge, num_of_elements);
+    ASSERT_EQ(scl::huge_page_growth::next_capacity(1U << 20, (1U << 20)+1, sizeof(int))*sizeof(int) % (2*1024*1024), 0U);
+    // Only the first cycle allocates, clear() keeps the capacity
+    std::size_t once_allocs = 0, once_cap = 0;
+    CountingAllocator<int> alloc(&once_allocs);
+    scl::vector<int, CountingAllocator<int>> once(alloc);
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        once.push_back(static_cast<int>(i));
+    }
+    once_cap = once.capacity();
+    ASSERT_EQ(cap_1_5, once_cap);
+    ASSERT_EQ(allocs_1_5, once_allocs);
+}
+
+TEST_F(VectorCompareFixture, PushBackThroughput)
+{
+    const std::size_t rounds = 20;
+    const std::string payload(32, 'a');
+    double std_time = 0;
+    for(std::size_t r=0; r<rounds; ++r)
+    {
+        scl::vector<std::string> svec;
+        last_time = get_time_sec();
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            svec.push_back(payload);
+        }
+        get_new_time(sum_time, last_time);
+        ASSERT_EQ(svec.size(), num_of_elements);
+
+        std::vector<std::string> svec_std;
+        last_time = get_time_sec();
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            svec_std.push_back(payload);
+        }
+        get_new_time(std_time, last_time);
+    }
+    for(std::size_t r=0; r<rounds; ++r)
+    {
+        vec->clear();
+        vec_std->clear();
+        last_time = get_time_sec();
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            vec->push_back(static_cast<int>(i));
+        }
+        get_new_time(sum_time, last_time);
+        vec_std->shrink_to_fit();
+        last_time = get_time_sec();
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            vec_std->push_back(static_cast<int>(i));
+        }
+        get_new_time(std_time, last_time);
+    }
+    std::cout << "push_back scl::vector: " << sum_time << " s, std::vector: " << std_time << " s\n";
+    ASSERT_EQ(vec->size(), vec_std->size());
+}
+TEST_F(VectorCompareFixture, StandardAlgorithms)
+{
+    //Arrange
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        int k = static_cast<int>(std::rand() % module - module/2);
+        vec->push_back(k);
+        vec_std->push_back(k);
+    }
+    const scl::vector<int>& cvec = *vec;
+    //Act
+    std::sort(vec->begin(), vec->end());
+    std::sort(vec_std->begin(), vec_std->end());
+    scl::vector<int>::const_iterator found = std::lower_bound(cvec.cbegin(), cvec.cend(), 0);
+    std::vector<int>::const_iterator found_std = std::lower_bound(vec_std->cbegin(), vec_std->cend(), 0);
+    std::vector<int> copied(vec->size());
+    std::copy(cvec.begin(), cvec.end(), copied.begin());
+    //Assert
+    ASSERT_TRUE(std::is_sorted(cvec.begin(), cvec.end()));
+    ASSERT_EQ(found - cvec.cbegin(), found_std - vec_std->cbegin());
+    ASSERT_EQ(cvec.cend() - cvec.cbegin(), static_cast<std::ptrdiff_t>(cvec.size()));
+    ASSERT_TRUE(std::equal(copied.begin(), copied.end(), vec_std->begin()));
+    ASSERT_TRUE(std::equal(vec->rbegin(), vec->rend(), vec_std->rbegin()));
+    ASSERT_EQ(vec->begin()[7], (*vec_std)[7]);
+    ASSERT_TRUE(vec->begin() < vec->end());
+    ASSERT_TRUE(vec->begin() + 3 == 3 + cvec.cbegin());
+    ASSERT_EQ(cvec.data(), &cvec.front());
+}
+
+TEST_F(VectorCompareFixture, SortThroughput)
+{
+    const std::size_t rounds = 10;
+    double std_time = 0;
+    for(std::size_t r=0; r<rounds; ++r)
+    {
+        vec->clear();
+        vec_std->clear();
+        for(std::size_t i=0; i<num_of_elements; ++i)
+        {
+            int k = static_cast<int>(std::rand() % module);
+            vec->push_back(k);
+            vec_std->push_back(k);
+        }
+        last_time = get_time_sec();
+        std::sort(vec->begin(), vec->end());
+        get_new_time(sum_time, last_time);
+        std::sort(vec_std->begin(), vec_std->end());
+        get_new_time(std_time, last_time);
+        ASSERT_TRUE(std::equal(vec->cbegin(), vec->cend(), vec_std->cbegin()));
+    }
+    std::cout << "std::sort scl::vector: " << sum_time << " s, std::vector: " << std_time << " s\n";
+}
+
+TEST(CheckSnapshot, SaveLoadAndView)
+{
+    //Arrange
+    const std::string path = temp_path();
+    scl::vector<SnapshotRecord> records;
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        records.push_back(SnapshotRecord{static_cast<std::int64_t>(i), i * 0.5});
+    }
+    scl::vector<SnapshotRecord> loaded;
+    loaded.push_back(SnapshotRecord{-1, -1.0});
+    //Act
+    scl::save(records, path);
+    scl::load(loaded, path);
+    scl::snapshot_view<SnapshotRecord> view(path);
+    scl::snapshot_view<SnapshotRecord> moved(std::move(view));
+    //Assert
+    ASSERT_EQ(loaded.size(), records.size());
+    ASSERT_EQ(moved.size(), records.size());
+    ASSERT_TRUE(view.empty());
+    ASSERT_EQ(std::memcmp(loaded.data(), records.data(), records.size()*sizeof(SnapshotRecord)), 0);
+    ASSERT_EQ(std::memcmp(moved.data(), records.data(), records.size()*sizeof(SnapshotRecord)), 0);
+    ASSERT_EQ(moved.back().m_key, static_cast<std::int64_t>(num_of_elements-1));
+    ASSERT_EQ(moved.end() - moved.begin(), static_cast<std::ptrdiff_t>(num_of_elements));
+    scl::vector<int> ints;
+    ASSERT_THROW(scl::load(ints, path), std::runtime_error);
+    ASSERT_THROW(scl::snapshot_view<int>{path}, std::runtime_error);
+    ASSERT_THROW(scl::load(loaded, path + ".missing"), std::system_error);
+    ::truncate(path.c_str(), static_cast<off_t>(MMAP_HEADER_SIZE + sizeof(SnapshotRecord)));
+    ASSERT_THROW(scl::load(loaded, path), std::runtime_error);
+    ASSERT_THROW(scl::snapshot_view<SnapshotRecord>{path}, std::runtime_error);
+    scl::save(scl::vector<SnapshotRecord>(), path);
+    ASSERT_TRUE(scl::snapshot_view<SnapshotRecord>(path).empty());
+    ::unlink(path.c_str());
+}
+
+TEST(CheckSnapshot, AtomicReplaceAndMmapVectorFormat)
+{
+    //Arrange
+    const std::string path = temp_path();
+    scl::vector<SnapshotRecord> records;
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        records.push_back(SnapshotRecord{static_cast<std::int64_t>(i), i * 0.5});
+    }
+    scl::save(records, path);
+    scl::snapshot_view<SnapshotRecord> old_view(path);
+    //Act
+    records.resize(10);
+    scl::save(records, path);
+    scl::snapshot_view<SnapshotRecord> new_view(path);
+    //Assert
+    ASSERT_EQ(old_view.size(), num_of_elements);
+    ASSERT_EQ(old_view.back().m_key, static_cast<std::int64_t>(num_of_elements-1));
+    ASSERT_EQ(new_view.size(), 10U);
+    ASSERT_NE(::access((path + ".tmp").c_str(), F_OK), 0);
+    {
+        scl::mmap_vector<SnapshotRecord> mapped(path);
+        ASSERT_EQ(mapped.size(), 10U);
+        ASSERT_EQ(mapped[9].m_key, 9);
+        mapped.push_back(SnapshotRecord{42, 21.0});
+    }
+    scl::vector<SnapshotRecord> loaded;
+    scl::load(loaded, path);
+    ASSERT_EQ(loaded.size(), 11U);
+    ASSERT_EQ(loaded.back().m_key, 42);
+    ::unlink(path.c_str());
+}
+
+TEST(CompareSnapshot, StartupTime)
+{
+    const std::size_t size = num_of_elements * 100;
+    const std::string path = temp_path();
+    scl::vector<SnapshotRecord> records;
+    for(std::size_t i=0; i<size; ++i)
+    {
+        records.push_back(SnapshotRecord{static_cast<std::int64_t>(i), i * 0.5});
+    }
+    double save_time = 0, push_time = 0, load_time = 0, view_time = 0, last_time = get_time_sec();
+    scl::save(records, path);
+    get_new_time(save_time, last_time);
+
+    // The old way: the elements are read and pushed one by one
+    {
+        std::ifstream stream(path, std::ios::binary);
+        stream.seekg(MMAP_HEADER_SIZE);
+        scl::vector<SnapshotRecord> pushed;
+        SnapshotRecord record;
+        while(stream.read(reinterpret_cast<char*>(&record), sizeof(record)))
+        {
+            pushed.push_back(record);
+        }
+        get_new_time(push_time, last_time);
+        ASSERT_EQ(pushed.size(), size);
+    }
+    scl::vector<SnapshotRecord> loaded;
+    scl::load(loaded, path);
+    get_new_time(load_time, last_time);
+    scl::snapshot_view<SnapshotRecord> view(path);
+    get_new_time(view_time, last_time);
+    std::cout << "snapshot of " << size*sizeof(SnapshotRecord) << " bytes: save " << save_time << " s, push_back "
+              << push_time << " s, load " << load_time << " s, view " << view_time << " s\n";
+    ASSERT_EQ(loaded.size(), size);
+    ASSERT_EQ(view.size(), size);
+    ASSERT_EQ(view[size/2].m_key, loaded[size/2].m_key);
+    ::unlink(path.c_str());
+}
+
+TEST(CheckAligned, AlignmentAcrossGrowth)
+{
+    //Arrange
+    scl::aligned_vector<float> vec;
+    scl::aligned_vector<double, 4096> pages(100);
+    scl::vector<float, scl::aligned_allocator<float, 32>, scl::growth_factor_2> avx;
+    float sum = 0;
+    //Act
+    //Assert
+    ASSERT_EQ(scl::allocator_alignment<std::allocator<double>>::value, alignof(double));
+    ASSERT_EQ((scl::allocator_alignment<scl::aligned_allocator<char, 64>>::value), 64U);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(pages.data()) % 4096, 0U);
+    for(std::size_t i=0; i<num_of_elements; ++i)
+    {
+        vec.push_back(1.0f);
+        avx.emplace_back(2.0f);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % CACHE_LINE_SIZE, 0U);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(avx.data()) % 32, 0U);
+    }
+    vec.shrink_to_fit();
+    scl::aligned_vector<float> copy(vec);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % CACHE_LINE_SIZE, 0U);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(copy.data()) % CACHE_LINE_SIZE, 0U);
+    const float* data = copy.aligned_data();
+    for(std::size_t i=0; i<copy.size(); ++i)
+    {
+        sum += data[i];
+    }
+    ASSERT_EQ(sum, static_cast<float>(num_of_elements));
+    ASSERT_EQ(avx.aligned_data(), avx.data());
+}
 }
 
 #endif //VECTOR_TESTS_H